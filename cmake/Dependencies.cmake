@@ -79,8 +79,15 @@ if(asio_ADDED)
     endif()
 endif()
 
-#### readerwriterqueue ####
-CPMAddPackage("gh:cameron314/readerwriterqueue@1.0.6")
+#### Google Benchmark ####
+if (REVANCHE_BUILD_TOOLS)
+    CPMAddPackage(
+            NAME benchmark
+            VERSION 1.9.1
+            GITHUB_REPOSITORY google/benchmark
+            OPTIONS "BENCHMARK_ENABLE_TESTING OFF" "BENCHMARK_ENABLE_INSTALL OFF"
+    )
+endif ()
 
 #### ImAnim ####
 #CPMAddPackage(
@@ -1,14 +1,115 @@
 #include "backgroundiocontext.h"
 
-BackgroundIoContext::BackgroundIoContext()
-    : m_workGuard(make_work_guard(m_ioContext)), m_thread([this] { m_ioContext.run(); }) {}
+#ifdef __linux__
+#include <pthread.h>
+#include <time.h>
+#endif
+
+BackgroundIoContext::BackgroundIoContext() : m_workGuard(make_work_guard(m_ioContext)) {}
 
 BackgroundIoContext::~BackgroundIoContext() { stop(); }
 
+void BackgroundIoContext::start(const Options& options) {
+  if (!m_workers.empty()) return;
+
+  const auto threadCount = std::max<size_t>(options.threadCount, 1);
+  const auto cpuCount = std::max(std::thread::hardware_concurrency(), 1u);
+  const auto now = std::chrono::steady_clock::now();
+
+  m_workers.resize(threadCount);
+
+  for (size_t i = 0; i < threadCount; ++i) {
+    auto& worker = m_workers[i];
+    worker.thread = std::thread([this] { m_ioContext.run(); });
+    worker.lastSample = now;
+
+    if (const auto cpu = static_cast<int>(i % cpuCount); options.pinThreads && pinThread(worker.thread, cpu)) {
+      worker.cpu = cpu;
+    }
+  }
+}
+
 asio::io_context& BackgroundIoContext::getIoContext() { return m_ioContext; }
 
+std::vector<IoThreadStats> BackgroundIoContext::sampleThreadStats() {
+  std::lock_guard lock(m_statsMutex);
+
+  std::vector<IoThreadStats> stats;
+  stats.reserve(m_workers.size());
+
+  const auto now = std::chrono::steady_clock::now();
+
+  for (auto& worker : m_workers) {
+    if (!worker.thread.joinable()) continue;
+
+    const auto cpuTime = getThreadCpuTime(worker.thread);
+    const auto wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - worker.lastSample);
+
+    IoThreadStats& sample = stats.emplace_back();
+    sample.cpu = worker.cpu;
+    sample.cpuTime = cpuTime;
+    if (wallTime.count() > 0) {
+      sample.utilization = static_cast<double>((cpuTime - worker.lastCpuTime).count()) / wallTime.count();
+    }
+
+    worker.lastCpuTime = cpuTime;
+    worker.lastSample = now;
+  }
+
+  return stats;
+}
+
+std::vector<IoThreadStats> BackgroundIoContext::peekThreadStats() {
+  std::lock_guard lock(m_statsMutex);
+
+  std::vector<IoThreadStats> stats;
+  stats.reserve(m_workers.size());
+
+  for (auto& worker : m_workers) {
+    if (!worker.thread.joinable()) continue;
+    stats.push_back({.cpu = worker.cpu, .cpuTime = getThreadCpuTime(worker.thread)});
+  }
+
+  return stats;
+}
+
 void BackgroundIoContext::stop() {
   if (m_ioContext.stopped()) return;
   m_ioContext.stop();
-  if (m_thread.joinable()) m_thread.join();
+
+  for (auto& worker : m_workers) {
+    if (worker.thread.joinable()) worker.thread.join();
+  }
+}
+
+std::chrono::nanoseconds BackgroundIoContext::getThreadCpuTime(std::thread& thread) {
+#if defined(__linux__)
+  clockid_t clock{};
+  timespec time{};
+  if (pthread_getcpuclockid(thread.native_handle(), &clock) != 0 || clock_gettime(clock, &time) != 0) return {};
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#elif defined(_WIN32)
+  FILETIME creation{}, exit{}, kernel{}, user{};
+  if (!GetThreadTimes(thread.native_handle(), &creation, &exit, &kernel, &user)) return {};
+  const auto toTicks = [](const FILETIME& time) {
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  // FILETIME counts in 100 ns units
+  return std::chrono::nanoseconds((toTicks(kernel) + toTicks(user)) * 100);
+#else
+  return {};
+#endif
+}
+
+bool BackgroundIoContext::pinThread(std::thread& thread, const int cpu) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+  return SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{1} << cpu) != 0;
+#else
+  return false;
+#endif
 }
@@ -2,18 +2,54 @@
 
 #include <asio.hpp>
 
+struct IoThreadStats {
+  int cpu{-1};              // Pinned CPU, or -1 when the thread may run on any CPU
+  double utilization{0.0};  // Share of wall time the thread spent on a CPU since the previous sample
+  std::chrono::nanoseconds cpuTime{};
+};
+
 class BackgroundIoContext {
  public:
+  struct Options {
+    size_t threadCount{1};
+    bool pinThreads{false};  // Pin worker i to CPU i modulo the CPU count
+  };
+
   BackgroundIoContext();
 
   ~BackgroundIoContext();
 
+  // Runs the context on a pool of worker threads. With more than one thread, handlers of different readers run in
+  // parallel; each reader session serializes its own work on a strand.
+  void start(const Options& options);
+
   asio::io_context& getIoContext();
 
+  [[nodiscard]] size_t getThreadCount() const { return m_workers.size(); }
+
+  // Per-thread CPU usage since the previous call.
+  std::vector<IoThreadStats> sampleThreadStats();
+
+  // Per-thread CPU time without starting a new sampling interval, so exporters can read it alongside the UI. The
+  // utilization is left at zero.
+  std::vector<IoThreadStats> peekThreadStats();
+
   void stop();
 
  private:
+  struct Worker {
+    std::thread thread;
+    int cpu{-1};
+    std::chrono::nanoseconds lastCpuTime{};
+    std::chrono::steady_clock::time_point lastSample;
+  };
+
+  static std::chrono::nanoseconds getThreadCpuTime(std::thread& thread);
+
+  static bool pinThread(std::thread& thread, int cpu);
+
   asio::io_context m_ioContext;
   asio::executor_work_guard<asio::io_context::executor_type> m_workGuard;
-  std::thread m_thread;
+  std::vector<Worker> m_workers;
+  std::mutex m_statsMutex;
 };
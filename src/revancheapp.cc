@@ -4,6 +4,7 @@
 #include <fmt/format.h>
 #include <krog/ui/misc/carbon_icons.h>
 
+#include <charconv>
 #include <nlohmann/json.hpp>
 
 #include "imgui_stdlib.h"
@@ -13,22 +14,85 @@ void RevancheApp::OnAttach() {
   auto& config = kr::PersistentConfig::GetRoot();
   m_settings.ip = config["server-ip"].as<std::string>("8.8.8.8");
   m_settings.port = config["server-port"].as<int>(1969);
+  m_settings.ioThreads = config["io-threads"].as<int>(1);
+  m_settings.pinIoThreads = config["io-pin-threads"].as<bool>(false);
+  m_settings.inventoryDedupMs = config["inventory-dedup-ms"].as<int>(100);
+  m_settings.inventoryTtlSec = config["inventory-ttl-sec"].as<int>(30);
+  m_settings.journalEnabled = config["journal-enabled"].as<bool>(true);
+  m_settings.journalDirectory = config["journal-dir"].as<std::string>("journal");
+  m_settings.metricsEnabled = config["metrics-enabled"].as<bool>(false);
+  m_settings.metricsPort = config["metrics-port"].as<int>(9464);
 
-  m_client.setCommandCallback(KR_BIND_FN(RevancheApp::OnPacketReturn));
-  m_client.setStatusCallback(KR_BIND_FN(RevancheApp::OnPacketStatus));
-  m_client.setErrorCallback(KR_BIND_FN(RevancheApp::OnPacketError));
-  m_client.setBroadcastCallback(KR_BIND_FN(RevancheApp::OnPacketBroadcast));
+  m_inventory.setOptions({.dedupWindow = std::chrono::milliseconds(m_settings.inventoryDedupMs),
+                          .timeToLive = std::chrono::seconds(m_settings.inventoryTtlSec)});
 
-  m_client.setServerEndpoint(m_settings.ip, m_settings.port);
+  if (m_settings.journalEnabled) {
+    m_journal.open({.directory = m_settings.journalDirectory});
+  }
+
+  m_io.start({.threadCount = m_settings.ioThreads, .pinThreads = m_settings.pinIoThreads});
+
+  m_client.onReturn().subscribe(KR_BIND_FN(RevancheApp::OnPacketReturn));
+  m_client.onStatus().subscribe(KR_BIND_FN(RevancheApp::OnPacketStatus));
+  m_client.onError().subscribe(KR_BIND_FN(RevancheApp::OnPacketError));
+  m_client.onBroadcast().subscribe(KR_BIND_FN(RevancheApp::OnPacketBroadcast));
+
+  ApplyServerEndpoint();
 
   m_client.startBroadcastListening();
+
+  if (m_settings.metricsEnabled) ToggleMetricsServer();
 }
 
 void RevancheApp::OnDetach() {
   auto& config = kr::PersistentConfig::GetRoot();
   config["server-ip"] = m_settings.ip;
   config["server-port"] = m_settings.port;
+  config["io-threads"] = static_cast<int>(m_settings.ioThreads);
+  config["io-pin-threads"] = m_settings.pinIoThreads;
+  config["inventory-dedup-ms"] = m_settings.inventoryDedupMs;
+  config["inventory-ttl-sec"] = m_settings.inventoryTtlSec;
+  config["journal-enabled"] = m_settings.journalEnabled;
+  config["journal-dir"] = m_settings.journalDirectory;
+  config["metrics-enabled"] = m_settings.metricsEnabled;
+  config["metrics-port"] = m_settings.metricsPort;
   kr::PersistentConfig::Save();
+
+  m_metricsServer.stop();
+  m_journal.close();
+
+  // Stopping the client cancels the outstanding commands, so the engines are idle before they are destroyed
+  if (m_tagProgramResult.valid() || m_tagDumpResult.valid()) {
+    m_client.stop();
+    if (m_tagProgramResult.valid()) m_tagProgramResult.wait();
+    if (m_tagDumpResult.valid()) m_tagDumpResult.wait();
+  }
+
+  m_profileFleet.stop();
+  if (m_profileResult.valid()) m_profileResult.wait();
+}
+
+// Parses "YYYY-MM-DD HH:MM:SS" in local time
+static bool parseLocalTime(const std::string& text, std::chrono::system_clock::time_point& out) {
+  std::tm time{};
+  if (std::sscanf(text.c_str(), "%d-%d-%d %d:%d:%d", &time.tm_year, &time.tm_mon, &time.tm_mday, &time.tm_hour,
+                  &time.tm_min, &time.tm_sec) != 6) {
+    return false;
+  }
+  time.tm_year -= 1900;
+  time.tm_mon -= 1;
+  time.tm_isdst = -1;
+
+  const auto seconds = std::mktime(&time);
+  if (seconds == -1) return false;
+
+  out = std::chrono::system_clock::from_time_t(seconds);
+  return true;
+}
+
+static std::string formatLocalTime(const std::chrono::system_clock::time_point time) {
+  const auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+  return fmt::format("{:%Y-%m-%d %H:%M:%S}", std::chrono::current_zone()->to_local(seconds));
 }
 
 static void renderCell(const std::string& text) {
@@ -42,6 +106,11 @@ static void renderCell(const std::string& text) {
 }
 
 void RevancheApp::OnUiUpdate() {
+  DrainEvents();
+
+  // Stale tags leave the inventory a few at a time, even while no reads arrive
+  m_inventory.expire(std::chrono::steady_clock::now(), k_inventoryExpireSteps);
+
   const bool is_connected = m_client.isRunning();
 
   constexpr auto flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoDocking |
@@ -73,17 +142,17 @@ void RevancheApp::OnUiUpdate() {
       ImGui::BeginGroup();
       ImGui::SetNextItemWidth(120.f);
       if (ImGui::InputText("IP Address", &m_settings.ip, ImGuiInputTextFlags_EnterReturnsTrue)) {
-        m_client.setServerEndpoint(m_settings.ip, m_settings.port);
+        ApplyServerEndpoint();
       }
       ImGui::SameLine(0, 8);
       ImGui::SetNextItemWidth(80.f);
       if (ImGui::InputScalar("Port", ImGuiDataType_U16, &m_settings.port, nullptr, nullptr, nullptr,
                              ImGuiInputTextFlags_EnterReturnsTrue)) {
-        m_client.setServerEndpoint(m_settings.ip, m_settings.port);
+        ApplyServerEndpoint();
       }
       ImGui::EndGroup();
       ImGui::SetItemTooltip("Press <Enter> to apply");
-      ImGui::SameLine(ImGui::GetContentRegionMax().x - 401.0f - ImGui::GetStyle().FramePadding.x, 0.0f);
+      ImGui::SameLine(ImGui::GetContentRegionMax().x - 929.0f - ImGui::GetStyle().FramePadding.x, 0.0f);
       std::string showDevicesBtn = fmt::format("{} {:>3}", CarbonIcons::Query, m_statusDevices.size());
       if (ImGui::ColoredButton(showDevicesBtn.c_str(), sp.Color(Col::GREEN1000, 0.15), sp.Color(Col::GREEN900),
                                {60, 0})) {
@@ -105,6 +174,40 @@ void RevancheApp::OnUiUpdate() {
       }
       ImGui::SetItemTooltip("Last received heartbeat packet");
       ImGui::SameLine();
+      std::string inventoryBtn = fmt::format("Tags {:>4}", m_inventory.size());
+      if (ImGui::Button(inventoryBtn.c_str(), {80, 0})) {
+        m_showInventory = true;
+      }
+      ImGui::SetItemTooltip("Tags currently in range");
+      ImGui::SameLine();
+      if (ImGui::Button(m_capture ? "Capturing" : "Capture", {80, 0})) {
+        m_showCapture = true;
+      }
+      ImGui::SetItemTooltip("Record or replay raw traffic");
+      ImGui::SameLine();
+      if (ImGui::Button("Latency", {80, 0})) {
+        m_showLatency = true;
+      }
+      ImGui::SetItemTooltip("Command round-trip times");
+      ImGui::SameLine();
+      if (ImGui::Button("Metrics", {80, 0})) {
+        m_showMetrics = true;
+      }
+      ImGui::SetItemTooltip("Ingest, decode and queue health");
+      ImGui::SameLine();
+      const auto* hfTagsLabel = m_tagProgramResult.valid() ? "Writing"
+                                : m_tagDumpResult.valid()  ? "Reading"
+                                                           : "HF Tags";
+      if (ImGui::Button(hfTagsLabel, {80, 0})) {
+        m_showHfTags = true;
+      }
+      ImGui::SetItemTooltip("Program and dump HF tag memory");
+      ImGui::SameLine();
+      if (ImGui::Button(m_profileResult.valid() ? "Applying" : "Profiles", {80, 0})) {
+        m_showProfiles = true;
+      }
+      ImGui::SetItemTooltip("Roll a configuration profile out to many readers");
+      ImGui::SameLine();
       static std::string showStatusBtn = fmt::format("{}  Auto Read", CarbonIcons::Iot::Platform);
       if (ImGui::Button(showStatusBtn.c_str(), {120, 0})) {
         m_showStatus = true;
@@ -238,6 +341,45 @@ void RevancheApp::OnUiUpdate() {
           ImGui::TextUnformatted("N/A");
         }
 
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        ImGui::TextUnformatted("Message pool hit rate:");
+        ImGui::TableSetColumnIndex(1);
+        {
+          const auto poolStats = vanch::MessageRegistry::getPoolStats();
+          ImGui::Text("%.1f%% (%llu hits, %llu misses)", poolStats.getHitRate() * 100.0, poolStats.hits,
+                      poolStats.misses);
+        }
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        ImGui::TextUnformatted("UI events:");
+        ImGui::TableSetColumnIndex(1);
+        {
+          const auto eventStats = m_events.getStats();
+          ImGui::Text("%llu drained, %llu coalesced, %llu dropped, %llu pending", eventStats.drained,
+                      eventStats.coalesced, eventStats.dropped, eventStats.pending);
+        }
+
+        // Utilization is averaged over a second so the numbers stay readable
+        if (const auto now = std::chrono::steady_clock::now(); now - m_ioThreadStatsTime >= std::chrono::seconds(1)) {
+          m_ioThreadStats = m_io.sampleThreadStats();
+          m_ioThreadStatsTime = now;
+        }
+
+        for (size_t i = 0; i < m_ioThreadStats.size(); ++i) {
+          const auto& thread = m_ioThreadStats[i];
+          ImGui::TableNextRow();
+          ImGui::TableSetColumnIndex(0);
+          ImGui::Text("I/O thread %llu:", i);
+          ImGui::TableSetColumnIndex(1);
+          if (thread.cpu >= 0) {
+            ImGui::Text("%.1f%% (CPU %d)", thread.utilization * 100.0, thread.cpu);
+          } else {
+            ImGui::Text("%.1f%%", thread.utilization * 100.0);
+          }
+        }
+
         ImGui::EndTable();
       }
 
@@ -266,12 +408,12 @@ void RevancheApp::OnUiUpdate() {
             AddRow("Triggered Channels", channels);
           }
 
-          AddRow("Direction", m_statusAutoRead->direction);
-          AddRow("IP Address", m_statusAutoRead->ipAddress);
-          AddRow("EPC", m_statusAutoRead->epc);
-          AddRow("TID", m_statusAutoRead->tid);
-          AddRow("User Area", m_statusAutoRead->userArea);
-          AddRow("Device ID", m_statusAutoRead->deviceId);
+          AddRow("Direction", m_statusAutoRead->direction.str());
+          AddRow("IP Address", m_statusAutoRead->ipAddress.str());
+          AddRow("EPC", m_statusAutoRead->epc.toHex());
+          AddRow("TID", m_statusAutoRead->tid.toHex());
+          AddRow("User Area", m_statusAutoRead->userArea.toHex());
+          AddRow("Device ID", m_statusAutoRead->deviceId.str());
           AddRow("RSSI", std::to_string(m_statusAutoRead->rssi));
           AddRow("Timestamp", std::to_string(m_statusAutoRead->timestamp));
 
@@ -303,11 +445,11 @@ void RevancheApp::OnUiUpdate() {
             AddRow("Tag Type", tagTypeStr);
           }
 
-          for (size_t i = 0; i < m_statusAutoRead->customFields.size(); ++i) {
+          for (size_t i = 0; i < vanch::StatusAutoCardReading::k_customFieldCount; ++i) {
             std::string fieldName = fmt::format("Custom Field {}", i + 1);
 
             std::string hexValue;
-            for (char c : m_statusAutoRead->customFields[i])
+            for (char c : m_statusAutoRead->getCustomField(i))
               hexValue += fmt::format("{:02X}", static_cast<unsigned char>(c));
 
             AddRow(fieldName.c_str(), hexValue);
@@ -324,6 +466,635 @@ void RevancheApp::OnUiUpdate() {
     ImGui::End();
   }
 
+  if (m_showInventory) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({840, 420}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Tag Inventory", &m_showInventory)) {
+      bool optionsChanged = false;
+      ImGui::SetNextItemWidth(120);
+      optionsChanged |= ImGui::InputInt("Dedup window, ms", &m_settings.inventoryDedupMs, 10, 100);
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(120);
+      optionsChanged |= ImGui::InputInt("Time to live, s", &m_settings.inventoryTtlSec, 1, 10);
+      if (optionsChanged) {
+        m_settings.inventoryDedupMs = std::max(m_settings.inventoryDedupMs, 0);
+        m_settings.inventoryTtlSec = std::max(m_settings.inventoryTtlSec, 1);
+        m_inventory.setOptions({.dedupWindow = std::chrono::milliseconds(m_settings.inventoryDedupMs),
+                                .timeToLive = std::chrono::seconds(m_settings.inventoryTtlSec)});
+      }
+      ImGui::SameLine();
+      if (ImGui::Button("Clear")) {
+        m_inventory.clear();
+      }
+      ImGui::SameLine();
+      if (ImGui::Button("Journal")) {
+        m_showJournal = true;
+      }
+
+      const auto stats = m_inventory.getStats();
+      ImGui::Text("%zu tags, %llu reads, %llu duplicates, %llu expired", stats.tags,
+                  static_cast<unsigned long long>(stats.reads), static_cast<unsigned long long>(stats.duplicates),
+                  static_cast<unsigned long long>(stats.expired));
+
+      m_inventory.snapshot(m_inventoryRows);
+      std::ranges::sort(m_inventoryRows, {}, &vanch::TagRecord::epc);
+
+      if (ImGui::BeginTable("InventoryTable", 8,
+                            ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY, {0, -1})) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("EPC");
+        ImGui::TableSetupColumn("Reads");
+        ImGui::TableSetupColumn("Duplicates");
+        ImGui::TableSetupColumn("Antennas");
+        ImGui::TableSetupColumn("RSSI min/mean/max");
+        ImGui::TableSetupColumn("First seen");
+        ImGui::TableSetupColumn("Last seen");
+        ImGui::TableSetupColumn("Device ID");
+        ImGui::TableHeadersRow();
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto ago = [now](const std::chrono::steady_clock::time_point time) {
+          return fmt::format("{:.1f}s ago", std::chrono::duration<float>(now - time).count());
+        };
+
+        // Hundreds of tags are common, so only the visible rows are formatted
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_inventoryRows.size()));
+        while (clipper.Step()) {
+          for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const auto& tag = m_inventoryRows[row];
+            ImGui::TableNextRow();
+
+            std::string antennas;
+            for (size_t i = 0; i < tag.antennaReads.size(); ++i) {
+              if (tag.antennaReads[i] == 0) continue;
+              if (!antennas.empty()) antennas += ", ";
+              antennas += fmt::format("{}: {}", i, tag.antennaReads[i]);
+            }
+
+            ImGui::TableSetColumnIndex(0);
+            renderCell(tag.epc.toHex());
+            ImGui::TableSetColumnIndex(1);
+            renderCell(std::to_string(tag.readCount));
+            ImGui::TableSetColumnIndex(2);
+            renderCell(std::to_string(tag.duplicateCount));
+            ImGui::TableSetColumnIndex(3);
+            renderCell(antennas);
+            ImGui::TableSetColumnIndex(4);
+            renderCell(tag.readCount > 0 ? fmt::format("{} / {:.1f} / {}", tag.rssiMin, tag.getRssiMean(), tag.rssiMax)
+                                         : "N/A");
+            ImGui::TableSetColumnIndex(5);
+            renderCell(ago(tag.firstSeen));
+            ImGui::TableSetColumnIndex(6);
+            renderCell(ago(tag.lastSeen));
+            ImGui::TableSetColumnIndex(7);
+            renderCell(tag.deviceId.str());
+          }
+        }
+        ImGui::EndTable();
+      }
+    }
+    ImGui::End();
+  }
+
+  if (m_showJournal) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({840, 420}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Tag Journal", &m_showJournal)) {
+      if (m_journalForm.from.empty()) {
+        const auto now = std::chrono::system_clock::now();
+        m_journalForm.from = formatLocalTime(now - std::chrono::minutes(5));
+        m_journalForm.to = formatLocalTime(now);
+      }
+
+      ImGui::SetNextItemWidth(150);
+      ImGui::InputText("From", &m_journalForm.from);
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(150);
+      ImGui::InputText("To", &m_journalForm.to);
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(110);
+      ImGui::InputTextWithHint("Reader IP", "any", &m_journalForm.readerIp);
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(90);
+      ImGui::InputInt("Antenna", &m_journalForm.antenna);
+      ImGui::SetItemTooltip("-1 matches any antenna");
+      ImGui::SameLine();
+      if (ImGui::Button("Query")) {
+        RunJournalQuery();
+      }
+
+      if (m_journal.isOpen()) {
+        const auto stats = m_journal.getStats();
+        ImGui::Text("Writing segment %llu: %llu written, %llu dropped, %llu errors",
+                    static_cast<unsigned long long>(stats.segment), static_cast<unsigned long long>(stats.written),
+                    static_cast<unsigned long long>(stats.dropped), static_cast<unsigned long long>(stats.writeErrors));
+      } else {
+        ImGui::TextDisabled("Journal is not being written");
+      }
+      ImGui::TextUnformatted(m_journalQueryStatus.c_str());
+
+      if (ImGui::BeginTable("JournalTable", 6,
+                            ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY, {0, -1})) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Time");
+        ImGui::TableSetupColumn("Reader IP");
+        ImGui::TableSetupColumn("Device ID");
+        ImGui::TableSetupColumn("Antenna");
+        ImGui::TableSetupColumn("EPC");
+        ImGui::TableSetupColumn("RSSI");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_journalResults.size()));
+        while (clipper.Step()) {
+          for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const auto& record = m_journalResults[row];
+            ImGui::TableNextRow();
+
+            const auto millis = (record.timestampUs / 1000) % 1000;
+
+            ImGui::TableSetColumnIndex(0);
+            renderCell(fmt::format("{}.{:03}", formatLocalTime(record.getTime()), millis));
+            ImGui::TableSetColumnIndex(1);
+            renderCell(record.getReaderIpString());
+            ImGui::TableSetColumnIndex(2);
+            renderCell(std::string(record.getDeviceId()));
+            ImGui::TableSetColumnIndex(3);
+            renderCell(std::to_string(record.antenna));
+            ImGui::TableSetColumnIndex(4);
+            renderCell(vanch::TagId(record.getEpc()).toHex());
+            ImGui::TableSetColumnIndex(5);
+            renderCell(std::to_string(record.rssi));
+          }
+        }
+        ImGui::EndTable();
+      }
+    }
+    ImGui::End();
+  }
+
+  if (m_showCapture) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({480, 220}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Capture & Replay", &m_showCapture)) {
+      ImGui::SeparatorText("Capture");
+      ImGui::BeginDisabled(m_capture != nullptr);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("##CapturePath", &m_captureForm.capturePath);
+      ImGui::EndDisabled();
+      ImGui::SameLine();
+      if (ImGui::Button(m_capture ? "Stop capture" : "Start capture", {-1, 0})) {
+        ToggleCapture();
+      }
+      if (m_capture) {
+        ImGui::Text("%llu frames, %llu bytes", static_cast<unsigned long long>(m_capture->getFrameCount()),
+                    static_cast<unsigned long long>(m_capture->getByteCount()));
+      }
+
+      ImGui::SeparatorText("Replay");
+      const bool replaying = m_replay.isRunning();
+      ImGui::BeginDisabled(replaying);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("##ReplayPath", &m_captureForm.replayPath);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::SliderFloat("Speed", &m_captureForm.replaySpeed, 0.0f, 16.0f, "%.1fx");
+      ImGui::SetItemTooltip("0 replays as fast as possible");
+      ImGui::EndDisabled();
+      if (ImGui::Button(replaying ? "Stop replay" : "Start replay", {-1, 0})) {
+        if (replaying) {
+          m_replay.stop();
+        } else {
+          m_replay.start(m_captureForm.replayPath, m_client, {.speed = m_captureForm.replaySpeed});
+        }
+      }
+
+      const auto stats = m_replay.getStats();
+      if (stats.datagrams > 0) {
+        ImGui::Text("%llu datagrams in %.2f s", static_cast<unsigned long long>(stats.datagrams),
+                    std::chrono::duration<double>(stats.elapsed).count());
+      }
+    }
+    ImGui::End();
+  }
+
+  if (m_showLatency) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({840, 420}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Command Latency", &m_showLatency)) {
+      // Snapshots copy every histogram, so they are taken once a second rather than every frame
+      if (const auto now = std::chrono::steady_clock::now(); now - m_latencyRowsTime >= std::chrono::seconds(1)) {
+        m_latencyRows = m_client.getLatencies();
+        m_latencyRowsTime = now;
+      }
+
+      ImGui::Text("Reader %s:%u", m_settings.ip.c_str(), m_settings.port);
+      ImGui::SameLine();
+      if (ImGui::Button("Reset")) {
+        m_client.resetLatencies();
+        m_latencyRows.clear();
+        m_latencyForm.selectedCmdCode = -1;
+      }
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("##LatencyExportPath", &m_latencyForm.exportPath);
+      ImGui::SameLine();
+      if (ImGui::Button("Export JSON", {-1, 0})) {
+        ExportLatencies();
+      }
+      ImGui::TextUnformatted(m_latencyForm.exportStatus.c_str());
+
+      const auto toMillis = [](const std::chrono::microseconds value) {
+        return fmt::format("{:.2f}", static_cast<double>(value.count()) / 1000.0);
+      };
+
+      const auto commands = vanch::MessageRegistry::getCommandMetadata();
+      const vanch::CommandLatency* selected = nullptr;
+
+      if (ImGui::BeginTable("LatencyTable", 11,
+                            ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY,
+                            {0, -140})) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Command");
+        ImGui::TableSetupColumn("OK");
+        ImGui::TableSetupColumn("Errors");
+        ImGui::TableSetupColumn("Timeouts");
+        ImGui::TableSetupColumn("Retries");
+        ImGui::TableSetupColumn("Cancelled");
+        ImGui::TableSetupColumn("p50 ms");
+        ImGui::TableSetupColumn("p90 ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableSetupColumn("p99.9 ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableHeadersRow();
+
+        for (const auto& row : m_latencyRows) {
+          const auto& histogram = row.histogram;
+          const bool isSelected = m_latencyForm.selectedCmdCode == row.cmdCode;
+          if (isSelected) selected = &row;
+
+          ImGui::TableNextRow();
+          ImGui::TableSetColumnIndex(0);
+          const auto it = std::ranges::find(commands, row.cmdCode, &vanch::CommandMetadata::cmdCode);
+          const auto label =
+              fmt::format("{:02X}H {}##latency", row.cmdCode, it != commands.end() ? it->name : std::string_view{});
+          if (ImGui::Selectable(label.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns)) {
+            m_latencyForm.selectedCmdCode = row.cmdCode;
+          }
+          ImGui::TableSetColumnIndex(1);
+          renderCell(std::to_string(row.ok));
+          ImGui::TableSetColumnIndex(2);
+          renderCell(std::to_string(row.deviceErrors));
+          ImGui::TableSetColumnIndex(3);
+          renderCell(std::to_string(row.timeouts));
+          ImGui::TableSetColumnIndex(4);
+          renderCell(std::to_string(row.retries));
+          ImGui::TableSetColumnIndex(5);
+          renderCell(std::to_string(row.cancelled));
+          ImGui::TableSetColumnIndex(6);
+          renderCell(toMillis(histogram.getPercentile(0.50)));
+          ImGui::TableSetColumnIndex(7);
+          renderCell(toMillis(histogram.getPercentile(0.90)));
+          ImGui::TableSetColumnIndex(8);
+          renderCell(toMillis(histogram.getPercentile(0.99)));
+          ImGui::TableSetColumnIndex(9);
+          renderCell(toMillis(histogram.getPercentile(0.999)));
+          ImGui::TableSetColumnIndex(10);
+          renderCell(toMillis(histogram.getMax()));
+        }
+        ImGui::EndTable();
+      }
+
+      if (selected && selected->histogram.getCount() > 0) {
+        // Buckets between the fastest and the slowest round trip; their width grows with the latency
+        std::vector<float> counts;
+        selected->histogram.forEachBucket([&counts](std::chrono::microseconds, const uint64_t count) {
+          counts.push_back(static_cast<float>(count));
+        });
+
+        const auto overlay = fmt::format("{:02X}H: {} round trips, {} - {} ms", selected->cmdCode,
+                                         selected->histogram.getCount(), toMillis(selected->histogram.getMin()),
+                                         toMillis(selected->histogram.getMax()));
+        ImGui::PlotHistogram("##LatencyPlot", counts.data(), static_cast<int>(counts.size()), 0, overlay.c_str(),
+                             0.0f, FLT_MAX, {-1, -1});
+      } else {
+        ImGui::TextDisabled("Select a command to see its distribution");
+      }
+    }
+    ImGui::End();
+  }
+
+  if (m_showMetrics) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({840, 420}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Metrics", &m_showMetrics)) {
+      // Rates are taken over the second between two snapshots
+      if (const auto now = std::chrono::steady_clock::now(); now - m_metricsTime >= std::chrono::seconds(1)) {
+        m_previousMetrics = std::move(m_metrics);
+        m_previousMetricsTime = m_metricsTime;
+        m_metrics = CollectMetrics();
+        m_metricsTime = now;
+      }
+
+      const auto elapsed = std::chrono::duration<double>(m_metricsTime - m_previousMetricsTime).count();
+      const auto perSecond = [elapsed](const uint64_t current, const uint64_t previous) {
+        return elapsed > 0.0 && current >= previous ? static_cast<double>(current - previous) / elapsed : 0.0;
+      };
+
+      if (ImGui::Checkbox("Serve Prometheus metrics on port", &m_settings.metricsEnabled)) {
+        ToggleMetricsServer();
+      }
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(80.f);
+      ImGui::BeginDisabled(m_metricsServer.isRunning());
+      ImGui::InputScalar("##MetricsPort", ImGuiDataType_U16, &m_settings.metricsPort);
+      ImGui::EndDisabled();
+      ImGui::SameLine();
+      if (m_metricsServer.isRunning()) {
+        ImGui::Text("http://127.0.0.1:%u/metrics, %llu scrapes", m_metricsServer.getEndpoint().port(),
+                    m_metricsServer.getScrapeCount());
+      } else {
+        ImGui::TextUnformatted(m_metricsStatus.c_str());
+      }
+
+      ImGui::SeparatorText("Readers");
+      if (ImGui::BeginTable("MetricsReaderTable", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable)) {
+        ImGui::TableSetupColumn("Reader");
+        ImGui::TableSetupColumn("Datagrams in/s");
+        ImGui::TableSetupColumn("Datagrams out/s");
+        ImGui::TableSetupColumn("Inbox drops");
+        ImGui::TableSetupColumn("Bad length");
+        ImGui::TableSetupColumn("Bad checksum");
+        ImGui::TableSetupColumn("Unknown");
+        ImGui::TableSetupColumn("Queue U/N/B");
+        ImGui::TableSetupColumn("Queue drops");
+        ImGui::TableHeadersRow();
+
+        for (const auto& reader : m_metrics.readers) {
+          const auto& previousReaders = m_previousMetrics.readers;
+          const auto previous = std::ranges::find(previousReaders, reader.reader, &vanch::ReaderMetrics::reader);
+          const auto before = previous != previousReaders.end() ? previous->stats : vanch::ReaderSessionStats{};
+          const auto& stats = reader.stats;
+
+          ImGui::TableNextRow();
+          ImGui::TableSetColumnIndex(0);
+          renderCell(reader.reader);
+          ImGui::TableSetColumnIndex(1);
+          renderCell(fmt::format("{:.0f}", perSecond(stats.datagramsReceived, before.datagramsReceived)));
+          ImGui::TableSetColumnIndex(2);
+          renderCell(fmt::format("{:.0f}", perSecond(stats.framesSent, before.framesSent)));
+          ImGui::TableSetColumnIndex(3);
+          renderCell(std::to_string(stats.droppedDatagrams));
+          ImGui::TableSetColumnIndex(4);
+          renderCell(std::to_string(stats.badLength));
+          ImGui::TableSetColumnIndex(5);
+          renderCell(std::to_string(stats.badChecksum));
+          ImGui::TableSetColumnIndex(6);
+          renderCell(std::to_string(stats.unknownMessages));
+          ImGui::TableSetColumnIndex(7);
+          renderCell(fmt::format("{} / {} / {}", stats.queue.lanes[0].depth, stats.queue.lanes[1].depth,
+                                 stats.queue.lanes[2].depth));
+          ImGui::TableSetColumnIndex(8);
+          renderCell(std::to_string(stats.queue.getDropped()));
+        }
+        ImGui::EndTable();
+      }
+
+      ImGui::SeparatorText("Callbacks");
+      if (ImGui::BeginTable("MetricsCallbackTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable)) {
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("Calls/s");
+        ImGui::TableSetupColumn("Mean us");
+        ImGui::TableSetupColumn("Over 1 ms");
+        ImGui::TableHeadersRow();
+
+        for (size_t i = 0; i < m_metrics.callbacks.size(); ++i) {
+          const auto& callback = m_metrics.callbacks[i];
+          const auto previousCount = m_previousMetrics.callbacks[i].count;
+
+          // Buckets above the 1 ms bound, including the overflow
+          uint64_t slow = 0;
+          for (size_t bucket = 0; bucket < callback.buckets.size(); ++bucket) {
+            const bool isOverflow = bucket == vanch::CallbackMetrics::k_bucketBounds.size();
+            if (isOverflow || vanch::CallbackMetrics::k_bucketBounds[bucket] > std::chrono::milliseconds(1)) {
+              slow += callback.buckets[bucket];
+            }
+          }
+
+          const auto mean = callback.count == 0 ? 0.0
+                                                : std::chrono::duration<double, std::micro>(callback.sum).count() /
+                                                      static_cast<double>(callback.count);
+
+          ImGui::TableNextRow();
+          ImGui::TableSetColumnIndex(0);
+          renderCell(std::string(vanch::getCallbackKindName(callback.kind)));
+          ImGui::TableSetColumnIndex(1);
+          renderCell(fmt::format("{:.0f}", perSecond(callback.count, previousCount)));
+          ImGui::TableSetColumnIndex(2);
+          renderCell(fmt::format("{:.1f}", mean));
+          ImGui::TableSetColumnIndex(3);
+          renderCell(std::to_string(slow));
+        }
+        ImGui::EndTable();
+      }
+
+      ImGui::SeparatorText("I/O threads");
+      for (size_t i = 0; i < m_metrics.ioThreads.size(); ++i) {
+        const auto& thread = m_metrics.ioThreads[i];
+        const auto& previousThreads = m_previousMetrics.ioThreads;
+        const auto previous = i < previousThreads.size() ? previousThreads[i].busyTime : std::chrono::nanoseconds{};
+        const auto busy = elapsed > 0.0 ? std::chrono::duration<double>(thread.busyTime - previous).count() / elapsed
+                                        : 0.0;
+        ImGui::Text("Thread %llu: %.1f%% busy, %.2f s in total", i, busy * 100.0,
+                    std::chrono::duration<double>(thread.busyTime).count());
+      }
+    }
+    ImGui::End();
+  }
+
+  if (m_showHfTags) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({480, 380}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("HF Tags", &m_showHfTags)) {
+      auto& form = m_hfTagForm;
+      const bool busy = m_tagProgramResult.valid() || m_tagDumpResult.valid();
+
+      ImGui::SeparatorText("Tag");
+      ImGui::BeginDisabled(busy);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("UID (hex)", &form.uid);
+      ImGui::SetNextItemWidth(-120);
+      if (ImGui::BeginCombo("Protocol", vanch::getHfProtocolName(static_cast<vanch::HfProtocol>(form.protocol)))) {
+        for (int i = 0; i <= static_cast<int>(vanch::HfProtocol::Iso14443A); ++i) {
+          if (ImGui::Selectable(vanch::getHfProtocolName(static_cast<vanch::HfProtocol>(i)), form.protocol == i)) {
+            form.protocol = i;
+          }
+        }
+        ImGui::EndCombo();
+      }
+      if (form.protocol == static_cast<int>(vanch::HfProtocol::Iso15693Sized)) {
+        ImGui::SetNextItemWidth(-120);
+        if (ImGui::InputInt("Block size", &form.blockSize)) form.blockSize = std::clamp(form.blockSize, 1, 255);
+      }
+      ImGui::SetNextItemWidth(-120);
+      if (ImGui::InputInt("Blocks", &form.blockCount)) {
+        form.blockCount = std::clamp(form.blockCount, 1, static_cast<int>(vanch::k_maxHfBlocks));
+      }
+      if (form.protocol == static_cast<int>(vanch::HfProtocol::Iso14443A)) {
+        ImGui::SetNextItemWidth(-120);
+        if (ImGui::InputInt("Sector blocks", &form.sectorBlocks)) {
+          form.sectorBlocks = std::clamp(form.sectorBlocks, 0, 64);
+        }
+        ImGui::SetItemTooltip("Blocks per sector on MIFARE-style tags, 0 for tags without sectors");
+      }
+
+      ImGui::SeparatorText("Program");
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("Image file", &form.imagePath);
+      ImGui::SetNextItemWidth(-120);
+      if (ImGui::InputInt("Start block", &form.startBlock)) form.startBlock = std::clamp(form.startBlock, 0, 255);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::SliderInt("Pipeline", &form.pipelineDepth, 1, 32);
+      ImGui::SetItemTooltip("Write frames awaiting their response at once");
+      ImGui::Checkbox("Verify by reading back", &form.verify);
+      ImGui::EndDisabled();
+
+      const auto programLabel = m_tagProgramResult.valid() ? "Programming..." : "Program";
+      if (ImGui::DisablingButton(programLabel, busy || !m_client.isRunning(), {-1, 0})) {
+        StartTagProgramming();
+      }
+
+      ImGui::SeparatorText("Dump");
+      ImGui::BeginDisabled(busy);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("Dump file", &form.dumpPath);
+      ImGui::Checkbox("Discover size", &form.discoverSize);
+      ImGui::SetItemTooltip("Probe how many blocks the tag has instead of reading the configured count");
+      ImGui::EndDisabled();
+
+      if (ImGui::DisablingButton(m_tagDumpResult.valid() ? "Reading..." : "Dump", busy || !m_client.isRunning(),
+                                 {-1, 0})) {
+        StartTagDump();
+      }
+
+      const auto isReady = [](const auto& future) {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      };
+      if (isReady(m_tagProgramResult)) FinishTagProgramming();
+      if (isReady(m_tagDumpResult)) FinishTagDump();
+
+      if (!form.status.empty()) ImGui::TextWrapped("%s", form.status.c_str());
+    }
+    ImGui::End();
+  }
+
+  if (m_showProfiles) {
+    const auto center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
+    ImGui::SetNextWindowSize({640, 520}, ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Profiles", &m_showProfiles)) {
+      auto& form = m_profileForm;
+      const bool busy = m_profileResult.valid();
+
+      ImGui::BeginDisabled(busy);
+      ImGui::SetNextItemWidth(-120);
+      ImGui::InputText("Profile file", &form.profilePath);
+      ImGui::InputTextMultiline("Readers", &form.readers, {-120, 120});
+      ImGui::SetItemTooltip("One IP or IP:port per line; the port defaults to the one of the client");
+      if (ImGui::DisablingButton("Add found devices", m_statusDevices.empty(), {-120, 0})) {
+        for (const auto& packet : m_statusDevices | std::views::values) {
+          const auto line = fmt::format("{}:{}", packet->ipAddress, packet->port);
+          if (form.readers.find(line) != std::string::npos) continue;
+          if (!form.readers.empty() && form.readers.back() != '\n') form.readers += '\n';
+          form.readers += line;
+        }
+      }
+      ImGui::SetNextItemWidth(-120);
+      ImGui::SliderInt("Concurrency", &form.concurrency, 1, 64);
+      ImGui::SetItemTooltip("Readers configured at once");
+      ImGui::Checkbox("Dry run", &form.dryRun);
+      ImGui::SetItemTooltip("Only read the settings and report what would change");
+      ImGui::EndDisabled();
+
+      const auto applyLabel =
+          busy ? fmt::format("Applying... {} of {}", m_profileApplier.getFinishedCount(), m_profileReaderCount)
+               : std::string(form.dryRun ? "Compare" : "Apply");
+      if (ImGui::DisablingButton(applyLabel.c_str(), busy, {-1, 0})) {
+        StartProfileApply();
+      }
+
+      if (m_profileResult.valid() && m_profileResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        FinishProfileApply();
+      }
+
+      if (!form.status.empty()) ImGui::TextWrapped("%s", form.status.c_str());
+
+      if (!m_profileRows.empty()) {
+        ImGui::SeparatorText("Report");
+        ImGui::SetNextItemWidth(-120);
+        ImGui::InputText("Report file", &form.reportPath);
+        if (ImGui::Button("Export report", {-1, 0})) {
+          ExportProfileReport();
+        }
+
+        if (ImGui::BeginTable("ProfileTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                     ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable,
+                              {0, -1})) {
+          ImGui::TableSetupScrollFreeze(0, 1);
+          ImGui::TableSetupColumn("Reader / setting");
+          ImGui::TableSetupColumn(m_profileRowsDryRun ? "Would change" : "Changed");
+          ImGui::TableSetupColumn("Unchanged");
+          ImGui::TableSetupColumn("Failed");
+          ImGui::TableSetupColumn("Time (ms)");
+          ImGui::TableHeadersRow();
+
+          for (const auto& row : m_profileRows) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            const auto reader = fmt::format("{}:{}", row.reader.address().to_string(), row.reader.port());
+            const bool open = ImGui::TreeNodeEx(reader.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%zu", row.changed);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%zu", row.unchanged);
+            ImGui::TableSetColumnIndex(3);
+            if (row.failed > 0) {
+              ImGui::TextColored({1.0f, 0.4f, 0.4f, 1.0f}, "%zu", row.failed);
+            } else {
+              ImGui::TextUnformatted("0");
+            }
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%lld",
+                        static_cast<long long>(
+                            std::chrono::duration_cast<std::chrono::milliseconds>(row.elapsed).count()));
+
+            if (!open) continue;
+
+            for (const auto& setting : row.settings) {
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::Text("%s: %s", setting.name.c_str(), vanch::getSettingOutcomeName(setting.outcome));
+              if (setting.failed() || setting.outcome == vanch::SettingOutcome::Unchanged) {
+                ImGui::SetItemTooltip("Reader: %s", setting.current.c_str());
+              } else {
+                ImGui::SetItemTooltip("Reader: %s\nProfile: %s", setting.current.c_str(), setting.desired.c_str());
+              }
+            }
+            ImGui::TreePop();
+          }
+          ImGui::EndTable();
+        }
+      }
+    }
+    ImGui::End();
+  }
+
   if (m_showDevList) {
     const auto center = ImGui::GetMainViewport()->GetCenter();
     ImGui::SetNextWindowPos(center, ImGuiCond_Once, {0.5f, 0.5f});
@@ -382,12 +1153,343 @@ void RevancheApp::OnUiUpdate() {
   }
 }
 
+void RevancheApp::DrainEvents() {
+  if (auto msg = m_events.takeLatest(UiEventQueue::Latest::AutoRead)) {
+    m_statusAutoRead = std::static_pointer_cast<vanch::StatusAutoCardReading>(std::move(msg));
+  }
+
+  if (auto msg = m_events.takeLatest(UiEventQueue::Latest::Heartbeat)) {
+    m_statusHeartbeat = std::static_pointer_cast<vanch::StatusHeartbeat>(std::move(msg));
+  }
+
+  m_events.drain(k_uiEventBudget, [this](UiEvent& event) {
+    switch (event.kind) {
+      case UiEvent::Kind::Return:
+        m_return = std::move(event.message);
+        break;
+      case UiEvent::Kind::Error:
+        m_return = nullptr;
+        break;
+      case UiEvent::Kind::Broadcast: {
+        auto sd = std::static_pointer_cast<vanch::StatusUdpBroadcast>(std::move(event.message));
+        m_statusDevices[sd->deviceId] = std::move(sd);
+        break;
+      }
+    }
+  });
+}
+
+void RevancheApp::ToggleCapture() {
+  if (m_capture) {
+    m_client.setCapture(nullptr);
+    m_capture->close();
+    m_capture.reset();
+    return;
+  }
+
+  auto capture = std::make_shared<vanch::FrameCapture>();
+  if (!capture->open(m_captureForm.capturePath)) return;
+
+  m_capture = std::move(capture);
+  m_client.setCapture(m_capture);
+}
+
+void RevancheApp::ExportLatencies() {
+  const nlohmann::json report = {
+      {"reader", fmt::format("{}:{}", m_settings.ip, m_settings.port)},
+      {"exportedAt", formatLocalTime(std::chrono::system_clock::now())},
+      {"commands", vanch::makeLatencyReport(m_client.getLatencies())},
+  };
+
+  std::ofstream file(m_latencyForm.exportPath, std::ios::trunc);
+  file << report.dump(2);
+
+  if (!file) {
+    m_latencyForm.exportStatus = fmt::format("Could not write {}", m_latencyForm.exportPath);
+    return;
+  }
+
+  m_latencyForm.exportStatus = fmt::format("Exported {} commands to {}", report["commands"].size(),
+                                           m_latencyForm.exportPath);
+}
+
+std::optional<vanch::HfTag> RevancheApp::MakeHfTag() {
+  const auto& form = m_hfTagForm;
+
+  vanch::TagId uid;
+  if (!uid.assignHex(form.uid) || uid.empty()) return std::nullopt;
+
+  return vanch::HfTag{
+      .protocol = static_cast<vanch::HfProtocol>(form.protocol),
+      .uid = {uid.bytes().begin(), uid.bytes().end()},
+      .blockSize = static_cast<uint8_t>(form.blockSize),
+      .blockCount = static_cast<size_t>(form.blockCount),
+      .sectorBlocks = static_cast<size_t>(form.sectorBlocks),
+  };
+}
+
+void RevancheApp::StartTagProgramming() {
+  auto& form = m_hfTagForm;
+
+  auto tag = MakeHfTag();
+  if (!tag) {
+    form.status = "The UID is not a hex string";
+    return;
+  }
+
+  std::ifstream file(form.imagePath, std::ios::binary);
+  if (!file.is_open()) {
+    form.status = fmt::format("Could not open {}", form.imagePath);
+    return;
+  }
+
+  std::vector<uint8_t> image{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+  const vanch::TagProgramOptions options{
+      .startBlock = static_cast<size_t>(form.startBlock),
+      .pipelineDepth = static_cast<size_t>(form.pipelineDepth),
+      .verify = form.verify,
+  };
+
+  form.status = fmt::format("Writing {} bytes to {}", image.size(), form.uid);
+  m_tagProgramResult = asio::co_spawn(m_io.getIoContext(),
+                                      m_tagProgrammer.program(std::move(*tag), std::move(image), options),
+                                      asio::use_future);
+}
+
+void RevancheApp::FinishTagProgramming() {
+  const auto result = m_tagProgramResult.get();
+  const auto toMs = [](const auto duration) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+  };
+
+  auto& status = m_hfTagForm.status;
+  if (!result.error.empty()) {
+    status = result.error;
+  } else if (result.failedChunks > 0) {
+    status = fmt::format("{} of {} chunks could not be written", result.failedChunks, result.chunks.size());
+  } else if (result.unreadBlocks > 0 || result.mismatchedBlocks > 0) {
+    status = fmt::format("Written, but verification failed: {} blocks unread, {} blocks differ", result.unreadBlocks,
+                         result.mismatchedBlocks);
+  } else {
+    status = fmt::format("Written in {} chunks ({} rewritten) in {} ms{}", result.chunks.size(), result.rewrites,
+                         toMs(result.writeTime),
+                         result.verified ? fmt::format(", verified in {} ms", toMs(result.verifyTime)) : "");
+  }
+}
+
+void RevancheApp::StartTagDump() {
+  auto& form = m_hfTagForm;
+
+  auto tag = MakeHfTag();
+  if (!tag) {
+    form.status = "The UID is not a hex string";
+    return;
+  }
+
+  const vanch::TagDumpOptions options{
+      .discoverSize = form.discoverSize,
+      .pipelineDepth = static_cast<size_t>(form.pipelineDepth),
+  };
+
+  form.status = fmt::format("Reading {}", form.uid);
+  m_tagDumpResult =
+      asio::co_spawn(m_io.getIoContext(), m_tagDumper.dump(std::move(*tag), options), asio::use_future);
+}
+
+void RevancheApp::FinishTagDump() {
+  const auto result = m_tagDumpResult.get();
+  auto& form = m_hfTagForm;
+
+  if (!result.error.empty()) {
+    form.status = result.error;
+    return;
+  }
+
+  std::ofstream file(form.dumpPath, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(result.image.data()), static_cast<std::streamsize>(result.image.size()));
+
+  if (!file) {
+    form.status = fmt::format("Could not write {}", form.dumpPath);
+    return;
+  }
+
+  form.status = fmt::format("Saved {} blocks to {} in {} ms, {} chunks of up to {} blocks{}", result.blockCount,
+                            form.dumpPath,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(result.elapsed).count(),
+                            result.chunks.size(), result.maxBlocksPerRead,
+                            result.ok ? "" : fmt::format(", {} blocks unread and left zero", result.unreadBlocks));
+}
+
+void RevancheApp::StartProfileApply() {
+  auto& form = m_profileForm;
+
+  vanch::ReaderProfile profile;
+  if (std::string error; !vanch::loadReaderProfile(form.profilePath, profile, error)) {
+    form.status = fmt::format("Invalid profile: {}", error);
+    return;
+  }
+
+  std::vector<asio::ip::udp::endpoint> endpoints;
+  for (const auto part : std::views::split(form.readers, '\n')) {
+    std::string_view line(part.begin(), part.end());
+    while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) line.remove_suffix(1);
+    while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front()))) line.remove_prefix(1);
+    if (line.empty()) continue;
+
+    const auto colon = line.find(':');
+    uint16_t port = m_settings.port;
+    if (colon != std::string_view::npos) {
+      const auto portText = line.substr(colon + 1);
+      const auto [end, ec] = std::from_chars(portText.data(), portText.data() + portText.size(), port);
+      if (ec != std::errc{} || end != portText.data() + portText.size()) {
+        form.status = fmt::format("Invalid port in '{}'", line);
+        return;
+      }
+    }
+
+    asio::error_code ec;
+    const auto address = asio::ip::make_address_v4(std::string(line.substr(0, colon)), ec);
+    if (ec) {
+      form.status = fmt::format("Invalid address '{}'", line);
+      return;
+    }
+    endpoints.emplace_back(address, port);
+  }
+
+  if (endpoints.empty()) {
+    form.status = "No readers listed";
+    return;
+  }
+
+  if (!m_profileFleet.isRunning() && !m_profileFleet.start()) {
+    form.status = "Could not open the fleet socket";
+    return;
+  }
+
+  // Readers of an earlier rollout that are no longer listed keep no session
+  for (const auto& session : m_profileFleet.getReaders()) m_profileFleet.removeReader(session->getEndpoint());
+
+  std::vector<std::shared_ptr<vanch::ReaderSession>> readers;
+  for (const auto& endpoint : endpoints) readers.push_back(m_profileFleet.addReader(endpoint));
+
+  const vanch::ProfileApplyOptions options{
+      .concurrency = static_cast<size_t>(form.concurrency),
+      .dryRun = form.dryRun,
+  };
+
+  form.status = fmt::format("{} '{}' with {} settings on {} readers", form.dryRun ? "Comparing" : "Applying",
+                            profile.name, profile.getSettingCount(), readers.size());
+  m_profileReaderCount = readers.size();
+  m_profileRowsDryRun = form.dryRun;
+  m_profileResult = asio::co_spawn(m_io.getIoContext(),
+                                   m_profileApplier.apply(std::move(profile), std::move(readers), options),
+                                   asio::use_future);
+}
+
+void RevancheApp::FinishProfileApply() {
+  m_profileRows = m_profileResult.get();
+
+  size_t changed = 0;
+  size_t failedReaders = 0;
+  for (const auto& row : m_profileRows) {
+    changed += row.changed;
+    if (!row.ok()) ++failedReaders;
+  }
+
+  m_profileForm.status = fmt::format("{} {} settings on {} readers, {} readers with failures",
+                                     m_profileRowsDryRun ? "Would change" : "Changed", changed, m_profileRows.size(),
+                                     failedReaders);
+}
+
+void RevancheApp::ExportProfileReport() {
+  auto& form = m_profileForm;
+  const nlohmann::json report = {
+      {"profile", form.profilePath},
+      {"dryRun", m_profileRowsDryRun},
+      {"exportedAt", formatLocalTime(std::chrono::system_clock::now())},
+      {"readers", vanch::makeProfileReport(m_profileRows)},
+  };
+
+  std::ofstream file(form.reportPath, std::ios::trunc);
+  file << report.dump(2);
+
+  form.status = file ? fmt::format("Exported the report of {} readers to {}", m_profileRows.size(), form.reportPath)
+                     : fmt::format("Could not write {}", form.reportPath);
+}
+
+void RevancheApp::ApplyServerEndpoint() {
+  m_client.setServerEndpoint(m_settings.ip, m_settings.port);
+
+  std::lock_guard lock(m_metricsMutex);
+  m_metricsReader = fmt::format("{}:{}", m_settings.ip, m_settings.port);
+}
+
+vanch::MetricsSnapshot RevancheApp::CollectMetrics() {
+  auto snapshot = vanch::captureMetrics();
+
+  {
+    std::lock_guard lock(m_metricsMutex);
+    snapshot.readers.push_back({.reader = m_metricsReader, .stats = m_client.getStats()});
+  }
+
+  for (const auto& thread : m_io.peekThreadStats()) {
+    snapshot.ioThreads.push_back({.cpu = thread.cpu, .busyTime = thread.cpuTime});
+  }
+
+  return snapshot;
+}
+
+void RevancheApp::ToggleMetricsServer() {
+  if (!m_settings.metricsEnabled) {
+    m_metricsServer.stop();
+    m_metricsStatus = "Stopped";
+    return;
+  }
+
+  if (!m_metricsServer.start({.address = "127.0.0.1", .port = m_settings.metricsPort})) {
+    m_settings.metricsEnabled = false;
+    m_metricsStatus = fmt::format("Could not listen on port {}", m_settings.metricsPort);
+  }
+}
+
+void RevancheApp::RunJournalQuery() {
+  vanch::JournalQuery query{.limit = k_journalQueryLimit};
+
+  if (!parseLocalTime(m_journalForm.from, query.from) || !parseLocalTime(m_journalForm.to, query.to)) {
+    m_journalQueryStatus = "Times must be given as YYYY-MM-DD HH:MM:SS";
+    return;
+  }
+
+  // The end of the range covers its whole last second
+  query.to += std::chrono::seconds(1) - std::chrono::microseconds(1);
+
+  if (!m_journalForm.readerIp.empty()) {
+    const auto address = vanch::journal::parseIpv4(m_journalForm.readerIp);
+    if (address == 0) {
+      m_journalQueryStatus = "Reader IP must be an IPv4 address";
+      return;
+    }
+    query.readerIp = address;
+  }
+
+  if (m_journalForm.antenna >= 0) query.antenna = static_cast<uint8_t>(m_journalForm.antenna);
+
+  const auto started = std::chrono::steady_clock::now();
+  m_journalResults = vanch::JournalReader(m_settings.journalDirectory).query(query);
+  const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started);
+
+  m_journalQueryStatus = fmt::format("{} reads{} in {:.1f} ms", m_journalResults.size(),
+                                     m_journalResults.size() >= k_journalQueryLimit ? " (limit reached)" : "",
+                                     elapsed.count());
+}
+
 void RevancheApp::OnPacketReturn(const std::shared_ptr<vanch::IMessage>& msg) {
   if (!msg) return;
 
   msg->messageTimestamp = {std::chrono::system_clock::now()};
 
-  m_return = msg;
+  m_events.push({.kind = UiEvent::Kind::Return, .message = msg});
 }
 
 void RevancheApp::OnPacketStatus(const std::shared_ptr<vanch::IMessage>& msg) {
@@ -396,11 +1498,16 @@ void RevancheApp::OnPacketStatus(const std::shared_ptr<vanch::IMessage>& msg) {
   msg->messageTimestamp = {std::chrono::system_clock::now()};
 
   switch (msg->getCmdCode()) {
-    case 0x01:
-      m_statusAutoRead = std::dynamic_pointer_cast<vanch::StatusAutoCardReading>(msg);
+    case 0x01: {
+      // Every read reaches the inventory and the journal here on the I/O thread; the UI only needs the latest one
+      const auto& reading = static_cast<const vanch::StatusAutoCardReading&>(*msg);
+      m_inventory.record(reading);
+      m_journal.append(vanch::JournalRecord::fromReading(reading, *msg->messageTimestamp));
+      m_events.publishLatest(UiEventQueue::Latest::AutoRead, msg);
       break;
+    }
     case 0x03:
-      m_statusHeartbeat = std::dynamic_pointer_cast<vanch::StatusHeartbeat>(msg);
+      m_events.publishLatest(UiEventQueue::Latest::Heartbeat, msg);
       break;
     default:
       logger->warn("Unknown status message with code 0x{:02x}", msg->getCmdCode());
@@ -414,7 +1521,7 @@ void RevancheApp::OnPacketError(std::string_view message, const uint8_t code) {
     logger->error("Received device error {}: {}", code, message);
   }
 
-  m_return = nullptr;
+  m_events.push({.kind = UiEvent::Kind::Error, .error = std::string(message), .errorCode = code});
 }
 
 void RevancheApp::OnPacketBroadcast(const std::shared_ptr<vanch::IMessage>& msg) {
@@ -422,7 +1529,5 @@ void RevancheApp::OnPacketBroadcast(const std::shared_ptr<vanch::IMessage>& msg)
 
   msg->messageTimestamp = {std::chrono::system_clock::now()};
 
-  const auto sd = std::dynamic_pointer_cast<vanch::StatusUdpBroadcast>(msg);
-
-  m_statusDevices[sd->deviceId] = sd;
+  m_events.push({.kind = UiEvent::Kind::Broadcast, .message = msg});
 }
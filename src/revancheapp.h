@@ -2,21 +2,81 @@
 
 #include <krog/entry.h>
 
+#include <future>
+
 #include "backgroundiocontext.h"
+#include "uieventqueue.h"
+#include "vanch/capture/capturereplay.h"
+#include "vanch/hf/tagprogrammer.h"
+#include "vanch/journal/journalreader.h"
+#include "vanch/journal/tagjournal.h"
 #include "vanch/messageregistry.h"
+#include "vanch/metrics/metricsserver.h"
+#include "vanch/profile/profileapplier.h"
+#include "vanch/readerfleet.h"
 #include "vanch/statuses/status.h"
+#include "vanch/taginventory.h"
 #include "vanch/udpclient.h"
 
 struct AppSettings {
   std::string ip;
   uint16_t port;
+  size_t ioThreads;
+  bool pinIoThreads;
+  int inventoryDedupMs;
+  int inventoryTtlSec;
+  bool journalEnabled;
+  std::string journalDirectory;
+  bool metricsEnabled;
+  uint16_t metricsPort;
+};
+
+struct CaptureForm {
+  std::string capturePath{"capture.vtc"};
+  std::string replayPath{"capture.vtc"};
+  float replaySpeed{1.0f};  // 0 replays as fast as possible
+};
+
+struct LatencyForm {
+  std::string exportPath{"latency.json"};
+  std::string exportStatus;
+  int selectedCmdCode{-1};  // Row whose distribution is plotted
+};
+
+struct HfTagForm {
+  std::string uid;  // Hex
+  int protocol{0};  // vanch::HfProtocol
+  int blockSize{4};
+  int blockCount{256};
+  int sectorBlocks{0};
+  std::string imagePath{"tag.bin"};
+  int startBlock{0};
+  int pipelineDepth{8};
+  bool verify{true};
+  std::string dumpPath{"dump.bin"};
+  bool discoverSize{true};
+  std::string status;
+};
+
+struct ProfileForm {
+  std::string profilePath{"profile.json"};
+  std::string readers;  // One IP or IP:port per line
+  int concurrency{16};
+  bool dryRun{true};
+  std::string reportPath{"profile-report.json"};
+  std::string status;
+};
+
+struct JournalQueryForm {
+  std::string from;
+  std::string to;
+  std::string readerIp;
+  int antenna{-1};  // Any antenna
 };
 
 class RevancheApp final : public kr::Layer, protected kr::Loggable {
 public:
-  RevancheApp() : Layer("RevancheApp"), Loggable("App"), m_io(), m_client(m_io.getIoContext(), "192.168.1.100", 1969) {
-    vanch::MessageRegistry::init();
-  }
+  RevancheApp() : Layer("RevancheApp"), Loggable("App"), m_io(), m_client(m_io.getIoContext(), "192.168.1.100", 1969) {}
 
 private:
   void OnAttach() override;
@@ -33,8 +93,57 @@ private:
 
   void OnPacketBroadcast(const std::shared_ptr<vanch::IMessage>& msg);
 
+  // Applies what the I/O threads reported since the previous frame
+  void DrainEvents();
+
+  void RunJournalQuery();
+
+  void ToggleCapture();
+
+  void ExportLatencies();
+
+  // Reads the image and UID from the form and programs the tag in the background
+  void StartTagProgramming();
+
+  void FinishTagProgramming();
+
+  // Reads the whole tag in the background and saves it to the dump file
+  void StartTagDump();
+
+  void FinishTagDump();
+
+  // Loads the profile and applies it to the readers listed in the form in the background
+  void StartProfileApply();
+
+  void FinishProfileApply();
+
+  void ExportProfileReport();
+
+  // The tag described by the form, or nothing if its UID does not parse
+  std::optional<vanch::HfTag> MakeHfTag();
+
+  // Points the client at the configured reader and relabels its metrics
+  void ApplyServerEndpoint();
+
+  // Called on an I/O thread for every scrape, so it only reads thread-safe stats
+  vanch::MetricsSnapshot CollectMetrics();
+
+  void ToggleMetricsServer();
+
+  static constexpr size_t k_uiEventCapacity{1024};
+  static constexpr size_t k_uiEventBudget{256};
+  static constexpr size_t k_inventoryExpireSteps{64};
+  static constexpr size_t k_journalQueryLimit{10000};
+
   BackgroundIoContext m_io;
   vanch::UdpClient m_client;
+  vanch::MetricsServer m_metricsServer{m_io.getIoContext(), [this] { return CollectMetrics(); }};
+  UiEventQueue m_events{k_uiEventCapacity};
+  vanch::TagInventory m_inventory{};
+  vanch::TagJournal m_journal{};
+  std::shared_ptr<vanch::FrameCapture> m_capture{};
+  vanch::CaptureReplay m_replay{m_io.getIoContext().get_executor()};
+  CaptureForm m_captureForm{};
 
   std::shared_ptr<vanch::IMessage> m_command{};
   std::shared_ptr<vanch::IMessage> m_return{};
@@ -42,8 +151,51 @@ private:
   std::shared_ptr<vanch::StatusHeartbeat> m_statusHeartbeat{};
   std::unordered_map<std::string, std::shared_ptr<vanch::StatusUdpBroadcast>> m_statusDevices{};
 
+  std::vector<vanch::TagRecord> m_inventoryRows{};
+
+  JournalQueryForm m_journalForm{};
+  std::vector<vanch::JournalRecord> m_journalResults{};
+  std::string m_journalQueryStatus{};
+
+  vanch::TagProgrammer m_tagProgrammer{m_client.getSession()};
+  std::future<vanch::TagProgramResult> m_tagProgramResult{};
+  vanch::TagDumper m_tagDumper{m_client.getSession()};
+  std::future<vanch::TagDumpResult> m_tagDumpResult{};
+  HfTagForm m_hfTagForm{};
+
+  // Readers a profile is rolled out to get their own sessions, apart from the client's
+  vanch::ReaderFleet m_profileFleet{m_io.getIoContext()};
+  vanch::ProfileApplier m_profileApplier{};
+  std::future<std::vector<vanch::ReaderProfileResult>> m_profileResult{};
+  size_t m_profileReaderCount{0};
+  std::vector<vanch::ReaderProfileResult> m_profileRows{};
+  bool m_profileRowsDryRun{false};
+  ProfileForm m_profileForm{};
+
+  LatencyForm m_latencyForm{};
+  std::vector<vanch::CommandLatency> m_latencyRows{};
+  std::chrono::steady_clock::time_point m_latencyRowsTime{};
+
+  std::mutex m_metricsMutex;
+  std::string m_metricsReader{};  // Label of the client's reader, guarded by m_metricsMutex
+  vanch::MetricsSnapshot m_metrics{};
+  vanch::MetricsSnapshot m_previousMetrics{};
+  std::chrono::steady_clock::time_point m_metricsTime{};
+  std::chrono::steady_clock::time_point m_previousMetricsTime{};
+  std::string m_metricsStatus{};
+
+  std::vector<IoThreadStats> m_ioThreadStats{};
+  std::chrono::steady_clock::time_point m_ioThreadStatsTime{};
+
   bool m_showStatus{false};
   bool m_showDevList{false};
+  bool m_showInventory{false};
+  bool m_showJournal{false};
+  bool m_showCapture{false};
+  bool m_showLatency{false};
+  bool m_showMetrics{false};
+  bool m_showHfTags{false};
+  bool m_showProfiles{false};
   AppSettings m_settings{};
 };
 
@@ -0,0 +1,33 @@
+#include "uieventqueue.h"
+
+UiEventQueue::UiEventQueue(const size_t capacity) : m_queue(capacity) {}
+
+bool UiEventQueue::push(UiEvent&& event) {
+  if (!m_queue.tryPush(std::move(event))) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  m_queued.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void UiEventQueue::publishLatest(const Latest slot, std::shared_ptr<vanch::IMessage> message) {
+  if (m_latest[static_cast<size_t>(slot)].exchange(std::move(message))) {
+    m_coalesced.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::shared_ptr<vanch::IMessage> UiEventQueue::takeLatest(const Latest slot) {
+  return m_latest[static_cast<size_t>(slot)].exchange(nullptr);
+}
+
+UiEventQueueStats UiEventQueue::getStats() const {
+  return {
+      .queued = m_queued.load(std::memory_order_relaxed),
+      .drained = m_drained.load(std::memory_order_relaxed),
+      .coalesced = m_coalesced.load(std::memory_order_relaxed),
+      .dropped = m_dropped.load(std::memory_order_relaxed),
+      .pending = m_queue.sizeApprox(),
+  };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "vanch/message.h"
+#include "vanch/mpscqueue.h"
+
+struct UiEvent {
+  enum class Kind : uint8_t {
+    Return,
+    Error,
+    Broadcast,
+  };
+
+  Kind kind{Kind::Return};
+  std::shared_ptr<vanch::IMessage> message;
+  std::string error;
+  uint8_t errorCode{0xFF};
+};
+
+struct UiEventQueueStats {
+  uint64_t queued{0};
+  uint64_t drained{0};
+  uint64_t coalesced{0};  // Reports replaced by a newer one before the UI picked them up
+  uint64_t dropped{0};    // Events lost because the queue was full
+  size_t pending{0};
+};
+
+// Hands events from the I/O threads to the UI frame loop. Discrete events go through a bounded lock-free queue
+// that the UI drains with a per-frame budget. High-rate reports where only the newest one is shown are coalesced
+// into latest-value slots, so the UI does the same work per frame however fast a reader reports.
+class UiEventQueue {
+ public:
+  enum class Latest : uint8_t {
+    AutoRead,
+    Heartbeat,
+    Count,
+  };
+
+  explicit UiEventQueue(size_t capacity);
+
+  // Any thread
+  bool push(UiEvent&& event);
+
+  // Any thread
+  void publishLatest(Latest slot, std::shared_ptr<vanch::IMessage> message);
+
+  // UI thread only. Returns the newest report published since the previous call, or nullptr.
+  std::shared_ptr<vanch::IMessage> takeLatest(Latest slot);
+
+  // UI thread only. Handles at most budget events and returns how many were handled.
+  template <typename Handler>
+  size_t drain(const size_t budget, Handler&& handler) {
+    size_t count = 0;
+    UiEvent event;
+
+    while (count < budget && m_queue.tryPop(event)) {
+      handler(event);
+      ++count;
+    }
+
+    m_drained.fetch_add(count, std::memory_order_relaxed);
+    return count;
+  }
+
+  [[nodiscard]] UiEventQueueStats getStats() const;
+
+ private:
+  vanch::MpscQueue<UiEvent> m_queue;
+  std::array<std::atomic<std::shared_ptr<vanch::IMessage>>, static_cast<size_t>(Latest::Count)> m_latest;
+
+  std::atomic<uint64_t> m_queued{0};
+  std::atomic<uint64_t> m_drained{0};
+  std::atomic<uint64_t> m_coalesced{0};
+  std::atomic<uint64_t> m_dropped{0};
+};
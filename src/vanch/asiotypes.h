@@ -0,0 +1,10 @@
+#pragma once
+
+#include <asio.hpp>
+#include <asio/awaitable.hpp>
+
+using default_token = asio::as_tuple_t<asio::use_awaitable_t<>>;
+using udp_socket = default_token::as_default_on_t<asio::ip::udp::socket>;
+using steady_timer = default_token::as_default_on_t<asio::steady_timer>;
+using tcp_acceptor = default_token::as_default_on_t<asio::ip::tcp::acceptor>;
+using tcp_socket = default_token::as_default_on_t<asio::ip::tcp::socket>;
@@ -0,0 +1,53 @@
+#include "bufferpool.h"
+
+namespace vanch {
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+    : m_pool(std::exchange(other.m_pool, nullptr)), m_data(std::exchange(other.m_data, nullptr)) {}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept {
+  if (this != &other) {
+    if (m_pool) m_pool->release(m_data);
+    m_pool = std::exchange(other.m_pool, nullptr);
+    m_data = std::exchange(other.m_data, nullptr);
+  }
+  return *this;
+}
+
+PooledBuffer::~PooledBuffer() {
+  if (m_pool) m_pool->release(m_data);
+}
+
+BufferPool::BufferPool(const size_t bufferCount) : m_storage(bufferCount) {
+  m_free.reserve(bufferCount);
+  for (auto& buffer : m_storage) m_free.push_back(buffer.data());
+}
+
+PooledBuffer BufferPool::acquire() {
+  {
+    std::lock_guard lock(m_mutex);
+    if (!m_free.empty()) {
+      auto* data = m_free.back();
+      m_free.pop_back();
+      return {this, data};
+    }
+  }
+
+  ++m_fallbacks;
+  return {this, new uint8_t[k_maxFrameSize]};
+}
+
+void BufferPool::release(uint8_t* data) {
+  const auto* begin = reinterpret_cast<const uint8_t*>(m_storage.data());
+  const auto* end = begin + m_storage.size() * sizeof(Buffer);
+
+  if (std::less{}(data, begin) || !std::less{}(data, end)) {
+    delete[] data;
+    return;
+  }
+
+  std::lock_guard lock(m_mutex);
+  m_free.push_back(data);
+}
+
+}  // namespace vanch
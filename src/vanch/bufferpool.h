@@ -0,0 +1,60 @@
+#pragma once
+
+#include "vanch/message.h"
+
+namespace vanch {
+
+class BufferPool;
+
+// Frame-sized buffer borrowed from a BufferPool. Returned to the pool on destruction.
+class PooledBuffer {
+ public:
+  PooledBuffer() = default;
+
+  PooledBuffer(PooledBuffer&& other) noexcept;
+
+  PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+
+  PooledBuffer(const PooledBuffer&) = delete;
+
+  PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+  ~PooledBuffer();
+
+  [[nodiscard]] std::span<uint8_t> span() const { return {m_data, k_maxFrameSize}; }
+
+  [[nodiscard]] uint8_t* data() const { return m_data; }
+
+ private:
+  friend class BufferPool;
+
+  PooledBuffer(BufferPool* pool, uint8_t* data) : m_pool(pool), m_data(data) {}
+
+  BufferPool* m_pool{nullptr};
+  uint8_t* m_data{nullptr};
+};
+
+// Fixed set of preallocated frame buffers shared by the send path. When every buffer is borrowed the pool
+// falls back to a heap allocation, which is counted so an undersized pool shows up in the stats.
+class BufferPool {
+ public:
+  explicit BufferPool(size_t bufferCount);
+
+  [[nodiscard]] PooledBuffer acquire();
+
+  [[nodiscard]] uint64_t getFallbackCount() const { return m_fallbacks; }
+
+ private:
+  friend class PooledBuffer;
+
+  using Buffer = std::array<uint8_t, k_maxFrameSize>;
+
+  void release(uint8_t* data);
+
+  std::vector<Buffer> m_storage;
+  std::vector<uint8_t*> m_free;
+  std::mutex m_mutex;
+  std::atomic_uint64_t m_fallbacks{0};
+};
+
+}  // namespace vanch
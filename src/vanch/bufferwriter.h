@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace vanch {
+
+// Sequential big-endian writer over a caller-owned buffer. Keeps a running byte sum so the frame checksum is
+// available without a second pass. Writes past the end are dropped and flagged instead of throwing.
+class BufferWriter {
+ public:
+  explicit BufferWriter(const std::span<uint8_t> buffer) : m_buffer(buffer) {}
+
+  BufferWriter& put(const uint8_t value) {
+    if (m_size >= m_buffer.size()) {
+      m_overflowed = true;
+      return *this;
+    }
+    m_buffer[m_size++] = value;
+    m_sum += value;
+    return *this;
+  }
+
+  BufferWriter& putU16(const uint16_t value) {
+    return put(static_cast<uint8_t>((value >> 8) & 0xFF)).put(static_cast<uint8_t>(value & 0xFF));
+  }
+
+  BufferWriter& putU32(const uint32_t value) {
+    return putU16(static_cast<uint16_t>((value >> 16) & 0xFFFF)).putU16(static_cast<uint16_t>(value & 0xFFFF));
+  }
+
+  BufferWriter& put(const std::span<const uint8_t> bytes) {
+    if (bytes.size() > m_buffer.size() - m_size) {
+      m_overflowed = true;
+      return *this;
+    }
+    if (!bytes.empty()) std::memcpy(m_buffer.data() + m_size, bytes.data(), bytes.size());
+    for (const auto byte : bytes) m_sum += byte;
+    m_size += bytes.size();
+    return *this;
+  }
+
+  BufferWriter& put(const std::string_view text) {
+    return put(std::span{reinterpret_cast<const uint8_t*>(text.data()), text.size()});
+  }
+
+  // Overwrites an already written big-endian field, e.g. the frame length placeholder.
+  void patchU16(const size_t offset, const uint16_t value) {
+    if (offset + 2 > m_size) return;
+    m_sum -= m_buffer[offset] + m_buffer[offset + 1];
+    m_buffer[offset] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    m_buffer[offset + 1] = static_cast<uint8_t>(value & 0xFF);
+    m_sum += m_buffer[offset] + m_buffer[offset + 1];
+  }
+
+  [[nodiscard]] size_t size() const { return m_size; }
+
+  [[nodiscard]] uint8_t sum() const { return m_sum; }
+
+  [[nodiscard]] bool overflowed() const { return m_overflowed; }
+
+  [[nodiscard]] std::span<uint8_t> written() const { return m_buffer.first(m_size); }
+
+ private:
+  std::span<uint8_t> m_buffer;
+  size_t m_size{0};
+  uint8_t m_sum{0};
+  bool m_overflowed{false};
+};
+
+}  // namespace vanch
@@ -0,0 +1,121 @@
+#include "capturereplay.h"
+
+#include <fmt/format.h>
+
+#include "vanch/messageregistry.h"
+
+namespace vanch {
+
+CaptureReplay::CaptureReplay(asio::any_io_executor executor)
+    : Loggable("CaptureReplay"), m_executor(std::move(executor)) {}
+
+CaptureReplay::~CaptureReplay() { stop(); }
+
+CaptureReplayStats CaptureReplay::decode(CaptureReader& reader,
+                                         const std::function<void(const std::shared_ptr<IMessage>&)>& handler) {
+  CaptureReplayStats stats;
+  FrameDecoder decoder;
+  CapturedFrame frame;
+
+  const auto started = std::chrono::steady_clock::now();
+
+  while (reader.next(frame)) {
+    if (frame.direction != FrameDirection::Inbound) continue;
+
+    ++stats.datagrams;
+    stats.bytes += frame.data.size();
+
+    decoder.feedDatagram(frame.data, [&](const std::span<const uint8_t> data) {
+      const auto message = MessageRegistry::createFromData(data);
+
+      if (!message) {
+        ++stats.decodeFailures;
+        return;
+      }
+
+      ++stats.messages;
+      if (handler) handler(message);
+    });
+  }
+
+  stats.elapsed = std::chrono::steady_clock::now() - started;
+  return stats;
+}
+
+bool CaptureReplay::start(const std::filesystem::path& path, UdpClient& client, const CaptureReplayOptions& options) {
+  if (m_isRunning) {
+    logger->warn("A replay is already running");
+    return false;
+  }
+
+  CaptureReader reader;
+  if (!reader.open(path)) {
+    logger->error("Failed to open capture {}", path.string());
+    return false;
+  }
+
+  m_datagrams = 0;
+  m_bytes = 0;
+  m_elapsedNs = 0;
+  m_stopRequested = false;
+  m_isRunning = true;
+
+  logger->info("Replaying {} at {}", path.string(), options.speed > 0.0 ? fmt::format("{}x", options.speed) : "full speed");
+
+  co_spawn(m_executor, replayLoop(std::move(reader), client, options), asio::detached);
+  return true;
+}
+
+void CaptureReplay::stop() { m_stopRequested = true; }
+
+CaptureReplayStats CaptureReplay::getStats() const {
+  return {
+      .datagrams = m_datagrams.load(std::memory_order_relaxed),
+      .bytes = m_bytes.load(std::memory_order_relaxed),
+      .elapsed = std::chrono::nanoseconds(m_elapsedNs.load(std::memory_order_relaxed)),
+  };
+}
+
+asio::awaitable<void> CaptureReplay::replayLoop(CaptureReader reader, UdpClient& client,
+                                                const CaptureReplayOptions options) {
+  steady_timer timer{m_executor};
+  CapturedFrame frame;
+
+  const auto started = std::chrono::steady_clock::now();
+  std::optional<std::chrono::system_clock::time_point> firstCaptured;
+
+  while (!m_stopRequested && reader.next(frame)) {
+    if (frame.direction != FrameDirection::Inbound) continue;
+
+    if (options.speed > 0.0) {
+      if (!firstCaptured) firstCaptured = frame.timestamp;
+
+      const auto offset = std::chrono::duration<double>(frame.timestamp - *firstCaptured) / options.speed;
+      const auto due = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+
+      // Long gaps are slept in slices so a stop request is noticed
+      while (!m_stopRequested && std::chrono::steady_clock::now() < due) {
+        timer.expires_at(std::min(due, std::chrono::steady_clock::now() + k_stopCheckInterval));
+        co_await timer.async_wait();
+      }
+    }
+
+    if (frame.channel == CaptureChannel::Broadcast) {
+      client.injectBroadcast(frame.data);
+    } else {
+      while (!m_stopRequested && !client.injectDatagram(frame.data)) {
+        timer.expires_after(k_backoff);
+        co_await timer.async_wait();
+      }
+    }
+
+    m_datagrams.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(frame.data.size(), std::memory_order_relaxed);
+    m_elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+  }
+
+  logger->info("Replay finished after {} datagrams", m_datagrams.load());
+  m_isRunning = false;
+}
+
+}  // namespace vanch
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "framecapture.h"
+#include "vanch/udpclient.h"
+
+namespace vanch {
+
+struct CaptureReplayOptions {
+  double speed{1.0};  // Multiple of the captured pace; 0 replays as fast as the session accepts datagrams
+};
+
+struct CaptureReplayStats {
+  uint64_t datagrams{0};
+  uint64_t bytes{0};
+  uint64_t messages{0};        // Decoded messages, only counted by decode()
+  uint64_t decodeFailures{0};  // Well-formed frames no message could be created from, only counted by decode()
+  std::chrono::nanoseconds elapsed{};
+};
+
+// Pushes the inbound traffic of a capture back through the client, so decoding, request matching and every
+// subscriber run as they did when it was recorded, without a reader. Outbound datagrams are skipped.
+class CaptureReplay final : kr::Loggable {
+ public:
+  explicit CaptureReplay(asio::any_io_executor executor);
+
+  ~CaptureReplay() override;
+
+  // Decodes every inbound datagram of the capture on the calling thread as fast as possible, without dispatching.
+  // Measures decoder throughput on a real traffic mix.
+  static CaptureReplayStats decode(CaptureReader& reader,
+                                   const std::function<void(const std::shared_ptr<IMessage>&)>& handler = {});
+
+  bool start(const std::filesystem::path& path, UdpClient& client, const CaptureReplayOptions& options = {});
+
+  void stop();
+
+  [[nodiscard]] bool isRunning() const { return m_isRunning; }
+
+  [[nodiscard]] CaptureReplayStats getStats() const;
+
+ private:
+  static constexpr auto k_stopCheckInterval = std::chrono::milliseconds(100);
+  static constexpr auto k_backoff = std::chrono::milliseconds(1);
+
+  asio::awaitable<void> replayLoop(CaptureReader reader, UdpClient& client, CaptureReplayOptions options);
+
+  asio::any_io_executor m_executor;
+  std::atomic_bool m_isRunning{false};
+  std::atomic_bool m_stopRequested{false};
+
+  std::atomic<uint64_t> m_datagrams{0};
+  std::atomic<uint64_t> m_bytes{0};
+  std::atomic<int64_t> m_elapsedNs{0};
+};
+
+}  // namespace vanch
@@ -0,0 +1,126 @@
+#include "framecapture.h"
+
+#include <cstring>
+
+namespace vanch {
+
+FrameCapture::FrameCapture() : Loggable("FrameCapture") {}
+
+FrameCapture::~FrameCapture() { close(); }
+
+bool FrameCapture::open(const std::filesystem::path& path) {
+  std::lock_guard lock(m_mutex);
+
+  if (m_file) return true;
+
+#if defined(_WIN32)
+  m_file = _wfopen(path.c_str(), L"wb");
+#else
+  m_file = std::fopen(path.c_str(), "wb");
+#endif
+
+  if (!m_file) {
+    logger->error("Failed to create capture file {}", path.string());
+    return false;
+  }
+
+  std::setvbuf(m_file, nullptr, _IOFBF, k_bufferSize);
+
+  const CaptureFileHeader header{};
+  std::fwrite(&header, sizeof(header), 1, m_file);
+
+  m_frames = 0;
+  m_bytes = 0;
+  m_isOpen = true;
+
+  logger->info("Capturing frames to {}", path.string());
+  return true;
+}
+
+void FrameCapture::close() {
+  std::lock_guard lock(m_mutex);
+
+  if (!m_file) return;
+
+  m_isOpen = false;
+  std::fclose(m_file);
+  m_file = nullptr;
+
+  logger->info("Capture closed after {} frames", m_frames.load());
+}
+
+void FrameCapture::record(const FrameDirection direction, const CaptureChannel channel,
+                          const asio::ip::udp::endpoint& endpoint, const std::span<const uint8_t> data,
+                          const std::chrono::system_clock::time_point timestamp) {
+  if (!m_isOpen) return;
+
+  CaptureRecordHeader header{};
+  header.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count();
+  header.length = static_cast<uint32_t>(data.size());
+  header.port = endpoint.port();
+  header.direction = direction;
+  header.channel = channel;
+
+  if (const auto address = endpoint.address(); address.is_v6()) {
+    header.address = address.to_v6().to_bytes();
+    header.isV6 = 1;
+  } else {
+    const auto bytes = address.to_v4().to_bytes();
+    std::ranges::copy(bytes, header.address.begin());
+  }
+
+  std::lock_guard lock(m_mutex);
+
+  if (!m_file) return;
+
+  std::fwrite(&header, sizeof(header), 1, m_file);
+  std::fwrite(data.data(), 1, data.size(), m_file);
+
+  m_frames.fetch_add(1, std::memory_order_relaxed);
+  m_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+}
+
+bool CaptureReader::open(const std::filesystem::path& path) {
+  if (!m_file.open(path)) return false;
+
+  const auto data = m_file.data();
+  if (data.size() < sizeof(CaptureFileHeader)) return false;
+
+  CaptureFileHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != CaptureFileHeader::k_magic || header.version != CaptureFileHeader::k_version) return false;
+
+  rewind();
+  return true;
+}
+
+bool CaptureReader::next(CapturedFrame& frame) {
+  const auto data = m_file.data();
+  if (m_offset + sizeof(CaptureRecordHeader) > data.size()) return false;
+
+  // Records are packed without padding, so the header is copied out instead of being read in place
+  CaptureRecordHeader header;
+  std::memcpy(&header, data.data() + m_offset, sizeof(header));
+
+  const auto payload = m_offset + sizeof(CaptureRecordHeader);
+  if (payload + header.length > data.size()) return false;
+
+  asio::ip::address address;
+  if (header.isV6) {
+    address = asio::ip::address_v6(header.address);
+  } else {
+    address = asio::ip::address_v4({header.address[0], header.address[1], header.address[2], header.address[3]});
+  }
+
+  frame.timestamp = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+      std::chrono::microseconds(header.timestampUs)));
+  frame.direction = header.direction;
+  frame.channel = header.channel;
+  frame.endpoint = {address, header.port};
+  frame.data = data.subspan(payload, header.length);
+
+  m_offset = payload + header.length;
+  return true;
+}
+
+}  // namespace vanch
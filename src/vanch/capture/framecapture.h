@@ -0,0 +1,105 @@
+#pragma once
+
+#include <asio.hpp>
+#include <cstdio>
+
+#include "krog/util/loggable.h"
+#include "vanch/mappedfile.h"
+
+namespace vanch {
+
+enum class FrameDirection : uint8_t {
+  Inbound,
+  Outbound,
+};
+
+enum class CaptureChannel : uint8_t {
+  Session,    // Traffic with the reader a session talks to
+  Broadcast,  // Datagrams received on the broadcast port
+};
+
+// A capture file is a CaptureFileHeader followed by records, each a CaptureRecordHeader and the raw datagram.
+// Values are stored in host byte order.
+struct CaptureFileHeader {
+  static constexpr uint64_t k_magic = 0x3130504143545456;  // "VTTCAP01"
+  static constexpr uint32_t k_version = 1;
+
+  uint64_t magic{k_magic};
+  uint32_t version{k_version};
+  uint32_t reserved{0};
+};
+
+struct CaptureRecordHeader {
+  int64_t timestampUs;  // Microseconds since the Unix epoch
+  uint32_t length;
+  uint16_t port;
+  FrameDirection direction;
+  CaptureChannel channel;
+  std::array<uint8_t, 16> address;  // IPv4 addresses take the first four bytes
+  uint8_t isV6;
+  std::array<uint8_t, 7> reserved;
+};
+
+static_assert(sizeof(CaptureFileHeader) == 16 && sizeof(CaptureRecordHeader) == 40);
+
+struct CapturedFrame {
+  std::chrono::system_clock::time_point timestamp;
+  FrameDirection direction;
+  CaptureChannel channel;
+  asio::ip::udp::endpoint endpoint;
+  std::span<const uint8_t> data;  // Points into the capture reader's mapping
+};
+
+// Records raw datagrams as they are sent and received. Safe to share between sessions on different threads; records
+// go through a large stdio buffer under a mutex, so recording mostly costs a copy.
+class FrameCapture final : kr::Loggable {
+ public:
+  FrameCapture();
+
+  ~FrameCapture() override;
+
+  FrameCapture(const FrameCapture&) = delete;
+
+  FrameCapture& operator=(const FrameCapture&) = delete;
+
+  bool open(const std::filesystem::path& path);
+
+  void close();
+
+  [[nodiscard]] bool isOpen() const { return m_isOpen; }
+
+  void record(FrameDirection direction, CaptureChannel channel, const asio::ip::udp::endpoint& endpoint,
+              std::span<const uint8_t> data,
+              std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+  [[nodiscard]] uint64_t getFrameCount() const { return m_frames.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] uint64_t getByteCount() const { return m_bytes.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr size_t k_bufferSize = 1024 * 1024;
+
+  std::mutex m_mutex;
+  std::FILE* m_file{nullptr};
+  std::atomic_bool m_isOpen{false};
+
+  std::atomic<uint64_t> m_frames{0};
+  std::atomic<uint64_t> m_bytes{0};
+};
+
+// Iterates over the records of a capture file through a memory mapping.
+class CaptureReader {
+ public:
+  bool open(const std::filesystem::path& path);
+
+  // Returns false at the end of the capture or at a truncated record.
+  bool next(CapturedFrame& frame);
+
+  void rewind() { m_offset = sizeof(CaptureFileHeader); }
+
+ private:
+  MappedFile m_file;
+  size_t m_offset{0};
+};
+
+}  // namespace vanch
@@ -0,0 +1,92 @@
+#include "commandlatency.h"
+
+#include "messageregistry.h"
+
+namespace vanch {
+
+void CommandLatencyRecorder::record(const uint8_t cmdCode, const RequestStatus status,
+                                    const std::chrono::steady_clock::duration latency, const bool isRetry) {
+  std::lock_guard lock(m_mutex);
+
+  auto& command = m_commands[cmdCode];
+  if (!command) {
+    command = std::make_unique<CommandLatency>();
+    command->cmdCode = cmdCode;
+  }
+
+  if (isRetry) ++command->retries;
+
+  switch (status) {
+    case RequestStatus::Ok:
+      ++command->ok;
+      break;
+    case RequestStatus::DeviceError:
+      ++command->deviceErrors;
+      break;
+    case RequestStatus::Timeout:
+      ++command->timeouts;
+      break;
+    case RequestStatus::Pending:
+    case RequestStatus::Cancelled:
+      ++command->cancelled;
+      return;
+  }
+
+  command->histogram.record(latency);
+}
+
+std::vector<CommandLatency> CommandLatencyRecorder::snapshot() const {
+  std::lock_guard lock(m_mutex);
+
+  std::vector<CommandLatency> latencies;
+
+  for (const auto& command : m_commands) {
+    if (command) latencies.push_back(*command);
+  }
+
+  return latencies;
+}
+
+void CommandLatencyRecorder::reset() {
+  std::lock_guard lock(m_mutex);
+  for (auto& command : m_commands) command.reset();
+}
+
+nlohmann::json makeLatencyReport(const std::span<const CommandLatency> latencies) {
+  const auto commands = MessageRegistry::getCommandMetadata();
+  auto report = nlohmann::json::array();
+
+  for (const auto& latency : latencies) {
+    const auto& histogram = latency.histogram;
+
+    const auto it = std::ranges::find(commands, latency.cmdCode, &CommandMetadata::cmdCode);
+    const auto name = it != commands.end() ? std::string(it->name) : std::string{};
+
+    auto buckets = nlohmann::json::array();
+    histogram.forEachBucket([&buckets](const std::chrono::microseconds upperBound, const uint64_t count) {
+      buckets.push_back({upperBound.count(), count});
+    });
+
+    report.push_back({
+        {"cmdCode", latency.cmdCode},
+        {"name", name},
+        {"ok", latency.ok},
+        {"deviceErrors", latency.deviceErrors},
+        {"timeouts", latency.timeouts},
+        {"cancelled", latency.cancelled},
+        {"retries", latency.retries},
+        {"minUs", histogram.getMin().count()},
+        {"meanUs", histogram.getMean().count()},
+        {"p50Us", histogram.getPercentile(0.50).count()},
+        {"p90Us", histogram.getPercentile(0.90).count()},
+        {"p99Us", histogram.getPercentile(0.99).count()},
+        {"p999Us", histogram.getPercentile(0.999).count()},
+        {"maxUs", histogram.getMax().count()},
+        {"buckets", std::move(buckets)},  // [upper bound in us, count]
+    });
+  }
+
+  return report;
+}
+
+}  // namespace vanch
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "latencyhistogram.h"
+#include "requesttracker.h"
+
+namespace vanch {
+
+// Round trips of one command code to one reader. Every attempt counts: returns and device errors are recorded with
+// their latency, timeouts with the time they waited, so a slow link shows up in the tail rather than vanishing from
+// it. Cancelled attempts never got an answer and are only counted.
+struct CommandLatency {
+  uint8_t cmdCode{0};
+  LatencyHistogram histogram;
+  uint64_t ok{0};
+  uint64_t deviceErrors{0};
+  uint64_t timeouts{0};
+  uint64_t cancelled{0};
+  uint64_t retries{0};  // Attempts after the first, which only follow a timeout
+
+  [[nodiscard]] uint64_t getAttempts() const { return ok + deviceErrors + timeouts + cancelled; }
+};
+
+// Collects CommandLatency per command code for one reader session. Recording happens on the session strand while
+// the UI or an export takes snapshots from other threads, so both sides share a mutex that is only ever held briefly.
+class CommandLatencyRecorder {
+ public:
+  void record(uint8_t cmdCode, RequestStatus status, std::chrono::steady_clock::duration latency, bool isRetry);
+
+  // Command codes with at least one attempt, in ascending order
+  [[nodiscard]] std::vector<CommandLatency> snapshot() const;
+
+  void reset();
+
+ private:
+  mutable std::mutex m_mutex;
+
+  // Indexed by command code; allocated on first use since a session talks in only a handful of codes
+  std::array<std::unique_ptr<CommandLatency>, 256> m_commands;
+};
+
+// Summary and non-empty buckets of every command, for offline comparison between readers and firmware versions.
+nlohmann::json makeLatencyReport(std::span<const CommandLatency> latencies);
+
+}  // namespace vanch
@@ -0,0 +1,146 @@
+#include "commandqueue.h"
+
+namespace vanch {
+
+const char* getCommandPriorityName(const CommandPriority priority) {
+  switch (priority) {
+    case CommandPriority::Urgent:
+      return "urgent";
+    case CommandPriority::Normal:
+      return "normal";
+    case CommandPriority::Bulk:
+      return "bulk";
+  }
+  return "unknown";
+}
+
+CommandPriority getDefaultPriority(const uint8_t cmdCode) {
+  switch (cmdCode) {
+    case CmdSetRelayStatus_Traits::s_cmdCode:
+    case CmdSetBuzzer_Traits::s_cmdCode:
+      return CommandPriority::Urgent;
+    case CmdRead15693Tag_Traits::s_cmdCode:
+    case CmdWrite15693Tag_Traits::s_cmdCode:
+    case CmdWrite15693MultipleBlocks_Traits::s_cmdCode:
+    case CmdReadISO15693Tag_Traits::s_cmdCode:
+    case CmdWriteISO15693Tag_Traits::s_cmdCode:
+    case CmdRead14443ATag_Traits::s_cmdCode:
+    case CmdWrite14443ATag_Traits::s_cmdCode:
+    case CmdSelect14443ASector_Traits::s_cmdCode:
+    case CmdWrite14443AMultipleBlocks_Traits::s_cmdCode:
+      return CommandPriority::Bulk;
+    default:
+      return CommandPriority::Normal;
+  }
+}
+
+uint64_t CommandQueueStats::getDepth() const {
+  uint64_t depth = 0;
+  for (const auto& lane : lanes) depth += lane.depth;
+  return depth;
+}
+
+uint64_t CommandQueueStats::getDropped() const {
+  uint64_t dropped = 0;
+  for (const auto& lane : lanes) dropped += lane.dropped;
+  return dropped;
+}
+
+CommandQueue::Lane::Lane(const asio::any_io_executor& executor)
+    : spaceSignal(executor, steady_timer::time_point::max()) {}
+
+CommandQueue::CommandQueue(const asio::any_io_executor& executor, const size_t laneCapacity)
+    : m_laneCapacity(std::max<size_t>(laneCapacity, 1)),
+      m_lanes{Lane{executor}, Lane{executor}, Lane{executor}},
+      m_requestSignal(executor, steady_timer::time_point::max()) {}
+
+bool CommandQueue::tryPush(const std::shared_ptr<PendingRequest>& request) {
+  if (!m_isOpen) return false;
+
+  auto& lane = getLane(request->priority);
+
+  if (lane.requests.size() >= m_laneCapacity) {
+    lane.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  lane.requests.push_back(request);
+  lane.depth.store(lane.requests.size(), std::memory_order_relaxed);
+  lane.enqueued.fetch_add(1, std::memory_order_relaxed);
+
+  m_requestSignal.cancel();
+  return true;
+}
+
+asio::awaitable<bool> CommandQueue::push(std::shared_ptr<PendingRequest> request) {
+  auto& lane = getLane(request->priority);
+
+  if (m_isOpen && lane.requests.size() >= m_laneCapacity) {
+    lane.blocked.fetch_add(1, std::memory_order_relaxed);
+
+    // Every pop wakes one producer, but whoever resumes first takes the space, so check again
+    while (m_isOpen && lane.requests.size() >= m_laneCapacity) {
+      co_await lane.spaceSignal.async_wait();
+    }
+
+    lane.blocked.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  co_return tryPush(request);
+}
+
+asio::awaitable<std::shared_ptr<PendingRequest>> CommandQueue::pop() {
+  while (m_isOpen) {
+    for (auto& lane : m_lanes) {
+      if (lane.requests.empty()) continue;
+
+      auto request = std::move(lane.requests.front());
+      lane.requests.pop_front();
+      lane.depth.store(lane.requests.size(), std::memory_order_relaxed);
+      lane.spaceSignal.cancel_one();
+
+      co_return request;
+    }
+
+    co_await m_requestSignal.async_wait();
+  }
+
+  co_return nullptr;
+}
+
+void CommandQueue::close() {
+  m_isOpen = false;
+
+  for (auto& lane : m_lanes) {
+    while (!lane.requests.empty()) {
+      const auto request = std::move(lane.requests.front());
+      lane.requests.pop_front();
+      request->settle(RequestStatus::Cancelled);
+    }
+
+    lane.depth.store(0, std::memory_order_relaxed);
+    lane.spaceSignal.cancel();
+  }
+
+  m_requestSignal.cancel();
+}
+
+void CommandQueue::open() { m_isOpen = true; }
+
+CommandQueueStats CommandQueue::getStats() const {
+  CommandQueueStats stats;
+
+  for (size_t i = 0; i < k_commandPriorityCount; ++i) {
+    const auto& lane = m_lanes[i];
+    stats.lanes[i] = {
+        .depth = lane.depth.load(std::memory_order_relaxed),
+        .blocked = lane.blocked.load(std::memory_order_relaxed),
+        .enqueued = lane.enqueued.load(std::memory_order_relaxed),
+        .dropped = lane.dropped.load(std::memory_order_relaxed),
+    };
+  }
+
+  return stats;
+}
+
+}  // namespace vanch
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "requesttracker.h"
+
+namespace vanch {
+
+const char* getCommandPriorityName(CommandPriority priority);
+
+// Lane a command takes unless its request names one: relay and buzzer control is urgent, tag block reads and writes
+// are bulk, everything else is normal.
+CommandPriority getDefaultPriority(uint8_t cmdCode);
+
+struct CommandLaneStats {
+  uint64_t depth{0};    // Waiting for the request window right now
+  uint64_t blocked{0};  // Producers waiting for space right now
+  uint64_t enqueued{0};
+  uint64_t dropped{0};  // Rejected by tryPush because the lane was full
+};
+
+struct CommandQueueStats {
+  std::array<CommandLaneStats, k_commandPriorityCount> lanes;
+
+  [[nodiscard]] uint64_t getDepth() const;
+
+  [[nodiscard]] uint64_t getDropped() const;
+};
+
+// Bounded queue of requests waiting for the request window, with one FIFO lane per priority. The consumer always
+// takes from the most urgent non-empty lane, so control commands overtake a backlog of bulk transfers. Each lane is
+// bounded on its own: producers either await space or have their request rejected, and a full bulk lane never
+// blocks urgent commands. Like the RequestTracker it must only be used from the session strand; producers on other
+// threads reach it through co_spawn onto the strand. The stats may be read from any thread.
+class CommandQueue {
+ public:
+  CommandQueue(const asio::any_io_executor& executor, size_t laneCapacity);
+
+  // Fails if the lane is full or the queue is closed.
+  bool tryPush(const std::shared_ptr<PendingRequest>& request);
+
+  // Resumes once the request is queued, or with false if the queue is closed first.
+  asio::awaitable<bool> push(std::shared_ptr<PendingRequest> request);
+
+  // Resumes with the oldest request of the most urgent lane, or with nullptr once the queue is closed.
+  asio::awaitable<std::shared_ptr<PendingRequest>> pop();
+
+  // Cancels every queued request and wakes all waiting producers and the consumer.
+  void close();
+
+  // Accepts requests again after close().
+  void open();
+
+  [[nodiscard]] CommandQueueStats getStats() const;
+
+ private:
+  struct Lane {
+    explicit Lane(const asio::any_io_executor& executor);
+
+    std::deque<std::shared_ptr<PendingRequest>> requests;
+
+    // Never expires; cancelled to wake a producer waiting for space
+    steady_timer spaceSignal;
+
+    std::atomic<uint64_t> depth{0};
+    std::atomic<uint64_t> blocked{0};
+    std::atomic<uint64_t> enqueued{0};
+    std::atomic<uint64_t> dropped{0};
+  };
+
+  Lane& getLane(const CommandPriority priority) { return m_lanes[static_cast<size_t>(priority)]; }
+
+  size_t m_laneCapacity;
+  std::array<Lane, k_commandPriorityCount> m_lanes;
+  bool m_isOpen{true};
+
+  // Never expires; cancelled to wake the consumer
+  steady_timer m_requestSignal;
+};
+
+}  // namespace vanch
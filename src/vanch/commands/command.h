@@ -6,10 +6,18 @@
   VANCH_DEFINE_TRAITS(Cmd##MessageName, cmdCode, MessageType_Command, description) \
   VANCH_DEFINE_TRAITS(Ret##MessageName, cmdCode, MessageType_Return, Cmd##MessageName##_Traits::getName())
 
+// Links a command to the return the reader answers it with, so requests can be typed by their command.
+#define VANCH_DEFINE_RETURN_OF(messageName) \
+  struct Ret##messageName;                  \
+  template <>                               \
+  struct ReturnOf<Cmd##messageName> {       \
+    using type = Ret##messageName;          \
+  };
+
 #define VANCH_CMD_BEGIN(messageName, cmdCode, description)                         \
   VANCH_DEFINE_TRAITS(Cmd##messageName, cmdCode, MessageType_Command, description) \
   struct Cmd##messageName : Message<Cmd##messageName##_Traits> {                   \
-    std::vector<uint8_t> serializeParameters() const override;                     \
+    void serializeParameters(BufferWriter& writer) const override;                 \
     void render() override;
 
 #define VANCH_CMD_END() \
@@ -21,6 +29,7 @@
   struct Cmd##messageName : Message<Cmd##messageName##_Traits> {};
 
 #define VANCH_RET_BEGIN(messageName)                                                              \
+  VANCH_DEFINE_RETURN_OF(messageName)                                                             \
   VANCH_DEFINE_TRAITS(Ret##messageName, Cmd##messageName##_Traits::s_cmdCode, MessageType_Return, \
                       Cmd##messageName##_Traits::getName())                                       \
   struct Ret##messageName : Message<Ret##messageName##_Traits> {                                  \
@@ -32,12 +41,19 @@
   ;
 
 #define VANCH_RET_EMPTY(messageName)                                                              \
+  VANCH_DEFINE_RETURN_OF(messageName)                                                             \
   VANCH_DEFINE_TRAITS(Ret##messageName, Cmd##messageName##_Traits::s_cmdCode, MessageType_Return, \
                       Cmd##messageName##_Traits::getName())                                       \
   struct Ret##messageName : Message<Ret##messageName##_Traits> {};
 
 namespace vanch {
 
+template <typename Cmd>
+struct ReturnOf;
+
+template <typename Cmd>
+using ReturnOf_t = typename ReturnOf<Cmd>::type;
+
 // Basic commands
 
 VANCH_CMD_BEGIN(SetBaudRate, 0x01, "Set baud rate")
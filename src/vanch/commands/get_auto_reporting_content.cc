@@ -5,7 +5,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetAutoReportingContent::serializeParameters() const { return {customFieldNumber}; }
+void CmdGetAutoReportingContent::serializeParameters(BufferWriter& writer) const {
+  writer.put(customFieldNumber);
+}
 
 void CmdGetAutoReportingContent::render() {
   int temp = customFieldNumber;
@@ -9,8 +9,8 @@ namespace vanch {
   return (code < 5) ? baudRates[code] : 0;
 }
 
-std::vector<uint8_t> CmdGetBaudRate::serializeParameters() const {
-  return {interfaceType};
+void CmdGetBaudRate::serializeParameters(BufferWriter& writer) const {
+  writer.put(interfaceType);
 }
 
 void CmdGetBaudRate::render() {
@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetGPIStatus::serializeParameters() const { return {gpiNumber}; }
+void CmdGetGPIStatus::serializeParameters(BufferWriter& writer) const {
+  writer.put(gpiNumber);
+}
 
 void CmdGetGPIStatus::render() {
   int tempGPI = gpiNumber;
@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetOutputPower::serializeParameters() const { return {antennaNumber}; }
+void CmdGetOutputPower::serializeParameters(BufferWriter& writer) const {
+  writer.put(antennaNumber);
+}
 
 void CmdGetOutputPower::render() {
   int temp = antennaNumber;
@@ -5,7 +5,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetRelayAutoControlParams::serializeParameters() const { return {relayNumber}; }
+void CmdGetRelayAutoControlParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(relayNumber);
+}
 
 void CmdGetRelayAutoControlParams::render() {
   int temp = relayNumber;
@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetRelayStatus::serializeParameters() const { return {relayNumber}; }
+void CmdGetRelayStatus::serializeParameters(BufferWriter& writer) const {
+  writer.put(relayNumber);
+}
 
 void CmdGetRelayStatus::render() {
   int temp = relayNumber;
@@ -5,7 +5,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetReportedHardwareInterface::serializeParameters() const { return {interfaceNumber}; }
+void CmdGetReportedHardwareInterface::serializeParameters(BufferWriter& writer) const {
+  writer.put(interfaceNumber);
+}
 
 void CmdGetReportedHardwareInterface::render() {
   static const char* interfaceItems[] = {"RS232 (0x00)",      "RS485 (0x01)", "RJ45 (0x02)", "Wiegand 26 (0x03)",
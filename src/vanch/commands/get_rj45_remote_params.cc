@@ -5,7 +5,7 @@
 namespace vanch {
 
 void RetGetRJ45RemoteParams::deserializeParameters(const std::span<const uint8_t> data) {
-  if (data.size() >= 15) {
+  if (data.size() >= 14) {
     std::copy_n(data.begin(), 4, udpServerIP.begin());
     udpServerPort = (data[4] << 8) | data[5];
     udpEnabled = data[6];
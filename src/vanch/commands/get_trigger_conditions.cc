@@ -5,7 +5,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdGetTriggerConditions::serializeParameters() const { return {triggerNumber}; }
+void CmdGetTriggerConditions::serializeParameters(BufferWriter& writer) const {
+  writer.put(triggerNumber);
+}
 
 void CmdGetTriggerConditions::render() {
   int temp = triggerNumber;
@@ -5,12 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdRead14443ATag::serializeParameters() const {
-  std::vector<uint8_t> result = {uidLength};
-  result.insert(result.end(), uid.begin(), uid.end());
-  result.push_back(startBlock);
-  result.push_back(numBlocks);
-  return result;
+void CmdRead14443ATag::serializeParameters(BufferWriter& writer) const {
+  writer.put(uidLength).put(uid).put(startBlock).put(numBlocks);
 }
 
 void CmdRead14443ATag::render() {
@@ -5,12 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdRead15693Tag::serializeParameters() const {
-  std::vector<uint8_t> result = {uidLength};
-  result.insert(result.end(), uid.begin(), uid.end());
-  result.push_back(startBlock);
-  result.push_back(numBlocks);
-  return result;
+void CmdRead15693Tag::serializeParameters(BufferWriter& writer) const {
+  writer.put(uidLength).put(uid).put(startBlock).put(numBlocks);
 }
 
 void CmdRead15693Tag::render() {
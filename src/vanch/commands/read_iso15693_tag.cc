@@ -5,13 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdReadISO15693Tag::serializeParameters() const {
-  std::vector<uint8_t> result = {uidLength};
-  result.insert(result.end(), uid.begin(), uid.end());
-  result.push_back(startBlock);
-  result.push_back(numBlocks);
-  result.push_back(blockSize);
-  return result;
+void CmdReadISO15693Tag::serializeParameters(BufferWriter& writer) const {
+  writer.put(uidLength).put(uid).put(startBlock).put(numBlocks).put(blockSize);
 }
 
 void CmdReadISO15693Tag::render() {
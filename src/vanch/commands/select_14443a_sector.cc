@@ -5,11 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSelect14443ASector::serializeParameters() const {
-  std::vector<uint8_t> result = {uidLength};
-  result.insert(result.end(), uid.begin(), uid.end());
-  result.push_back(sectorNumber);
-  return result;
+void CmdSelect14443ASector::serializeParameters(BufferWriter& writer) const {
+  writer.put(uidLength).put(uid).put(sectorNumber);
 }
 
 void CmdSelect14443ASector::render() {
@@ -4,14 +4,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSet4GParams::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.push_back(transmissionMode);
-  result.push_back((port >> 8) & 0xFF);
-  result.push_back(port & 0xFF);
-  result.push_back(addressLength);
-  result.insert(result.end(), address.begin(), address.end());
-  return result;
+void CmdSet4GParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(transmissionMode).putU16(port).put(addressLength).put(address);
 }
 
 void CmdSet4GParams::render() {
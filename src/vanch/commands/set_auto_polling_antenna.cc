@@ -6,7 +6,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetAutoPollingAntenna::serializeParameters() const { return antennas; }
+void CmdSetAutoPollingAntenna::serializeParameters(BufferWriter& writer) const {
+  writer.put(antennas);
+}
 
 void CmdSetAutoPollingAntenna::render() {
   static bool selectedAntennas[4] = {false};  // Assuming max 4 antennas
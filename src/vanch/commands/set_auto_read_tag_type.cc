@@ -5,7 +5,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetAutoReadTagType::serializeParameters() const { return {tagTypeBitmap}; }
+void CmdSetAutoReadTagType::serializeParameters(BufferWriter& writer) const {
+  writer.put(tagTypeBitmap);
+}
 
 void CmdSetAutoReadTagType::render() {
   int temp = tagTypeBitmap;
@@ -5,8 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetAutoReportingConditions::serializeParameters() const {
-  return {reportingMode, reportingInterval};
+void CmdSetAutoReportingConditions::serializeParameters(BufferWriter& writer) const {
+  writer.put(reportingMode).put(reportingInterval);
 }
 
 void CmdSetAutoReportingConditions::render() {
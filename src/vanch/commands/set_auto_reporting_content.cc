@@ -5,10 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetAutoReportingContent::serializeParameters() const {
-  std::vector<uint8_t> result = {customFieldNumber};
-  result.insert(result.end(), customContent.begin(), customContent.end());
-  return result;
+void CmdSetAutoReportingContent::serializeParameters(BufferWriter& writer) const {
+  writer.put(customFieldNumber).put(customContent);
 }
 
 void CmdSetAutoReportingContent::render() {
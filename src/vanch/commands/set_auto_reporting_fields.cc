@@ -5,15 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetAutoReportingFields::serializeParameters() const {
-  return {static_cast<uint8_t>((fieldBitmap >> 24) & 0xFF),
-          static_cast<uint8_t>((fieldBitmap >> 16) & 0xFF),
-          static_cast<uint8_t>((fieldBitmap >> 8) & 0xFF),
-          static_cast<uint8_t>(fieldBitmap & 0xFF),
-          tidStartAddress,
-          tidLength,
-          userStartAddress,
-          userLength};
+void CmdSetAutoReportingFields::serializeParameters(BufferWriter& writer) const {
+  writer.putU32(fieldBitmap).put(tidStartAddress).put(tidLength).put(userStartAddress).put(userLength);
 }
 
 void CmdSetAutoReportingFields::render() {
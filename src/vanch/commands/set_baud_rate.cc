@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetBaudRate::serializeParameters() const { return {interfaceType, baudRateCode}; }
+void CmdSetBaudRate::serializeParameters(BufferWriter& writer) const {
+  writer.put(interfaceType).put(baudRateCode);
+}
 
 void CmdSetBaudRate::render() {
   static const char* interfaceItems[] = {"RS232 (0x00)", "RS485 (0x01)"};
@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetBuzzer::serializeParameters() const { return {state}; }
+void CmdSetBuzzer::serializeParameters(BufferWriter& writer) const {
+  writer.put(state);
+}
 
 void CmdSetBuzzer::render() {
   static const char* items[] = {"Off (0x00)", "On (0x01)"};
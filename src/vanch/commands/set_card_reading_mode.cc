@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetCardReadingMode::serializeParameters() const { return {mode}; }
+void CmdSetCardReadingMode::serializeParameters(BufferWriter& writer) const {
+  writer.put(mode);
+}
 
 void CmdSetCardReadingMode::render() {
   static const char* modes[] = {"Command Mode (0x00)", "Automatic Mode (Continuous) (0x01)",
@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetFrequencyPoints::serializeParameters() const { return {region, startFreq, endFreq}; }
+void CmdSetFrequencyPoints::serializeParameters(BufferWriter& writer) const {
+  writer.put(region).put(startFreq).put(endFreq);
+}
 
 void CmdSetFrequencyPoints::render() {
   static const char* regions[] = {"FCC (0x01)", "ETSI (0x02)", "CHN (0x03)"};
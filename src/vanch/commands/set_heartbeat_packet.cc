@@ -4,12 +4,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetHeartbeatPacket::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.push_back(isEnabled);
-  result.push_back(interval);
-  result.insert(result.end(), heartbeatData.begin(), heartbeatData.end());
-  return result;
+void CmdSetHeartbeatPacket::serializeParameters(BufferWriter& writer) const {
+  writer.put(isEnabled).put(interval).put(heartbeatData);
 }
 
 void CmdSetHeartbeatPacket::render() {
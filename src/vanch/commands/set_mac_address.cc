@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetMACAddress::serializeParameters() const { return {mac.begin(), mac.end()}; }
+void CmdSetMACAddress::serializeParameters(BufferWriter& writer) const {
+  writer.put(mac);
+}
 
 void CmdSetMACAddress::render() {
   static char macStr[18];
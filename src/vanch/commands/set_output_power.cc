@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetOutputPower::serializeParameters() const { return {antennaNumber, powerValue}; }
+void CmdSetOutputPower::serializeParameters(BufferWriter& writer) const {
+  writer.put(antennaNumber).put(powerValue);
+}
 
 void CmdSetOutputPower::render() {
   int tempAntenna = antennaNumber;
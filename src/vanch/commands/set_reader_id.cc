@@ -4,10 +4,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetReaderID::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.insert(result.end(), readerID.begin(), readerID.end());
-  return result;
+void CmdSetReaderID::serializeParameters(BufferWriter& writer) const {
+  writer.put(readerID);
 }
 
 void CmdSetReaderID::render() {
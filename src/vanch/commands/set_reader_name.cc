@@ -4,10 +4,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetReaderName::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.insert(result.end(), readerName.begin(), readerName.end());
-  return result;
+void CmdSetReaderName::serializeParameters(BufferWriter& writer) const {
+  writer.put(readerName);
 }
 
 void CmdSetReaderName::render() {
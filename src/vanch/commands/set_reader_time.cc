@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetReaderTime::serializeParameters() const { return {year, month, day, hour, minute, second}; }
+void CmdSetReaderTime::serializeParameters(BufferWriter& writer) const {
+  writer.put(year).put(month).put(day).put(hour).put(minute).put(second);
+}
 
 void CmdSetReaderTime::render() {
   int tempYear = year, tempMonth = month, tempDay = day;
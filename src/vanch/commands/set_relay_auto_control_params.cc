@@ -5,8 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetRelayAutoControlParams::serializeParameters() const {
-  return {relayNumber, relayPurpose, pickupTime};
+void CmdSetRelayAutoControlParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(relayNumber).put(relayPurpose).put(pickupTime);
 }
 
 void CmdSetRelayAutoControlParams::render() {
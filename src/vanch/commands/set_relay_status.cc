@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetRelayStatus::serializeParameters() const { return {relayNumber, relayState}; }
+void CmdSetRelayStatus::serializeParameters(BufferWriter& writer) const {
+  writer.put(relayNumber).put(relayState);
+}
 
 void CmdSetRelayStatus::render() {
   static const char* stateItems[] = {"Off (0x00)", "On (0x01)"};
@@ -5,8 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetReportedHardwareInterface::serializeParameters() const {
-  return {interfaceNumber, enableReporting};
+void CmdSetReportedHardwareInterface::serializeParameters(BufferWriter& writer) const {
+  writer.put(interfaceNumber).put(enableReporting);
 }
 
 void CmdSetReportedHardwareInterface::render() {
@@ -4,14 +4,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetRJ45LocalParams::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.insert(result.end(), ip.begin(), ip.end());
-  result.insert(result.end(), mask.begin(), mask.end());
-  result.insert(result.end(), gateway.begin(), gateway.end());
-  result.push_back((port >> 8) & 0xFF);
-  result.push_back(port & 0xFF);
-  return result;
+void CmdSetRJ45LocalParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(ip).put(mask).put(gateway).putU16(port);
 }
 
 void CmdSetRJ45LocalParams::render() {
@@ -4,17 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetRJ45RemoteParams::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.insert(result.end(), udpServerIP.begin(), udpServerIP.end());
-  result.push_back((udpServerPort >> 8) & 0xFF);
-  result.push_back(udpServerPort & 0xFF);
-  result.push_back(udpEnabled);
-  result.insert(result.end(), tcpServerIP.begin(), tcpServerIP.end());
-  result.push_back((tcpServerPort >> 8) & 0xFF);
-  result.push_back(tcpServerPort & 0xFF);
-  result.push_back(tcpEnabled);
-  return result;
+void CmdSetRJ45RemoteParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(udpServerIP).putU16(udpServerPort).put(udpEnabled);
+  writer.put(tcpServerIP).putU16(tcpServerPort).put(tcpEnabled);
 }
 
 void CmdSetRJ45RemoteParams::render() {
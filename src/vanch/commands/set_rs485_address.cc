@@ -4,7 +4,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetRS485Address::serializeParameters() const { return {address}; }
+void CmdSetRS485Address::serializeParameters(BufferWriter& writer) const {
+  writer.put(address);
+}
 
 void CmdSetRS485Address::render() {
   static const char* tooltip =
@@ -4,16 +4,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetSuperNetworkParams::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.push_back(mode);
-  result.insert(result.end(), ipAddress.begin(), ipAddress.end());
-  result.insert(result.end(), subnetMask.begin(), subnetMask.end());
-  result.insert(result.end(), gateway.begin(), gateway.end());
-  result.push_back((port >> 8) & 0xFF);
-  result.push_back(port & 0xFF);
-  result.insert(result.end(), remoteIP.begin(), remoteIP.end());
-  return result;
+void CmdSetSuperNetworkParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(mode).put(ipAddress).put(subnetMask).put(gateway).putU16(port).put(remoteIP);
 }
 
 void CmdSetSuperNetworkParams::render() {
@@ -5,13 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetTagAlarm::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.push_back(isEnabled);
-  result.push_back(maskAddress);
-  result.push_back(maskLength);
-  result.insert(result.end(), maskData.begin(), maskData.end());
-  return result;
+void CmdSetTagAlarm::serializeParameters(BufferWriter& writer) const {
+  writer.put(isEnabled).put(maskAddress).put(maskLength).put(maskData);
 }
 
 void CmdSetTagAlarm::render() {
@@ -5,10 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetTagFilter::serializeParameters() const {
-  std::vector result = {isEnabled, maskAddress, maskLength};
-  result.insert(result.end(), maskData.begin(), maskData.end());
-  return result;
+void CmdSetTagFilter::serializeParameters(BufferWriter& writer) const {
+  writer.put(isEnabled).put(maskAddress).put(maskLength).put(maskData);
 }
 
 void CmdSetTagFilter::render() {
@@ -5,8 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetTriggerConditions::serializeParameters() const {
-  return {triggerNumber, triggerLevel, triggerDuration};
+void CmdSetTriggerConditions::serializeParameters(BufferWriter& writer) const {
+  writer.put(triggerNumber).put(triggerLevel).put(triggerDuration);
 }
 
 void CmdSetTriggerConditions::render() {
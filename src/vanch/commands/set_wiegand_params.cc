@@ -5,7 +5,9 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetWiegandParams::serializeParameters() const { return {pulseWidth, pulseInterval}; }
+void CmdSetWiegandParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(pulseWidth).put(pulseInterval);
+}
 
 void CmdSetWiegandParams::render() {
   int temp = pulseWidth;
@@ -4,20 +4,10 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdSetWIFIParams::serializeParameters() const {
-  std::vector<uint8_t> result;
-  result.push_back(wifiMode);
-  result.insert(result.end(), localIP.begin(), localIP.end());
-  result.insert(result.end(), subnetMask.begin(), subnetMask.end());
-  result.insert(result.end(), gateway.begin(), gateway.end());
-  result.push_back((port >> 8) & 0xFF);
-  result.push_back(port & 0xFF);
-  result.insert(result.end(), remoteIP.begin(), remoteIP.end());
-  result.push_back(ssidLength);
-  result.insert(result.end(), ssid.begin(), ssid.end());
-  result.push_back(passwordLength);
-  result.insert(result.end(), password.begin(), password.end());
-  return result;
+void CmdSetWIFIParams::serializeParameters(BufferWriter& writer) const {
+  writer.put(wifiMode).put(localIP).put(subnetMask).put(gateway).putU16(port).put(remoteIP);
+  writer.put(ssidLength).put(ssid);
+  writer.put(passwordLength).put(password);
 }
 
 void CmdSetWIFIParams::render() {
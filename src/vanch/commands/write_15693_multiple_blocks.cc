@@ -5,13 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdWrite15693MultipleBlocks::serializeParameters() const {
-  std::vector<uint8_t> result = {uidLength};
-  result.insert(result.end(), uid.begin(), uid.end());
-  result.push_back(startBlock);
-  result.push_back(numBlocks);
-  result.insert(result.end(), writeData.begin(), writeData.end());
-  return result;
+void CmdWrite15693MultipleBlocks::serializeParameters(BufferWriter& writer) const {
+  writer.put(uidLength).put(uid).put(startBlock).put(numBlocks).put(writeData);
 }
 
 void CmdWrite15693MultipleBlocks::render() {
@@ -5,12 +5,8 @@
 
 namespace vanch {
 
-std::vector<uint8_t> CmdWrite15693Tag::serializeParameters() const {
-  std::vector<uint8_t> result = {uidLength};
-  result.insert(result.end(), uid.begin(), uid.end());
-  result.push_back(writeBlock);
-  result.insert(result.end(), writeData.begin(), writeData.end());
-  return result;
+void CmdWrite15693Tag::serializeParameters(BufferWriter& writer) const {
+  writer.put(uidLength).put(uid).put(writeBlock).put(writeData);
 }
 
 void CmdWrite15693Tag::render() {
@@ -0,0 +1,51 @@
+#include "datagrambatch.h"
+
+namespace vanch {
+
+DatagramBatch::DatagramBatch(const size_t capacity) : m_buffers(capacity), m_endpoints(capacity) {
+  m_datagrams.reserve(capacity);
+
+#ifdef __linux__
+  m_headers.resize(capacity);
+  m_iovecs.resize(capacity);
+
+  for (size_t i = 0; i < capacity; ++i) {
+    m_iovecs[i].iov_base = m_buffers[i].data();
+    m_iovecs[i].iov_len = m_buffers[i].size();
+  }
+#endif
+}
+
+#ifdef __linux__
+size_t DatagramBatch::receiveMultiple(const int socket, asio::error_code& ec) {
+  m_datagrams.clear();
+
+  for (size_t i = 0; i < m_headers.size(); ++i) {
+    auto& header = m_headers[i].msg_hdr;
+    header = {};
+    header.msg_name = m_endpoints[i].data();
+    header.msg_namelen = static_cast<socklen_t>(m_endpoints[i].capacity());
+    header.msg_iov = &m_iovecs[i];
+    header.msg_iovlen = 1;
+  }
+
+  const auto count =
+      ::recvmmsg(socket, m_headers.data(), static_cast<unsigned>(m_headers.size()), MSG_DONTWAIT, nullptr);
+
+  if (count < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+    }
+    return 0;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    m_endpoints[i].resize(m_headers[i].msg_hdr.msg_namelen);
+    m_datagrams.push_back({std::span{m_buffers[i].data(), m_headers[i].msg_len}, m_endpoints[i]});
+  }
+
+  return m_datagrams.size();
+}
+#endif
+
+}  // namespace vanch
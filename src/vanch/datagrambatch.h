@@ -0,0 +1,70 @@
+#pragma once
+
+#include <asio.hpp>
+
+#include "vanch/message.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+namespace vanch {
+
+struct Datagram {
+  std::span<const uint8_t> data;
+  asio::ip::udp::endpoint endpoint;
+};
+
+// Ring of preallocated datagram buffers filled in one go from a readable socket. On Linux a single recvmmsg call
+// drains the whole batch; elsewhere the socket is read in non-blocking mode until it would block.
+class DatagramBatch {
+ public:
+  explicit DatagramBatch(size_t capacity);
+
+  // Receives the datagrams already queued on the socket without blocking. Returns the number received; ec is set
+  // only when nothing could be read because of an error.
+  template <typename Socket>
+  size_t receive(Socket& socket, asio::error_code& ec) {
+#ifdef __linux__
+    return receiveMultiple(socket.native_handle(), ec);
+#else
+    m_datagrams.clear();
+
+    while (m_datagrams.size() < m_buffers.size()) {
+      auto& buffer = m_buffers[m_datagrams.size()];
+      asio::ip::udp::endpoint endpoint;
+
+      const auto size = socket.receive_from(asio::buffer(buffer), endpoint, 0, ec);
+
+      if (ec == asio::error::would_block || (ec && !m_datagrams.empty())) {
+        ec = {};
+        break;
+      }
+
+      if (ec) break;
+
+      m_datagrams.push_back({std::span{buffer.data(), size}, endpoint});
+    }
+
+    return m_datagrams.size();
+#endif
+  }
+
+  [[nodiscard]] std::span<const Datagram> datagrams() const { return m_datagrams; }
+
+  [[nodiscard]] size_t capacity() const { return m_buffers.size(); }
+
+ private:
+#ifdef __linux__
+  size_t receiveMultiple(int socket, asio::error_code& ec);
+
+  std::vector<mmsghdr> m_headers;
+  std::vector<iovec> m_iovecs;
+#endif
+
+  std::vector<std::array<uint8_t, k_maxFrameSize>> m_buffers;
+  std::vector<asio::ip::udp::endpoint> m_endpoints;
+  std::vector<Datagram> m_datagrams;
+};
+
+}  // namespace vanch
@@ -0,0 +1,39 @@
+#include "framedecoder.h"
+
+namespace vanch {
+
+static uint8_t byteSum(const std::span<const uint8_t> data) {
+  uint8_t sum = 0;
+  for (const auto byte : data) sum += byte;
+  return sum;
+}
+
+FrameError FrameDecoder::validate(const std::span<const uint8_t> frame) {
+  if (frame.size() < k_minFrameSize) return FrameError::Truncated;
+  if (!isKnownHeader(frame[0])) return FrameError::BadHeader;
+  if (frameSize(frame) != frame.size()) return FrameError::BadLength;
+  if (byteSum(frame) != 0) return FrameError::BadChecksum;
+  return FrameError::None;
+}
+
+FrameError FrameDecoder::probe(const std::span<const uint8_t> data) {
+  if (data.size() < 3) return FrameError::Truncated;
+
+  const auto size = frameSize(data);
+
+  if (size < k_minFrameSize || size > m_maxFrameSize) {
+    ++m_stats.badLength;
+    return FrameError::BadLength;
+  }
+
+  if (data.size() < size) return FrameError::Truncated;
+
+  if (byteSum(data.first(size)) != 0) {
+    ++m_stats.badChecksum;
+    return FrameError::BadChecksum;
+  }
+
+  return FrameError::None;
+}
+
+}  // namespace vanch
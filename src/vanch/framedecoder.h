@@ -0,0 +1,104 @@
+#pragma once
+
+#include "vanch/message.h"
+
+namespace vanch {
+
+enum class FrameError : uint8_t {
+  None,
+  Truncated,
+  BadHeader,
+  BadLength,
+  BadChecksum,
+};
+
+struct FrameDecoderStats {
+  uint64_t frames{0};
+  uint64_t droppedBytes{0};
+  uint64_t badLength{0};
+  uint64_t badChecksum{0};
+};
+
+// Incremental decoder for byte-stream transports. Accepts arbitrary chunks, resynchronises on known header bytes
+// and emits only frames whose length field and checksum are valid. Frames that lie entirely inside the fed chunk
+// are handed out as views into it; only a frame straddling two chunks is buffered.
+class FrameDecoder {
+ public:
+  explicit FrameDecoder(size_t maxFrameSize = k_maxFrameSize) : m_maxFrameSize(maxFrameSize) {}
+
+  // Checks that the data is exactly one well-formed frame.
+  static FrameError validate(std::span<const uint8_t> frame);
+
+  template <typename Handler>
+  void feed(const std::span<const uint8_t> chunk, Handler&& handler) {
+    if (m_pending.empty()) {
+      const auto consumed = scan(chunk, handler, false);
+      m_pending.assign(chunk.begin() + static_cast<ptrdiff_t>(consumed), chunk.end());
+      return;
+    }
+
+    m_pending.insert(m_pending.end(), chunk.begin(), chunk.end());
+    const auto consumed = scan(m_pending, handler, false);
+    m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<ptrdiff_t>(consumed));
+  }
+
+  // Decodes a self-contained chunk such as a UDP datagram. Nothing is carried over, so a header whose frame would
+  // extend past the end is treated as noise and scanning resumes at the next byte.
+  template <typename Handler>
+  void feedDatagram(const std::span<const uint8_t> datagram, Handler&& handler) {
+    scan(datagram, handler, true);
+  }
+
+  // Drops a partially received frame, e.g. after the transport reconnects.
+  void reset() { m_pending.clear(); }
+
+  [[nodiscard]] size_t getPendingSize() const { return m_pending.size(); }
+
+  [[nodiscard]] const FrameDecoderStats& getStats() const { return m_stats; }
+
+ private:
+  // Emits every complete frame in data and returns the number of bytes that no longer need to be kept. When the data
+  // is final, a truncated frame is skipped like any other malformed one.
+  template <typename Handler>
+  size_t scan(const std::span<const uint8_t> data, Handler& handler, const bool isFinal) {
+    size_t pos = 0;
+
+    while (pos < data.size()) {
+      if (!isKnownHeader(data[pos])) {
+        ++pos;
+        ++m_stats.droppedBytes;
+        continue;
+      }
+
+      const auto status = probe(data.subspan(pos));
+
+      if (status == FrameError::Truncated && !isFinal) break;
+
+      if (status != FrameError::None) {
+        ++pos;
+        ++m_stats.droppedBytes;
+        continue;
+      }
+
+      const auto size = frameSize(data.subspan(pos));
+      ++m_stats.frames;
+      handler(data.subspan(pos, size));
+      pos += size;
+    }
+
+    return pos;
+  }
+
+  // Classifies the frame starting at data[0] without requiring it to be complete.
+  FrameError probe(std::span<const uint8_t> data);
+
+  static size_t frameSize(const std::span<const uint8_t> data) {
+    return 3 + (static_cast<size_t>(data[1]) << 8 | data[2]);
+  }
+
+  size_t m_maxFrameSize;
+  std::vector<uint8_t> m_pending;
+  FrameDecoderStats m_stats;
+};
+
+}  // namespace vanch
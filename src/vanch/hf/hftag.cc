@@ -0,0 +1,173 @@
+#include "hftag.h"
+
+#include "vanch/messageregistry.h"
+
+namespace vanch {
+
+namespace {
+
+// Parameters of a frame, without its header and checksum
+constexpr size_t k_maxFrameParameters = k_maxFrameSize - k_minFrameSize;
+
+template <typename Cmd>
+std::shared_ptr<Cmd> makeCommand(const HfTag& tag) {
+  auto command = std::make_shared<Cmd>();
+  command->uidLength = static_cast<uint8_t>(tag.uid.size());
+  command->uid = tag.uid;
+  return command;
+}
+
+template <typename Ret>
+HfResult makeResult(const RequestResult<Ret>& result) {
+  return {.status = result.status, .errorCode = result.errorCode, .attempts = result.attempts, .data = {}};
+}
+
+const HfResult k_selected{.status = RequestStatus::Ok, .errorCode = 0xFF, .attempts = 0, .data = {}};
+
+}  // namespace
+
+const char* getHfProtocolName(const HfProtocol protocol) {
+  switch (protocol) {
+    case HfProtocol::Iso15693:
+      return "ISO15693";
+    case HfProtocol::Iso15693Sized:
+      return "ISO15693 (block size)";
+    case HfProtocol::Iso14443A:
+      return "ISO14443A";
+  }
+  return "Unknown";
+}
+
+size_t HfTag::getRunEnd(const size_t block) const {
+  const auto end = std::min(blockCount, k_maxHfBlocks);
+  if (!hasSectors()) return end;
+  return std::min(end, (block / sectorBlocks + 1) * sectorBlocks);
+}
+
+size_t HfTag::getMaxWriteBlocks() const {
+  // UID length and UID, start block and block count, and the block size of the sized command set
+  const auto fixed = 1 + uid.size() + 2 + (protocol == HfProtocol::Iso15693Sized ? 1 : 0);
+  if (fixed >= k_maxFrameParameters || getBlockSize() == 0) return 0;
+  return std::min((k_maxFrameParameters - fixed) / getBlockSize(), k_maxHfBlocks - 1);
+}
+
+size_t HfTag::getMaxReadBlocks() const {
+  // The return carries nothing but the data
+  if (getBlockSize() == 0) return 0;
+  return std::min(k_maxFrameParameters / getBlockSize(), k_maxHfBlocks - 1);
+}
+
+std::vector<TagChunk> planTagChunks(const HfTag& tag, const size_t firstBlock, const size_t blockCount,
+                                    const size_t maxBlocks) {
+  std::vector<TagChunk> chunks;
+  if (maxBlocks == 0) return chunks;
+
+  const auto end = firstBlock + blockCount;
+  for (auto block = firstBlock; block < end;) {
+    const auto runEnd = std::min(tag.getRunEnd(block), end);
+    if (runEnd <= block) break;
+
+    const auto numBlocks = std::min(maxBlocks, runEnd - block);
+    chunks.push_back({.startBlock = block, .numBlocks = numBlocks});
+    block += numBlocks;
+  }
+
+  return chunks;
+}
+
+std::string_view describeFailure(const TagChunk& chunk) {
+  if (chunk.status == RequestStatus::DeviceError) return MessageRegistry::getErrorMessage(chunk.errorCode);
+  return getRequestStatusName(chunk.status);
+}
+
+RequestOptions makeHfRequestOptions(const std::chrono::milliseconds timeout) {
+  return {
+      .timeout = timeout,
+      .retries = 0,
+      .priority = CommandPriority::Bulk,
+      .waitForSpace = true,
+  };
+}
+
+asio::awaitable<HfResult> readBlocks(ReaderSession& session, const HfTag& tag, const size_t startBlock,
+                                     const size_t numBlocks, const RequestOptions options) {
+  const auto read = [&]<typename Cmd>(std::shared_ptr<Cmd> command) -> asio::awaitable<HfResult> {
+    command->startBlock = static_cast<uint8_t>(startBlock);
+    command->numBlocks = static_cast<uint8_t>(numBlocks);
+
+    const auto result = co_await session.request(std::move(command), options);
+    auto hfResult = makeResult(result);
+    if (result.ok()) hfResult.data = result.response->tagData;
+    co_return hfResult;
+  };
+
+  switch (tag.protocol) {
+    case HfProtocol::Iso15693:
+      co_return co_await read(makeCommand<CmdRead15693Tag>(tag));
+    case HfProtocol::Iso15693Sized: {
+      auto command = makeCommand<CmdReadISO15693Tag>(tag);
+      command->blockSize = tag.blockSize;
+      co_return co_await read(std::move(command));
+    }
+    case HfProtocol::Iso14443A:
+      co_return co_await read(makeCommand<CmdRead14443ATag>(tag));
+  }
+
+  co_return HfResult{};
+}
+
+asio::awaitable<HfResult> writeBlocks(ReaderSession& session, const HfTag& tag, const size_t startBlock,
+                                      const std::span<const uint8_t> data, const RequestOptions options) {
+  const auto write = [&]<typename Cmd>(std::shared_ptr<Cmd> command) -> asio::awaitable<HfResult> {
+    command->startBlock = static_cast<uint8_t>(startBlock);
+    command->numBlocks = static_cast<uint8_t>(data.size() / tag.getBlockSize());
+    command->writeData.assign(data.begin(), data.end());
+
+    co_return makeResult(co_await session.request(std::move(command), options));
+  };
+
+  switch (tag.protocol) {
+    case HfProtocol::Iso15693:
+      co_return co_await write(makeCommand<CmdWrite15693MultipleBlocks>(tag));
+    case HfProtocol::Iso15693Sized: {
+      auto command = makeCommand<CmdWriteISO15693Tag>(tag);
+      command->blockSize = tag.blockSize;
+      co_return co_await write(std::move(command));
+    }
+    case HfProtocol::Iso14443A:
+      co_return co_await write(makeCommand<CmdWrite14443AMultipleBlocks>(tag));
+  }
+
+  co_return HfResult{};
+}
+
+asio::awaitable<HfResult> selectSector(ReaderSession& session, const HfTag& tag, const uint8_t sector,
+                                       const RequestOptions options) {
+  auto command = makeCommand<CmdSelect14443ASector>(tag);
+  command->sectorNumber = sector;
+
+  co_return makeResult(co_await session.request(std::move(command), options));
+}
+
+SectorSelector::SectorSelector(ReaderSession& session, const HfTag& tag, const RequestOptions& options)
+    : m_session(session), m_tag(tag), m_options(options) {
+  m_results.fill(k_selected);
+}
+
+asio::awaitable<void> SectorSelector::select(TaskGroup& group, const size_t block) {
+  if (!m_tag.hasSectors()) co_return;
+
+  const auto sector = m_tag.getSector(block);
+  if (m_selected == sector) co_return;
+
+  m_selected = sector;
+  co_await group.launch([this, sector]() -> asio::awaitable<void> {
+    m_results[sector] = co_await selectSector(m_session, m_tag, sector, m_options);
+  });
+}
+
+const HfResult& SectorSelector::getResult(const size_t block) const {
+  return m_tag.hasSectors() ? m_results[m_tag.getSector(block)] : k_selected;
+}
+
+}  // namespace vanch
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "vanch/readersession.h"
+#include "vanch/taskgroup.h"
+
+namespace vanch {
+
+// Command sets for block access to HF tags
+enum class HfProtocol : uint8_t {
+  Iso15693,       // Read15693Tag and Write15693MultipleBlocks with 4-byte blocks
+  Iso15693Sized,  // ReadISO15693Tag and WriteISO15693Tag with the tag's own block size
+  Iso14443A,      // Read14443ATag and Write14443AMultipleBlocks with 4-byte blocks
+};
+
+const char* getHfProtocolName(HfProtocol protocol);
+
+// Block addresses are a single byte
+inline constexpr size_t k_maxHfBlocks = 256;
+
+// Device errors the engines react to
+inline constexpr uint8_t k_hfAccessRangeError = 0x1D;
+inline constexpr uint8_t k_hfReadLengthError = 0x1F;
+
+// Addressing and memory layout of one HF tag in the field.
+struct HfTag {
+  HfProtocol protocol{HfProtocol::Iso15693};
+  std::vector<uint8_t> uid;
+  uint8_t blockSize{4};  // Only used by Iso15693Sized; the other command sets always transfer 4-byte blocks
+  size_t blockCount{k_maxHfBlocks};
+
+  // Blocks per sector on MIFARE-style 14443A tags, whose sector must be selected before any of its blocks are
+  // accessed, or 0. Block addresses stay absolute either way.
+  size_t sectorBlocks{0};
+
+  [[nodiscard]] size_t getBlockSize() const { return protocol == HfProtocol::Iso15693Sized ? blockSize : 4; }
+
+  [[nodiscard]] size_t getSize() const { return blockCount * getBlockSize(); }
+
+  [[nodiscard]] bool hasSectors() const { return protocol == HfProtocol::Iso14443A && sectorBlocks > 0; }
+
+  [[nodiscard]] uint8_t getSector(const size_t block) const { return static_cast<uint8_t>(block / sectorBlocks); }
+
+  // One past the last block a transfer starting at block may reach without leaving its sector or the tag
+  [[nodiscard]] size_t getRunEnd(size_t block) const;
+
+  // Most blocks one write or read frame can carry, from the datagram size and the one-byte block count
+  [[nodiscard]] size_t getMaxWriteBlocks() const;
+
+  [[nodiscard]] size_t getMaxReadBlocks() const;
+};
+
+// Outcome of a single block command
+struct HfResult {
+  RequestStatus status{RequestStatus::Cancelled};
+  uint8_t errorCode{0xFF};    // Set when status is DeviceError
+  uint8_t attempts{0};
+  std::vector<uint8_t> data;  // Blocks read, when status is Ok
+
+  [[nodiscard]] bool ok() const { return status == RequestStatus::Ok; }
+};
+
+// One frame's worth of consecutive blocks
+struct TagChunk {
+  size_t startBlock{0};
+  size_t numBlocks{0};
+  RequestStatus status{RequestStatus::Pending};
+  uint8_t errorCode{0xFF};  // Set when status is DeviceError
+  uint8_t attempts{0};
+};
+
+// Splits blockCount blocks from firstBlock into chunks of at most maxBlocks that do not cross a sector.
+std::vector<TagChunk> planTagChunks(const HfTag& tag, size_t firstBlock, size_t blockCount, size_t maxBlocks);
+
+// The device error's description or the request status
+std::string_view describeFailure(const TagChunk& chunk);
+
+// Bulk lane, no retries: the engines retry failed chunks themselves without holding up the rest of the pipeline
+RequestOptions makeHfRequestOptions(std::chrono::milliseconds timeout);
+
+// Reads numBlocks blocks with the read command of the tag's protocol. Does not select a sector.
+asio::awaitable<HfResult> readBlocks(ReaderSession& session, const HfTag& tag, size_t startBlock, size_t numBlocks,
+                                     RequestOptions options);
+
+// Writes whole blocks with the multi-block write command of the tag's protocol. Does not select a sector.
+asio::awaitable<HfResult> writeBlocks(ReaderSession& session, const HfTag& tag, size_t startBlock,
+                                      std::span<const uint8_t> data, RequestOptions options);
+
+asio::awaitable<HfResult> selectSector(ReaderSession& session, const HfTag& tag, uint8_t sector,
+                                       RequestOptions options);
+
+// Launches sector selections into a task group ahead of the chunks that need them, and remembers how each one went
+// so the chunks of a sector that could not be selected count as failed even if the reader accepted them.
+class SectorSelector {
+ public:
+  SectorSelector(ReaderSession& session, const HfTag& tag, const RequestOptions& options);
+
+  // Selects the sector of the block unless the previous selection already did. Does nothing on tags without sectors.
+  asio::awaitable<void> select(TaskGroup& group, size_t block);
+
+  // Outcome of the latest selection of the block's sector; Ok if it needed none
+  [[nodiscard]] const HfResult& getResult(size_t block) const;
+
+ private:
+  ReaderSession& m_session;
+  const HfTag& m_tag;
+  RequestOptions m_options;
+  std::optional<uint8_t> m_selected;
+  std::array<HfResult, k_maxHfBlocks> m_results;
+};
+
+}  // namespace vanch
@@ -0,0 +1,198 @@
+#include "tagdumper.h"
+
+#include <fmt/format.h>
+
+namespace vanch {
+
+TagDumper::TagDumper(std::shared_ptr<ReaderSession> session) : Loggable("TagDumper"), m_session(std::move(session)) {}
+
+asio::awaitable<TagDumpResult> TagDumper::dump(HfTag tag, const TagDumpOptions options) {
+  TaskGroup group(co_await asio::this_coro::executor, options.pipelineDepth);
+  co_return co_await co_spawn(group.getStrand(), run(group, std::move(tag), options), asio::use_awaitable);
+}
+
+asio::awaitable<std::optional<size_t>> TagDumper::discoverBlockCount(const HfTag& tag,
+                                                                     const std::chrono::milliseconds timeout) {
+  const auto request = makeHfRequestOptions(timeout);
+
+  // Whether the block exists, or nothing if the reader gave no clear answer
+  const auto probe = [&](const size_t block) -> asio::awaitable<std::optional<bool>> {
+    TagChunk chunk{.startBlock = block, .numBlocks = 1};
+
+    HfResult result;
+    if (tag.hasSectors()) result = co_await selectSector(*m_session, tag, tag.getSector(block), request);
+    if (!tag.hasSectors() || result.ok()) result = co_await readBlocks(*m_session, tag, block, 1, request);
+
+    if (result.ok()) co_return true;
+    if (result.status == RequestStatus::DeviceError && result.errorCode == k_hfAccessRangeError) co_return false;
+
+    chunk.status = result.status;
+    chunk.errorCode = result.errorCode;
+    logger->warn("Probing block {} failed: {}", block, describeFailure(chunk));
+    co_return std::nullopt;
+  };
+
+  // The block count lies in [low, high]
+  size_t low = 0;
+  size_t high = std::min(tag.blockCount, k_maxHfBlocks);
+
+  while (low < high) {
+    const auto count = low + (high - low + 1) / 2;
+    const auto exists = co_await probe(count - 1);
+    if (!exists) co_return std::nullopt;
+
+    if (*exists) {
+      low = count;
+    } else {
+      high = count - 1;
+    }
+  }
+
+  co_return low;
+}
+
+asio::awaitable<TagDumpResult> TagDumper::run(TaskGroup& group, HfTag tag, const TagDumpOptions& options) {
+  TagDumpResult result;
+  const auto started = std::chrono::steady_clock::now();
+  const auto blockSize = tag.getBlockSize();
+
+  if (tag.uid.size() > std::numeric_limits<uint8_t>::max()) {
+    result.error = "UID is too long";
+  } else if (blockSize == 0 || tag.getMaxReadBlocks() == 0) {
+    result.error = "No block fits a read frame";
+  } else if (options.discoverSize) {
+    if (const auto count = co_await discoverBlockCount(tag, options.timeout); !count) {
+      result.error = "Could not determine the size of the tag";
+    } else if (*count == 0) {
+      result.error = "The tag holds no readable block";
+    } else {
+      logger->info("Tag has {} blocks of {} bytes", *count, blockSize);
+      tag.blockCount = *count;
+    }
+  }
+
+  const auto tagBlocks = std::min(tag.blockCount, k_maxHfBlocks);
+  const auto blockCount =
+      options.blockCount > 0 ? options.blockCount : tagBlocks - std::min(options.startBlock, tagBlocks);
+
+  if (result.error.empty() && (blockCount == 0 || options.startBlock + blockCount > tagBlocks)) {
+    result.error = fmt::format("Blocks {}-{} are beyond the {} blocks of the tag", options.startBlock,
+                               options.startBlock + std::max<size_t>(blockCount, 1) - 1, tagBlocks);
+  }
+
+  if (!result.error.empty()) {
+    logger->error("Cannot dump tag: {}", result.error);
+    co_return result;
+  }
+
+  result.startBlock = options.startBlock;
+  result.blockCount = blockCount;
+  result.image.assign(blockCount * blockSize, 0);
+
+  auto limit = options.maxBlocksPerRead > 0 ? std::min(options.maxBlocksPerRead, tag.getMaxReadBlocks())
+                                            : tag.getMaxReadBlocks();
+  auto pending = planTagChunks(tag, options.startBlock, blockCount, limit);
+  std::vector<TagChunk> again;
+
+  for (bool first = true; !pending.empty(); first = false) {
+    if (!first) result.rereads += pending.size();
+
+    co_await readPass(group, tag, options, pending, result);
+
+    again.clear();
+    for (const auto& chunk : pending) {
+      const bool isDeviceError = chunk.status == RequestStatus::DeviceError;
+
+      if (isDeviceError && chunk.errorCode == k_hfReadLengthError && chunk.numBlocks > 1) {
+        if (chunk.numBlocks / 2 < limit) {
+          limit = chunk.numBlocks / 2;
+          logger->info("Reader rejected a read of {} blocks, continuing with {}", chunk.numBlocks, limit);
+        }
+        again.push_back({.startBlock = chunk.startBlock, .numBlocks = chunk.numBlocks});
+      } else if (chunk.status == RequestStatus::Ok || (isDeviceError && chunk.errorCode == k_hfAccessRangeError) ||
+                 chunk.attempts >= std::max<uint8_t>(options.readAttempts, 1)) {
+        result.chunks.push_back(chunk);
+      } else {
+        again.push_back(chunk);
+      }
+    }
+
+    // Everything read again is cut to the current limit, keeping the attempts of the chunks it came from
+    pending.clear();
+    for (const auto& chunk : again) {
+      for (auto part : planTagChunks(tag, chunk.startBlock, chunk.numBlocks, limit)) {
+        part.attempts = chunk.attempts;
+        pending.push_back(part);
+      }
+    }
+  }
+
+  std::ranges::sort(result.chunks, {}, &TagChunk::startBlock);
+
+  for (const auto& chunk : result.chunks) {
+    if (chunk.status == RequestStatus::Ok) continue;
+
+    if (result.unreadBlocks == 0) {
+      logger->warn("Could not read blocks {}-{}: {}", chunk.startBlock, chunk.startBlock + chunk.numBlocks - 1,
+                   describeFailure(chunk));
+    }
+    result.unreadBlocks += chunk.numBlocks;
+  }
+
+  result.ok = result.unreadBlocks == 0;
+  result.maxBlocksPerRead = limit;
+  result.elapsed = std::chrono::steady_clock::now() - started;
+
+  logger->info("Read {} of {} blocks in {} chunks ({} reread) in {} ms", blockCount - result.unreadBlocks, blockCount,
+               result.chunks.size(), result.rereads,
+               std::chrono::duration_cast<std::chrono::milliseconds>(result.elapsed).count());
+
+  co_return result;
+}
+
+asio::awaitable<void> TagDumper::readPass(TaskGroup& group, const HfTag& tag, const TagDumpOptions& options,
+                                          std::vector<TagChunk>& pending, TagDumpResult& result) {
+  const auto request = makeHfRequestOptions(options.timeout);
+  const auto blockSize = tag.getBlockSize();
+  SectorSelector selector(*m_session, tag, request);
+  std::vector<std::vector<uint8_t>> data(pending.size());
+
+  for (size_t i = 0; i < pending.size(); ++i) {
+    co_await selector.select(group, pending[i].startBlock);
+    co_await group.launch([this, &tag, &chunk = pending[i], &out = data[i], blockSize,
+                           request]() -> asio::awaitable<void> {
+      auto read = co_await readBlocks(*m_session, tag, chunk.startBlock, chunk.numBlocks, request);
+      chunk.status = read.status;
+      chunk.errorCode = read.errorCode;
+      ++chunk.attempts;
+
+      // Some readers cut a read to their limit instead of rejecting it, which calls for smaller chunks just the same
+      if (read.ok() && read.data.size() != chunk.numBlocks * blockSize) {
+        chunk.status = RequestStatus::DeviceError;
+        chunk.errorCode = k_hfReadLengthError;
+      }
+
+      out = std::move(read.data);
+    });
+  }
+
+  co_await group.wait();
+
+  // Contents are only taken once the sector selection is known to have worked
+  for (size_t i = 0; i < pending.size(); ++i) {
+    auto& chunk = pending[i];
+
+    if (const auto& selected = selector.getResult(chunk.startBlock); !selected.ok()) {
+      if (chunk.status == RequestStatus::Ok) {
+        chunk.status = selected.status;
+        chunk.errorCode = selected.errorCode;
+      }
+      continue;
+    }
+
+    if (chunk.status != RequestStatus::Ok) continue;
+    std::ranges::copy(data[i], result.image.begin() + (chunk.startBlock - result.startBlock) * blockSize);
+  }
+}
+
+}  // namespace vanch
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "hftag.h"
+#include "krog/util/loggable.h"
+
+namespace vanch {
+
+struct TagDumpOptions {
+  size_t startBlock{0};
+  size_t blockCount{0};         // 0 for every block up to the end of the tag
+  bool discoverSize{false};     // Probe how many blocks the tag has instead of trusting HfTag::blockCount
+  size_t maxBlocksPerRead{0};   // Initial chunk size, 0 for as many as a frame carries
+  size_t pipelineDepth{8};      // Reads awaiting their response at once
+  uint8_t readAttempts{3};      // Per chunk; splitting a chunk the reader found too long does not use one up
+  std::chrono::milliseconds timeout{1000};
+};
+
+struct TagDumpResult {
+  bool ok{false};     // Every block of the range read
+  std::string error;  // Why the dump could not start
+
+  size_t startBlock{0};
+  size_t blockCount{0};        // Discovered if requested
+  std::vector<uint8_t> image;  // The whole range; blocks that could not be read are left zero
+  std::vector<TagChunk> chunks;  // Final reads in address order, including the failed ones
+  size_t unreadBlocks{0};
+
+  size_t maxBlocksPerRead{0};  // Largest chunk the reader accepted
+  size_t rereads{0};           // Chunks read again after a failure or a split
+
+  std::chrono::steady_clock::duration elapsed{};
+};
+
+// Reads a range of HF tag memory, by default all of it, into one contiguous image. The range is split into chunks
+// as large as a frame carries and up to the pipeline depth of them await their response at once, each run of chunks
+// in one sector preceded by its selection, so a dump takes a few round trips rather than one per block.
+//
+// Readers cap the read length below what fits a datagram. A chunk the reader rejects with 0x1F is split in halves,
+// and the smaller size is kept for the rest of the dump, so the engine settles on the largest size the reader
+// accepts. Other failures are retried on the following passes; only the failed chunks are read again.
+class TagDumper final : kr::Loggable {
+ public:
+  explicit TagDumper(std::shared_ptr<ReaderSession> session);
+
+  asio::awaitable<TagDumpResult> dump(HfTag tag, TagDumpOptions options = {});
+
+  // Number of blocks the tag holds, found by a binary search with single-block reads up to HfTag::blockCount. Out
+  // of range errors mark the end of the memory; anything else, such as a timeout, fails the search.
+  asio::awaitable<std::optional<size_t>> discoverBlockCount(const HfTag& tag, std::chrono::milliseconds timeout);
+
+ private:
+  asio::awaitable<TagDumpResult> run(TaskGroup& group, HfTag tag, const TagDumpOptions& options);
+
+  // Reads every pending chunk into the image and marks how it went.
+  asio::awaitable<void> readPass(TaskGroup& group, const HfTag& tag, const TagDumpOptions& options,
+                                 std::vector<TagChunk>& pending, TagDumpResult& result);
+
+  std::shared_ptr<ReaderSession> m_session;
+};
+
+}  // namespace vanch
@@ -0,0 +1,165 @@
+#include "tagprogrammer.h"
+
+#include <fmt/format.h>
+
+namespace vanch {
+
+TagProgrammer::TagProgrammer(std::shared_ptr<ReaderSession> session)
+    : Loggable("TagProgrammer"), m_session(session), m_dumper(std::move(session)) {}
+
+asio::awaitable<TagProgramResult> TagProgrammer::program(HfTag tag, std::vector<uint8_t> image,
+                                                         const TagProgramOptions options) {
+  const auto blockSize = tag.getBlockSize();
+  if (blockSize > 0 && image.size() % blockSize != 0) image.resize(image.size() + blockSize - image.size() % blockSize);
+
+  TaskGroup group(co_await asio::this_coro::executor, options.pipelineDepth);
+  co_return co_await co_spawn(group.getStrand(), run(group, tag, image, options), asio::use_awaitable);
+}
+
+asio::awaitable<TagProgramResult> TagProgrammer::run(TaskGroup& group, const HfTag& tag,
+                                                     const std::span<const uint8_t> image,
+                                                     const TagProgramOptions& options) {
+  TagProgramResult result;
+
+  const auto blockSize = tag.getBlockSize();
+  const auto imageBlocks = blockSize > 0 ? image.size() / blockSize : 0;
+  const auto maxBlocks = options.maxBlocksPerWrite > 0
+                             ? std::min(options.maxBlocksPerWrite, tag.getMaxWriteBlocks())
+                             : tag.getMaxWriteBlocks();
+
+  if (tag.uid.size() > std::numeric_limits<uint8_t>::max()) {
+    result.error = "UID is too long";
+  } else if (blockSize == 0 || maxBlocks == 0) {
+    result.error = "No block fits a write frame";
+  } else if (imageBlocks == 0) {
+    result.error = "Image is empty";
+  } else if (options.startBlock + imageBlocks > std::min(tag.blockCount, k_maxHfBlocks)) {
+    result.error = fmt::format("{} blocks from block {} exceed the {} blocks of the tag", imageBlocks,
+                               options.startBlock, std::min(tag.blockCount, k_maxHfBlocks));
+  }
+
+  if (!result.error.empty()) {
+    logger->error("Cannot program tag: {}", result.error);
+    co_return result;
+  }
+
+  result.chunks = planTagChunks(tag, options.startBlock, imageBlocks, maxBlocks);
+
+  const auto writeStart = std::chrono::steady_clock::now();
+
+  for (uint8_t pass = 0; pass < std::max<uint8_t>(options.writeAttempts, 1); ++pass) {
+    const auto attempted = co_await writePass(group, tag, image, options, result.chunks);
+    if (attempted == 0) break;
+    if (pass > 0) result.rewrites += attempted;
+  }
+
+  result.writeTime = std::chrono::steady_clock::now() - writeStart;
+  result.failedChunks =
+      std::ranges::count_if(result.chunks, [](const TagChunk& chunk) { return chunk.status != RequestStatus::Ok; });
+
+  if (result.failedChunks > 0) {
+    const auto& failed = *std::ranges::find_if(
+        result.chunks, [](const TagChunk& chunk) { return chunk.status != RequestStatus::Ok; });
+    logger->warn("{} of {} chunks could not be written, first at block {}: {}", result.failedChunks,
+                 result.chunks.size(), failed.startBlock, describeFailure(failed));
+    co_return result;
+  }
+
+  if (options.verify) {
+    const auto verifyStart = std::chrono::steady_clock::now();
+    co_await verify(tag, image, options, result);
+    result.verifyTime = std::chrono::steady_clock::now() - verifyStart;
+  }
+
+  result.ok = !options.verify || result.verified;
+
+  logger->info("Wrote {} bytes in {} chunks ({} rewritten) in {} ms{}", image.size(), result.chunks.size(),
+               result.rewrites, std::chrono::duration_cast<std::chrono::milliseconds>(result.writeTime).count(),
+               options.verify ? fmt::format(", verification {} in {} ms", result.verified ? "passed" : "failed",
+                                            std::chrono::duration_cast<std::chrono::milliseconds>(result.verifyTime)
+                                                .count())
+                              : "");
+
+  co_return result;
+}
+
+asio::awaitable<size_t> TagProgrammer::writePass(TaskGroup& group, const HfTag& tag,
+                                                 const std::span<const uint8_t> image,
+                                                 const TagProgramOptions& options, std::vector<TagChunk>& chunks) {
+  const auto request = makeHfRequestOptions(options.timeout);
+  const auto blockSize = tag.getBlockSize();
+  SectorSelector selector(*m_session, tag, request);
+
+  std::vector<TagChunk*> pending;
+  for (auto& chunk : chunks) {
+    if (chunk.status != RequestStatus::Ok) pending.push_back(&chunk);
+  }
+
+  for (auto* chunk : pending) {
+    co_await selector.select(group, chunk->startBlock);
+
+    const auto data = image.subspan((chunk->startBlock - options.startBlock) * blockSize, chunk->numBlocks * blockSize);
+    co_await group.launch([this, &tag, chunk, data, request]() -> asio::awaitable<void> {
+      const auto written = co_await writeBlocks(*m_session, tag, chunk->startBlock, data, request);
+      chunk->status = written.status;
+      chunk->errorCode = written.errorCode;
+      ++chunk->attempts;
+    });
+  }
+
+  co_await group.wait();
+
+  for (auto* chunk : pending) {
+    const auto& selected = selector.getResult(chunk->startBlock);
+    if (!selected.ok() && chunk->status == RequestStatus::Ok) {
+      chunk->status = selected.status;
+      chunk->errorCode = selected.errorCode;
+    }
+  }
+
+  co_return pending.size();
+}
+
+asio::awaitable<void> TagProgrammer::verify(const HfTag& tag, const std::span<const uint8_t> image,
+                                            const TagProgramOptions& options, TagProgramResult& result) {
+  const auto blockSize = tag.getBlockSize();
+  const TagDumpOptions readOptions{
+      .startBlock = options.startBlock,
+      .blockCount = image.size() / blockSize,
+      .maxBlocksPerRead = options.maxBlocksPerRead,
+      .pipelineDepth = options.pipelineDepth,
+      .readAttempts = options.writeAttempts,
+      .timeout = options.timeout,
+  };
+
+  const auto readBack = co_await m_dumper.dump(tag, readOptions);
+
+  if (!readBack.error.empty()) {
+    result.unreadBlocks = image.size() / blockSize;
+    co_return;
+  }
+
+  result.unreadBlocks = readBack.unreadBlocks;
+
+  for (const auto& chunk : readBack.chunks) {
+    if (chunk.status != RequestStatus::Ok) continue;
+
+    for (auto block = chunk.startBlock; block < chunk.startBlock + chunk.numBlocks; ++block) {
+      const auto offset = (block - options.startBlock) * blockSize;
+      if (std::equal(image.begin() + offset, image.begin() + offset + blockSize, readBack.image.begin() + offset)) {
+        continue;
+      }
+
+      ++result.mismatchedBlocks;
+      if (!result.firstMismatch) result.firstMismatch = block;
+    }
+  }
+
+  if (result.mismatchedBlocks > 0) {
+    logger->warn("{} blocks differ from the image, first at block {}", result.mismatchedBlocks, *result.firstMismatch);
+  }
+
+  result.verified = result.unreadBlocks == 0 && result.mismatchedBlocks == 0;
+}
+
+}  // namespace vanch
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "hftag.h"
+#include "krog/util/loggable.h"
+#include "tagdumper.h"
+
+namespace vanch {
+
+struct TagProgramOptions {
+  size_t startBlock{0};
+  size_t maxBlocksPerWrite{0};  // 0 for as many as a frame carries
+  size_t maxBlocksPerRead{0};   // Initial read-back chunk size, 0 for as many as a frame carries
+  size_t pipelineDepth{8};      // Chunks awaiting their response at once; at most the session's request window helps
+  uint8_t writeAttempts{3};     // Passes over the image; each one after the first rewrites only the failed chunks
+  bool verify{true};
+  std::chrono::milliseconds timeout{1000};
+};
+
+struct TagProgramResult {
+  bool ok{false};  // Every chunk written, and read back intact if verification was requested
+  std::string error;  // Why programming could not start
+
+  std::vector<TagChunk> chunks;  // Write frames in address order
+  size_t rewrites{0};            // Chunk writes repeated after a failure
+  size_t failedChunks{0};
+
+  bool verified{false};
+  size_t unreadBlocks{0};      // Blocks the verification could not read back
+  size_t mismatchedBlocks{0};  // Blocks read back with different contents
+  std::optional<size_t> firstMismatch;  // Block address
+
+  std::chrono::steady_clock::duration writeTime{};
+  std::chrono::steady_clock::duration verifyTime{};
+};
+
+// Writes a byte image to an HF tag. The image is split into the fewest frames the datagram size, the one-byte block
+// count and the sectors of the tag allow, and the frames are pipelined: up to the pipeline depth of them await their
+// response at once instead of one round trip per frame. Failed chunks are rewritten on the following passes while
+// the ones that succeeded are left alone, and the written range is finally read back by a TagDumper and compared.
+//
+// On tags with sectors, each run of chunks in one sector is preceded by a sector selection. All commands use the
+// bulk lane of the session's command queue, so they keep their order on the way to the reader.
+class TagProgrammer final : kr::Loggable {
+ public:
+  explicit TagProgrammer(std::shared_ptr<ReaderSession> session);
+
+  // A partial last block is padded with zeros.
+  asio::awaitable<TagProgramResult> program(HfTag tag, std::vector<uint8_t> image, TagProgramOptions options = {});
+
+ private:
+  asio::awaitable<TagProgramResult> run(TaskGroup& group, const HfTag& tag, std::span<const uint8_t> image,
+                                        const TagProgramOptions& options);
+
+  // Writes every chunk that has not succeeded yet. Returns the number of chunks attempted.
+  asio::awaitable<size_t> writePass(TaskGroup& group, const HfTag& tag, std::span<const uint8_t> image,
+                                    const TagProgramOptions& options, std::vector<TagChunk>& chunks);
+
+  asio::awaitable<void> verify(const HfTag& tag, std::span<const uint8_t> image, const TagProgramOptions& options,
+                               TagProgramResult& result);
+
+  std::shared_ptr<ReaderSession> m_session;
+  TagDumper m_dumper;
+};
+
+}  // namespace vanch
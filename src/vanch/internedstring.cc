@@ -0,0 +1,49 @@
+#include "internedstring.h"
+
+namespace vanch {
+
+namespace {
+
+struct InternTable {
+  std::shared_mutex mutex;
+  std::deque<std::string> strings{std::string{}};  // A deque never moves its elements, so views stay valid
+  std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+InternTable& getTable() {
+  static InternTable table;
+  return table;
+}
+
+}  // namespace
+
+InternedString InternedString::intern(const std::string_view value) {
+  if (value.empty()) return {};
+
+  auto& table = getTable();
+
+  {
+    std::shared_lock lock(table.mutex);
+    if (const auto it = table.ids.find(value); it != table.ids.end()) return InternedString(it->second);
+  }
+
+  std::unique_lock lock(table.mutex);
+
+  // Another thread may have added it between the two locks
+  if (const auto it = table.ids.find(value); it != table.ids.end()) return InternedString(it->second);
+
+  const auto id = static_cast<uint32_t>(table.strings.size());
+  const auto& stored = table.strings.emplace_back(value);
+  table.ids.emplace(stored, id);
+
+  return InternedString(id);
+}
+
+std::string_view InternedString::view() const {
+  auto& table = getTable();
+
+  std::shared_lock lock(table.mutex);
+  return table.strings[m_id];
+}
+
+}  // namespace vanch
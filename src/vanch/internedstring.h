@@ -0,0 +1,38 @@
+#pragma once
+
+namespace vanch {
+
+// Handle to a string stored once for the lifetime of the process. Meant for values drawn from a small set that
+// repeat in every packet, such as device IDs, reader addresses and directions: interning a known value neither
+// allocates nor copies, and handles compare and hash as integers. Interned strings are never freed.
+class InternedString {
+ public:
+  InternedString() = default;
+
+  static InternedString intern(std::string_view value);
+
+  [[nodiscard]] std::string_view view() const;
+
+  // Interned strings are stored null-terminated
+  [[nodiscard]] const char* c_str() const { return view().data(); }
+
+  [[nodiscard]] std::string str() const { return std::string(view()); }
+
+  [[nodiscard]] bool empty() const { return m_id == 0; }
+
+  [[nodiscard]] uint32_t id() const { return m_id; }
+
+  friend bool operator==(InternedString lhs, InternedString rhs) { return lhs.m_id == rhs.m_id; }
+
+ private:
+  explicit InternedString(const uint32_t id) : m_id(id) {}
+
+  uint32_t m_id{0};  // 0 is the empty string
+};
+
+}  // namespace vanch
+
+template <>
+struct std::hash<vanch::InternedString> {
+  size_t operator()(const vanch::InternedString value) const noexcept { return value.id(); }
+};
@@ -0,0 +1,102 @@
+#include "journalreader.h"
+
+#include <cstring>
+
+namespace vanch {
+
+namespace {
+
+int64_t toMicroseconds(const std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+}  // namespace
+
+JournalReader::JournalReader(std::filesystem::path directory) : m_directory(std::move(directory)) {}
+
+size_t JournalReader::query(const JournalQuery& query, const Visitor& visitor) const {
+  const auto fromUs = toMicroseconds(query.from);
+  const auto toUs = toMicroseconds(query.to);
+
+  if (fromUs > toUs || query.limit == 0) return 0;
+
+  size_t visited = 0;
+
+  for (const auto sequence : journal::listSegments(m_directory)) {
+    Segment segment;
+    if (!openSegment(sequence, segment) || segment.records.empty()) continue;
+
+    // Each run of the writer starts a segment, and the clock may have stepped back in between, so every segment is
+    // checked on its own instead of stopping at the first one past the range
+    if (segment.records.back().timestampUs < fromUs || segment.records.front().timestampUs > toUs) continue;
+
+    for (auto i = seek(segment, fromUs); i < segment.records.size(); ++i) {
+      const auto& record = segment.records[i];
+      if (record.timestampUs > toUs) break;
+
+      if (query.readerIp && record.readerIp != *query.readerIp) continue;
+      if (query.antenna && record.antenna != *query.antenna) continue;
+
+      ++visited;
+      if (!visitor(record) || visited >= query.limit) return visited;
+    }
+  }
+
+  return visited;
+}
+
+std::vector<JournalRecord> JournalReader::query(const JournalQuery& query) const {
+  std::vector<JournalRecord> records;
+
+  this->query(query, [&records](const JournalRecord& record) {
+    records.push_back(record);
+    return true;
+  });
+
+  return records;
+}
+
+bool JournalReader::openSegment(const uint64_t sequence, Segment& segment) const {
+  if (!segment.file.open(journal::getSegmentPath(m_directory, sequence))) return false;
+
+  const auto data = segment.file.data();
+  if (data.size() < sizeof(JournalSegmentHeader)) return false;
+
+  JournalSegmentHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (!header.isValid()) return false;
+
+  // A trailing partial record is a write still in progress or torn by a crash
+  const auto count = (data.size() - sizeof(JournalSegmentHeader)) / sizeof(JournalRecord);
+  segment.records = {reinterpret_cast<const JournalRecord*>(data.data() + sizeof(JournalSegmentHeader)), count};
+
+  // Without its index a segment is still searchable, only with more page faults
+  if (segment.index.open(journal::getIndexPath(m_directory, sequence))) {
+    const auto index = segment.index.data();
+    segment.entries = {reinterpret_cast<const JournalIndexEntry*>(index.data()),
+                       index.size() / sizeof(JournalIndexEntry)};
+  }
+
+  return true;
+}
+
+size_t JournalReader::seek(const Segment& segment, const int64_t timestampUs) {
+  size_t begin = 0;
+  size_t end = segment.records.size();
+
+  // Narrow down to the stretch between two index entries, which only touches the pages of the small index file
+  const auto& entries = segment.entries;
+  const auto next =
+      std::ranges::lower_bound(entries, timestampUs, {}, [](const JournalIndexEntry& entry) { return entry.timestampUs; });
+
+  if (next != entries.begin()) begin = std::min<size_t>(std::prev(next)->record, end);
+  if (next != entries.end()) end = std::clamp<size_t>(next->record, begin, end);
+
+  const auto records = segment.records.subspan(begin, end - begin);
+  const auto first =
+      std::ranges::lower_bound(records, timestampUs, {}, [](const JournalRecord& record) { return record.timestampUs; });
+
+  return begin + static_cast<size_t>(first - records.begin());
+}
+
+}  // namespace vanch
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "journalrecord.h"
+#include "vanch/mappedfile.h"
+
+namespace vanch {
+
+struct JournalQuery {
+  std::chrono::system_clock::time_point from;
+  std::chrono::system_clock::time_point to;  // Inclusive
+  std::optional<uint32_t> readerIp;
+  std::optional<uint8_t> antenna;
+  size_t limit{std::numeric_limits<size_t>::max()};
+};
+
+// Scans the segments of a journal directory in place through memory mappings. A query finds the first record at or
+// after its start through the sparse index of each segment and a binary search between two index entries, then
+// walks forward until its end, so its cost depends on the number of matching records, not on the journal size.
+class JournalReader {
+ public:
+  using Visitor = std::function<bool(const JournalRecord&)>;
+
+  explicit JournalReader(std::filesystem::path directory);
+
+  // Calls visitor for matching records in time order until it returns false or the limit is reached. Returns the
+  // number of records visited.
+  size_t query(const JournalQuery& query, const Visitor& visitor) const;
+
+  [[nodiscard]] std::vector<JournalRecord> query(const JournalQuery& query) const;
+
+ private:
+  struct Segment {
+    MappedFile file;
+    MappedFile index;
+    std::span<const JournalRecord> records;
+    std::span<const JournalIndexEntry> entries;
+  };
+
+  bool openSegment(uint64_t sequence, Segment& segment) const;
+
+  // Position of the first record with a timestamp not before timestampUs
+  static size_t seek(const Segment& segment, int64_t timestampUs);
+
+  std::filesystem::path m_directory;
+};
+
+}  // namespace vanch
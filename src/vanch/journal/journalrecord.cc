@@ -0,0 +1,87 @@
+#include "journalrecord.h"
+
+#include <fmt/format.h>
+
+#include <charconv>
+
+namespace vanch {
+
+JournalRecord JournalRecord::fromReading(const StatusAutoCardReading& reading,
+                                         const std::chrono::system_clock::time_point receivedAt) {
+  JournalRecord record{};
+  record.timestampUs =
+      std::chrono::duration_cast<std::chrono::microseconds>(receivedAt.time_since_epoch()).count();
+  record.readerIp = journal::parseIpv4(reading.ipAddress.view());
+  record.readerTimestamp = reading.timestamp;
+  record.temperature = reading.temperature;
+  record.antenna = reading.antennaNumber;
+  record.rssi = reading.rssi;
+  record.tagType = reading.tagType;
+
+  const auto epc = reading.epc.bytes();
+  record.epcSize = static_cast<uint8_t>(std::min<size_t>(epc.size(), std::numeric_limits<uint8_t>::max()));
+  std::ranges::copy(epc.first(std::min(epc.size(), k_epcCapacity)), record.epc.begin());
+
+  const auto deviceId = reading.deviceId.view();
+  std::ranges::copy(deviceId.substr(0, k_deviceIdCapacity), record.deviceId.begin());
+
+  return record;
+}
+
+std::string JournalRecord::getReaderIpString() const {
+  return fmt::format("{}.{}.{}.{}", readerIp >> 24, (readerIp >> 16) & 0xFF, (readerIp >> 8) & 0xFF, readerIp & 0xFF);
+}
+
+namespace journal {
+
+std::filesystem::path getSegmentPath(const std::filesystem::path& directory, const uint64_t sequence) {
+  return directory / fmt::format("{:010}{}", sequence, k_segmentExtension);
+}
+
+std::filesystem::path getIndexPath(const std::filesystem::path& directory, const uint64_t sequence) {
+  return directory / fmt::format("{:010}{}", sequence, k_indexExtension);
+}
+
+std::vector<uint64_t> listSegments(const std::filesystem::path& directory) {
+  std::vector<uint64_t> sequences;
+
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+    const auto& path = entry.path();
+    if (path.extension() != k_segmentExtension) continue;
+
+    const auto stem = path.stem().string();
+    uint64_t sequence{};
+    const auto [ptr, parseEc] = std::from_chars(stem.data(), stem.data() + stem.size(), sequence);
+    if (parseEc == std::errc{} && ptr == stem.data() + stem.size()) sequences.push_back(sequence);
+  }
+
+  std::ranges::sort(sequences);
+  return sequences;
+}
+
+uint32_t parseIpv4(const std::string_view text) {
+  uint32_t address{};
+  const auto* pos = text.data();
+  const auto* end = text.data() + text.size();
+
+  for (int octet = 0; octet < 4; ++octet) {
+    if (octet > 0) {
+      if (pos == end || *pos != '.') return 0;
+      ++pos;
+    }
+
+    uint32_t value{};
+    const auto [ptr, ec] = std::from_chars(pos, end, value);
+    if (ec != std::errc{} || value > 255) return 0;
+
+    address = (address << 8) | value;
+    pos = ptr;
+  }
+
+  return pos == end ? address : 0;
+}
+
+}  // namespace journal
+
+}  // namespace vanch
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "vanch/statuses/status.h"
+
+namespace vanch {
+
+// One decoded tag read as stored on disk. Fixed-size records let readers address a segment as a plain array and
+// binary search it; values are stored in host byte order.
+struct JournalRecord {
+  static constexpr size_t k_epcCapacity = 32;
+  static constexpr size_t k_deviceIdCapacity = 8;
+
+  int64_t timestampUs;  // Receive time, microseconds since the Unix epoch
+  uint32_t readerIp;    // IPv4 address reported by the reader, most significant byte first
+  uint32_t readerTimestamp;
+  float temperature;
+  uint8_t antenna;
+  int8_t rssi;
+  uint8_t tagType;
+  uint8_t epcSize;  // Full EPC length; only the first k_epcCapacity bytes are kept
+  std::array<char, k_deviceIdCapacity> deviceId;  // Prefix of the device ID, zero padded
+  std::array<uint8_t, k_epcCapacity> epc;
+
+  static JournalRecord fromReading(const StatusAutoCardReading& reading,
+                                   std::chrono::system_clock::time_point receivedAt);
+
+  [[nodiscard]] std::chrono::system_clock::time_point getTime() const {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(timestampUs)));
+  }
+
+  [[nodiscard]] std::span<const uint8_t> getEpc() const {
+    return {epc.data(), std::min<size_t>(epcSize, k_epcCapacity)};
+  }
+
+  [[nodiscard]] std::string_view getDeviceId() const {
+    const std::string_view padded(deviceId.data(), deviceId.size());
+    return padded.substr(0, padded.find('\0'));
+  }
+
+  [[nodiscard]] std::string getReaderIpString() const;
+};
+
+static_assert(sizeof(JournalRecord) == 64 && std::is_trivially_copyable_v<JournalRecord>);
+
+// Every k_indexInterval records of a segment, the index file gets the timestamp of that record
+struct JournalIndexEntry {
+  int64_t timestampUs;
+  uint64_t record;
+};
+
+static_assert(sizeof(JournalIndexEntry) == 16);
+
+struct JournalSegmentHeader {
+  static constexpr uint64_t k_magic = 0x31304C4E524A5456;  // "VTJRNL01"
+  static constexpr uint32_t k_version = 1;
+
+  uint64_t magic{k_magic};
+  uint32_t version{k_version};
+  uint32_t recordSize{sizeof(JournalRecord)};
+  uint64_t sequence{0};
+  std::array<uint8_t, 40> reserved{};
+
+  [[nodiscard]] bool isValid() const {
+    return magic == k_magic && version == k_version && recordSize == sizeof(JournalRecord);
+  }
+};
+
+static_assert(sizeof(JournalSegmentHeader) == sizeof(JournalRecord));
+
+namespace journal {
+
+constexpr std::string_view k_segmentExtension = ".seg";
+constexpr std::string_view k_indexExtension = ".idx";
+constexpr uint64_t k_indexInterval = 1024;
+
+std::filesystem::path getSegmentPath(const std::filesystem::path& directory, uint64_t sequence);
+
+std::filesystem::path getIndexPath(const std::filesystem::path& directory, uint64_t sequence);
+
+// Sequence numbers of the segments in the directory, in ascending order
+std::vector<uint64_t> listSegments(const std::filesystem::path& directory);
+
+// Parses a dotted IPv4 address into the form stored in records. Returns 0 if the text is not one.
+uint32_t parseIpv4(std::string_view text);
+
+}  // namespace journal
+
+}  // namespace vanch
@@ -0,0 +1,243 @@
+#include "tagjournal.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace vanch {
+
+namespace {
+
+std::FILE* openForWriting(const std::filesystem::path& path) {
+#if defined(_WIN32)
+  return _wfopen(path.c_str(), L"wb");
+#else
+  return std::fopen(path.c_str(), "wb");
+#endif
+}
+
+bool syncFile(std::FILE* file) {
+  if (std::fflush(file) != 0) return false;
+#if defined(_WIN32)
+  return _commit(_fileno(file)) == 0;
+#elif defined(__linux__)
+  return fdatasync(fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+}  // namespace
+
+TagJournal::TagJournal() : Loggable("TagJournal") {}
+
+TagJournal::~TagJournal() { close(); }
+
+bool TagJournal::open(const TagJournalOptions& options) {
+  if (m_isOpen) return true;
+
+  m_options = options;
+
+  std::error_code ec;
+  std::filesystem::create_directories(m_options.directory, ec);
+
+  if (ec) {
+    logger->error("Failed to create journal directory {}: {}", m_options.directory.string(), ec.message());
+    return false;
+  }
+
+  // Never append to an existing segment; its tail may be torn by a crash
+  const auto segments = journal::listSegments(m_options.directory);
+  const auto sequence = segments.empty() ? 0 : segments.back() + 1;
+
+  if (!openSegment(sequence)) return false;
+
+  // The queue outlives close() because a producer may still be past its isOpen check
+  if (!m_queue) m_queue = std::make_unique<MpscQueue<JournalRecord>>(m_options.queueCapacity);
+  m_batch.reserve(k_batchSize);
+  m_stopRequested = false;
+  m_isOpen = true;
+
+  m_writer = std::thread([this] { writerLoop(); });
+
+  logger->info("Journal opened in {} at segment {}", m_options.directory.string(), sequence);
+  return true;
+}
+
+void TagJournal::close() {
+  if (!m_isOpen.exchange(false)) return;
+
+  {
+    std::lock_guard lock(m_wakeMutex);
+    m_stopRequested = true;
+  }
+  m_wake.notify_one();
+
+  if (m_writer.joinable()) m_writer.join();
+
+  closeSegment();
+}
+
+bool TagJournal::append(const JournalRecord& record) {
+  if (!m_isOpen) return false;
+
+  auto copy = record;
+  if (!m_queue->tryPush(std::move(copy))) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  m_appended.fetch_add(1, std::memory_order_relaxed);
+
+  // Only the producer that fills the queue up to the threshold wakes the writer; a missed wakeup costs one interval
+  if (m_queue->sizeApprox() == k_wakeThreshold) m_wake.notify_one();
+  return true;
+}
+
+TagJournalStats TagJournal::getStats() const {
+  return {
+      .appended = m_appended.load(std::memory_order_relaxed),
+      .dropped = m_dropped.load(std::memory_order_relaxed),
+      .written = m_written.load(std::memory_order_relaxed),
+      .syncs = m_syncs.load(std::memory_order_relaxed),
+      .writeErrors = m_writeErrors.load(std::memory_order_relaxed),
+      .segment = m_segment.load(std::memory_order_relaxed),
+  };
+}
+
+void TagJournal::writerLoop() {
+  auto nextSync = std::chrono::steady_clock::now() + m_options.syncInterval;
+
+  while (true) {
+    bool stopping{};
+
+    {
+      std::unique_lock lock(m_wakeMutex);
+      m_wake.wait_until(lock, nextSync,
+                        [this] { return m_stopRequested || m_queue->sizeApprox() >= k_wakeThreshold; });
+      stopping = m_stopRequested;
+    }
+
+    JournalRecord record{};
+    while (m_queue->tryPop(record)) {
+      m_batch.push_back(record);
+      if (m_batch.size() == k_batchSize) writeBatch();
+    }
+    writeBatch();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= nextSync || stopping) {
+      sync();
+      nextSync = now + m_options.syncInterval;
+    }
+
+    if (stopping) break;
+  }
+}
+
+bool TagJournal::openSegment(const uint64_t sequence) {
+  closeSegment();
+
+  const auto segmentPath = journal::getSegmentPath(m_options.directory, sequence);
+  const auto indexPath = journal::getIndexPath(m_options.directory, sequence);
+
+  m_segmentFile = openForWriting(segmentPath);
+  m_indexFile = openForWriting(indexPath);
+
+  if (!m_segmentFile || !m_indexFile) {
+    logger->error("Failed to create journal segment {}", segmentPath.string());
+    closeSegment();
+    return false;
+  }
+
+  JournalSegmentHeader header{};
+  header.sequence = sequence;
+
+  if (std::fwrite(&header, sizeof(header), 1, m_segmentFile) != 1) {
+    logger->error("Failed to write journal segment header to {}", segmentPath.string());
+    closeSegment();
+    return false;
+  }
+
+  m_segmentRecords = 0;
+  m_segment = sequence;
+  return true;
+}
+
+void TagJournal::closeSegment() {
+  if (m_segmentFile) {
+    syncFile(m_segmentFile);
+    std::fclose(m_segmentFile);
+    m_segmentFile = nullptr;
+  }
+
+  if (m_indexFile) {
+    syncFile(m_indexFile);
+    std::fclose(m_indexFile);
+    m_indexFile = nullptr;
+  }
+
+  m_dirty = false;
+}
+
+void TagJournal::writeBatch() {
+  if (m_batch.empty()) return;
+
+  const auto recordsPerSegment =
+      std::max<uint64_t>(1, (m_options.segmentSize - sizeof(JournalSegmentHeader)) / sizeof(JournalRecord));
+
+  size_t offset = 0;
+
+  while (offset < m_batch.size()) {
+    if (m_segmentRecords >= recordsPerSegment && !openSegment(m_segment + 1)) break;
+    if (!m_segmentFile) break;
+
+    const auto count = std::min<size_t>(recordsPerSegment - m_segmentRecords, m_batch.size() - offset);
+
+    for (size_t i = 0; i < count; ++i) {
+      auto& record = m_batch[offset + i];
+
+      // Producers race each other and the wall clock can step back, so order is enforced here
+      record.timestampUs = std::max(record.timestampUs, m_lastTimestampUs);
+      m_lastTimestampUs = record.timestampUs;
+
+      const auto index = m_segmentRecords + i;
+      if (index % journal::k_indexInterval == 0) {
+        const JournalIndexEntry entry{.timestampUs = record.timestampUs, .record = index};
+        std::fwrite(&entry, sizeof(entry), 1, m_indexFile);
+      }
+    }
+
+    const auto written = std::fwrite(m_batch.data() + offset, sizeof(JournalRecord), count, m_segmentFile);
+    m_segmentRecords += written;
+    m_written.fetch_add(written, std::memory_order_relaxed);
+    m_dirty = true;
+
+    if (written != count) {
+      logger->error("Failed to write to journal segment {}", m_segment.load());
+      break;
+    }
+
+    offset += count;
+  }
+
+  if (offset < m_batch.size()) m_writeErrors.fetch_add(m_batch.size() - offset, std::memory_order_relaxed);
+
+  m_batch.clear();
+}
+
+void TagJournal::sync() {
+  if (!m_dirty || !m_segmentFile) return;
+
+  if (!syncFile(m_segmentFile) || !syncFile(m_indexFile)) {
+    logger->error("Failed to sync journal segment {}", m_segment.load());
+    m_writeErrors.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  m_syncs.fetch_add(1, std::memory_order_relaxed);
+  m_dirty = false;
+}
+
+}  // namespace vanch
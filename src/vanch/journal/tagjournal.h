@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <thread>
+
+#include "journalrecord.h"
+#include "krog/util/loggable.h"
+#include "vanch/mpscqueue.h"
+
+namespace vanch {
+
+struct TagJournalOptions {
+  std::filesystem::path directory{"journal"};
+  uint64_t segmentSize{64 * 1024 * 1024};  // Bytes after which the writer starts a new segment
+  std::chrono::milliseconds syncInterval{250};
+  size_t queueCapacity{65536};  // Taken from the first open
+};
+
+struct TagJournalStats {
+  uint64_t appended{0};
+  uint64_t dropped{0};  // Reads lost because the writer fell behind
+  uint64_t written{0};
+  uint64_t syncs{0};
+  uint64_t writeErrors{0};
+  uint64_t segment{0};  // Sequence number of the segment being written
+};
+
+// Append-only journal of tag reads. Producers hand records to a background writer through a lock-free queue; the
+// writer appends them to the current segment in batches and syncs to disk at most once per sync interval, so a
+// burst of reads costs one write and one sync. Each open starts a new segment, and segments roll over at the size
+// limit. Timestamps are kept non-decreasing within the journal so readers can binary search them.
+class TagJournal final : kr::Loggable {
+ public:
+  TagJournal();
+
+  ~TagJournal();
+
+  TagJournal(const TagJournal&) = delete;
+
+  TagJournal& operator=(const TagJournal&) = delete;
+
+  bool open(const TagJournalOptions& options);
+
+  // Writes out everything queued before returning.
+  void close();
+
+  [[nodiscard]] bool isOpen() const { return m_isOpen; }
+
+  [[nodiscard]] const std::filesystem::path& getDirectory() const { return m_options.directory; }
+
+  // Safe to call from any thread. Returns false if the journal is closed or its queue is full.
+  bool append(const JournalRecord& record);
+
+  [[nodiscard]] TagJournalStats getStats() const;
+
+ private:
+  static constexpr size_t k_batchSize = 4096;
+  static constexpr size_t k_wakeThreshold = 1024;  // Queued records that wake the writer before the sync interval
+
+  void writerLoop();
+
+  bool openSegment(uint64_t sequence);
+
+  void closeSegment();
+
+  void writeBatch();
+
+  void sync();
+
+  TagJournalOptions m_options;
+  std::atomic<bool> m_isOpen{false};
+
+  std::unique_ptr<MpscQueue<JournalRecord>> m_queue;
+  std::thread m_writer;
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  bool m_stopRequested{false};
+
+  // Owned by the writer thread
+  std::FILE* m_segmentFile{nullptr};
+  std::FILE* m_indexFile{nullptr};
+  uint64_t m_segmentRecords{0};
+  int64_t m_lastTimestampUs{std::numeric_limits<int64_t>::min()};
+  std::vector<JournalRecord> m_batch;
+  bool m_dirty{false};
+
+  std::atomic<uint64_t> m_appended{0};
+  std::atomic<uint64_t> m_dropped{0};
+  std::atomic<uint64_t> m_written{0};
+  std::atomic<uint64_t> m_syncs{0};
+  std::atomic<uint64_t> m_writeErrors{0};
+  std::atomic<uint64_t> m_segment{0};
+};
+
+}  // namespace vanch
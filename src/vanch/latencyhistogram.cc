@@ -0,0 +1,78 @@
+#include "latencyhistogram.h"
+
+#include <cmath>
+
+namespace vanch {
+
+void LatencyHistogram::record(const std::chrono::steady_clock::duration latency) {
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  const auto value = static_cast<uint64_t>(std::max<int64_t>(micros, 0));
+
+  ++m_buckets[getBucketIndex(value)];
+  ++m_count;
+  m_sum += value;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < k_bucketCount; ++i) m_buckets[i] += other.m_buckets[i];
+
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+}
+
+void LatencyHistogram::reset() { *this = {}; }
+
+std::chrono::microseconds LatencyHistogram::getMin() const {
+  return std::chrono::microseconds(m_count == 0 ? 0 : m_min);
+}
+
+std::chrono::microseconds LatencyHistogram::getMean() const {
+  return std::chrono::microseconds(m_count == 0 ? 0 : m_sum / m_count);
+}
+
+std::chrono::microseconds LatencyHistogram::getPercentile(const double quantile) const {
+  if (m_count == 0) return {};
+
+  const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(m_count)));
+  const auto target = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+
+  for (size_t i = 0; i < k_bucketCount; ++i) {
+    seen += m_buckets[i];
+
+    if (seen < target) continue;
+
+    // The bound may lie above anything recorded in the bucket, and the top bucket also holds values beyond the range
+    return std::chrono::microseconds(i == k_bucketCount - 1 ? m_max : std::min(getUpperBound(i), m_max));
+  }
+
+  return getMax();
+}
+
+size_t LatencyHistogram::getBucketIndex(const uint64_t value) {
+  if (value < k_linearLimit) return static_cast<size_t>(value);
+
+  // Above the linear range, every power of two spans k_linearLimit / 2 buckets
+  const auto magnitude = static_cast<uint32_t>(std::bit_width(value)) - 1;
+  if (magnitude >= k_maxValueBits) return k_bucketCount - 1;
+
+  const auto shift = magnitude - k_subBucketBits + 1;
+  const auto subBucket = (value >> shift) - k_linearLimit / 2;
+
+  return static_cast<size_t>(k_linearLimit + (shift - 1) * (k_linearLimit / 2) + subBucket);
+}
+
+uint64_t LatencyHistogram::getUpperBound(const size_t index) {
+  if (index < k_linearLimit) return index;
+
+  const auto shift = (index - k_linearLimit) / (k_linearLimit / 2) + 1;
+  const auto subBucket = (index - k_linearLimit) % (k_linearLimit / 2) + k_linearLimit / 2;
+
+  return ((subBucket + 1) << shift) - 1;
+}
+
+}  // namespace vanch
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <limits>
+
+namespace vanch {
+
+// Log-linear histogram of durations in microseconds, in the style of HdrHistogram. Values below k_linearLimit get a
+// bucket each; every power of two above is split into k_linearLimit / 2 buckets, so a reported value is never more
+// than 1/64 (1.6%) above the recorded one. Recording is a couple of shifts and an increment, and the memory is fixed
+// however many values are recorded. Values above the range land in the top bucket.
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t k_subBucketBits = 7;
+  static constexpr uint64_t k_linearLimit = uint64_t{1} << k_subBucketBits;
+  static constexpr uint32_t k_maxValueBits = 27;  // Up to 2^27 us, a little over two minutes
+  static constexpr size_t k_bucketCount = k_linearLimit + (k_maxValueBits - k_subBucketBits) * (k_linearLimit / 2);
+
+  void record(std::chrono::steady_clock::duration latency);
+
+  void merge(const LatencyHistogram& other);
+
+  void reset();
+
+  [[nodiscard]] uint64_t getCount() const { return m_count; }
+
+  [[nodiscard]] std::chrono::microseconds getMin() const;
+
+  [[nodiscard]] std::chrono::microseconds getMax() const { return std::chrono::microseconds(m_max); }
+
+  [[nodiscard]] std::chrono::microseconds getMean() const;
+
+  // Smallest bucket bound at or below which the given share of the values lie, e.g. 0.99 for p99. Zero when empty.
+  [[nodiscard]] std::chrono::microseconds getPercentile(double quantile) const;
+
+  // Calls fn(upperBound, count) for every non-empty bucket, in ascending order.
+  template <typename Fn>
+  void forEachBucket(Fn&& fn) const {
+    for (size_t i = 0; i < k_bucketCount; ++i) {
+      if (m_buckets[i] != 0) fn(std::chrono::microseconds(getUpperBound(i)), m_buckets[i]);
+    }
+  }
+
+ private:
+  static size_t getBucketIndex(uint64_t value);
+
+  // Largest value that maps to the bucket
+  static uint64_t getUpperBound(size_t index);
+
+  std::array<uint64_t, k_bucketCount> m_buckets{};
+  uint64_t m_count{0};
+  uint64_t m_sum{0};
+  uint64_t m_min{std::numeric_limits<uint64_t>::max()};
+  uint64_t m_max{0};
+};
+
+}  // namespace vanch
@@ -0,0 +1,105 @@
+#include "mappedfile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vanch {
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_isOpen(std::exchange(other.m_isOpen, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_isOpen = std::exchange(other.m_isOpen, false);
+  }
+  return *this;
+}
+
+bool MappedFile::open(const std::filesystem::path& path) {
+  close();
+
+#if defined(_WIN32)
+  const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return false;
+  }
+
+  if (size.QuadPart > 0) {
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+      m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      CloseHandle(mapping);
+    }
+
+    if (!m_data) {
+      CloseHandle(file);
+      return false;
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+  }
+
+  CloseHandle(file);
+#else
+  const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+
+  struct stat info{};
+  if (fstat(fd, &info) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  if (info.st_size > 0) {
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(address);
+    m_size = static_cast<size_t>(info.st_size);
+  }
+
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+#endif
+
+  m_isOpen = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data) {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+  }
+
+  m_data = nullptr;
+  m_size = 0;
+  m_isOpen = false;
+}
+
+}  // namespace vanch
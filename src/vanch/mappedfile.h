@@ -0,0 +1,35 @@
+#pragma once
+
+namespace vanch {
+
+// Read-only memory mapping of a whole file. The mapping reflects the file size at the time it was opened.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  // An empty file opens successfully with no data.
+  bool open(const std::filesystem::path& path);
+
+  void close();
+
+  [[nodiscard]] std::span<const uint8_t> data() const { return {m_data, m_size}; }
+
+  [[nodiscard]] bool isOpen() const { return m_isOpen; }
+
+ private:
+  const uint8_t* m_data{nullptr};
+  size_t m_size{0};
+  bool m_isOpen{false};
+};
+
+}  // namespace vanch
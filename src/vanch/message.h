@@ -2,10 +2,17 @@
 
 #include <imgui.h>
 
-#include <numeric>
+#include "vanch/bufferwriter.h"
 
 namespace vanch {
 
+// Largest frame that fits a single UDP datagram on a standard Ethernet link.
+inline constexpr size_t k_maxFrameSize = 1500;
+
+// Header, length (2 bytes), address and command code precede the parameters; the checksum follows them.
+inline constexpr size_t k_frameHeaderSize = 5;
+inline constexpr size_t k_minFrameSize = k_frameHeaderSize + 1;
+
 enum MessageType : uint8_t {
   MessageType_Unknown = 0x00,
   MessageType_Command = 0x40,
@@ -14,6 +21,26 @@ enum MessageType : uint8_t {
   MessageType_Error = 0xF4,
 };
 
+inline constexpr size_t k_headerCount = 4;
+
+// Dense index of a header byte for table lookups, or -1 for bytes that never start a frame.
+constexpr int getHeaderIndex(const uint8_t header) {
+  switch (header) {
+    case MessageType_Command:
+      return 0;
+    case MessageType_Return:
+      return 1;
+    case MessageType_Status:
+      return 2;
+    case MessageType_Error:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+constexpr bool isKnownHeader(const uint8_t header) { return getHeaderIndex(header) >= 0; }
+
 struct IMessage {
   virtual ~IMessage() = default;
 
@@ -27,77 +54,88 @@ struct IMessage {
 
   virtual void render() { ImGui::TextUnformatted("No parameters to display"); };
 
-  [[nodiscard]] virtual std::vector<uint8_t> serialize() const = 0;
+  // Encodes the complete frame into the buffer. Returns the frame size, or 0 if the buffer is too small.
+  [[nodiscard]] virtual size_t serializeInto(std::span<uint8_t> buffer) const = 0;
 
-  void deserialize(const std::vector<uint8_t>& data) { deserialize(std::span{data}); };
+  [[nodiscard]] std::vector<uint8_t> serialize() const {
+    std::array<uint8_t, k_maxFrameSize> buffer{};
+    const auto size = serializeInto(buffer);
+    return {buffer.begin(), buffer.begin() + size};
+  }
 
-  virtual void deserialize(std::span<const uint8_t> data) = 0;
+  bool deserialize(const std::vector<uint8_t>& data) { return deserialize(std::span{data}); };
+
+  // Decodes a complete frame. Returns false if the frame is too short to carry a header and checksum.
+  virtual bool deserialize(std::span<const uint8_t> data) = 0;
 
   virtual void deserializeParameters(std::span<const uint8_t> data) {};
 
-  [[nodiscard]] virtual std::vector<uint8_t> serializeParameters() const { return {}; }
+  virtual void serializeParameters(BufferWriter& writer) const {}
 };
 
 template <typename T>
 struct Message : IMessage {
+  using Traits = T;
+
   [[nodiscard]] std::string getMessageName() const override { return T::getName(); }
 
   [[nodiscard]] MessageType getType() const override { return T::s_header; }
 
   [[nodiscard]] uint8_t getCmdCode() const override { return T::s_cmdCode; }
 
-  void deserialize(std::span<const uint8_t> data) override {
-    deserializeParameters({data.begin() + 5, data.end() - 1});
+  bool deserialize(const std::span<const uint8_t> data) override {
+    if (data.size() < k_minFrameSize) return false;
+    deserializeParameters(data.subspan(k_frameHeaderSize, data.size() - k_minFrameSize));
+    return true;
   }
 
-  [[nodiscard]] std::vector<uint8_t> serialize() const override {
-    std::vector<uint8_t> packet;
-
-    packet.push_back(getType());  // 0: Header
-
-    packet.push_back(0);  // 1: Temp Length H
-    packet.push_back(0);  // 2: Temp Length L
-
-    packet.push_back(0x00);  // 3: Address
+  [[nodiscard]] size_t serializeInto(const std::span<uint8_t> buffer) const override {
+    BufferWriter writer{buffer};
 
-    packet.push_back(getCmdCode());  // 4: Cmd
+    writer.put(getType());     // 0: Header
+    writer.putU16(0);          // 1-2: Temp Length
+    writer.put(0x00);          // 3: Address
+    writer.put(getCmdCode());  // 4: Cmd
 
-    auto params = serializeParameters();
-    packet.insert(packet.end(), params.begin(), params.end());  // 5-n: Param
+    serializeParameters(writer);  // 5-n: Param
 
-    const auto length = static_cast<uint16_t>(packet.size() - 3 + 1);  // (Address + Cmd + Params + Checksum)
-    packet[1] = static_cast<uint8_t>((length >> 8) & 0xFF);
-    packet[2] = static_cast<uint8_t>(length & 0xFF);
+    const auto length = static_cast<uint16_t>(writer.size() - 3 + 1);  // (Address + Cmd + Params + Checksum)
+    writer.patchU16(1, length);
 
-    const uint8_t checksum = calculateChecksum(packet);
-    packet.push_back(checksum);  // n-1: Check
+    writer.put(static_cast<uint8_t>(~writer.sum() + 1));  // n-1: Check
 
-    return packet;
-  }
-
- protected:
-  static uint8_t calculateChecksum(const std::vector<uint8_t>& data) {
-    const uint8_t sum = std::accumulate(data.begin(), data.end(), 0);
-    return (~sum) + 1;
+    return writer.overflowed() ? 0 : writer.size();
   }
 };
 
 struct Error_Traits {
-  struct Parameters {};
-
   static constexpr uint8_t s_cmdCode = 0xFF;
   static constexpr MessageType s_header = MessageType_Error;
 
-  static constexpr const char* getName() { return "Unknown Error"; }
+  static constexpr const char* getName() { return "Error"; }
+};
 
-  static std::vector<uint8_t> serializeParameters(const Message<Error_Traits>&) { return {}; }
+// Error frames echo the code of the command that failed and carry the device error code as their only parameter.
+struct Error final : Message<Error_Traits> {
+  uint8_t failedCmdCode{Error_Traits::s_cmdCode};
+  uint8_t errorCode{0xFF};
 
-  static void deserializeParameters(Message<Error_Traits>&, std::span<const uint8_t>) {}
+  [[nodiscard]] uint8_t getCmdCode() const override { return failedCmdCode; }
 
-  static void render(Message<Error_Traits>&) {}
-};
+  bool deserialize(const std::span<const uint8_t> data) override {
+    if (!Message::deserialize(data)) return false;
+    failedCmdCode = data[k_frameHeaderSize - 1];
+    return true;
+  }
+
+  void deserializeParameters(const std::span<const uint8_t> data) override {
+    errorCode = data.empty() ? 0xFF : data[0];
+  }
 
-using Error = Message<Error_Traits>;
+  void serializeParameters(BufferWriter& writer) const override { writer.put(errorCode); }
+
+  void render() override { ImGui::Text("Command 0x%02X failed with error code 0x%02X", failedCmdCode, errorCode); }
+};
 
 }  // namespace vanch
 
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "vanch/commands/command.h"
+#include "vanch/statuses/status.h"
+
+namespace vanch {
+
+template <typename... Ts>
+struct MessageList {};
+
+#define VANCH_CMD_RET(name) Cmd##name, Ret##name
+
+// Every message the registry can decode or create. Commands appear in the UI in this order.
+using RegisteredMessages = MessageList<
+    VANCH_CMD_RET(SetBaudRate),
+    VANCH_CMD_RET(GetBaudRate),
+    VANCH_CMD_RET(SetRS485Address),
+    VANCH_CMD_RET(GetRS485Address),
+    VANCH_CMD_RET(GetVersionNumber),
+    VANCH_CMD_RET(SetRelayStatus),
+    VANCH_CMD_RET(GetRelayStatus),
+    VANCH_CMD_RET(SetBuzzer),
+    VANCH_CMD_RET(GetBuzzer),
+    VANCH_CMD_RET(SetCardReadingMode),
+    VANCH_CMD_RET(GetCardReadingMode),
+    VANCH_CMD_RET(SetOutputPower),
+    VANCH_CMD_RET(GetOutputPower),
+    // VANCH_CMD_RET(SetFrequencyPoints),
+    // VANCH_CMD_RET(GetFrequencyPoints),
+    VANCH_CMD_RET(RestoreFactorySettings),
+    VANCH_CMD_RET(RestartReader),
+    VANCH_CMD_RET(RestoreWIFISettings),
+    VANCH_CMD_RET(SetReaderTime),
+    VANCH_CMD_RET(GetReaderTime),
+    VANCH_CMD_RET(SetTagFilter),
+    VANCH_CMD_RET(GetTagFilter),
+    VANCH_CMD_RET(SetRJ45LocalParams),
+    VANCH_CMD_RET(GetRJ45LocalParams),
+    VANCH_CMD_RET(SetRJ45RemoteParams),
+    VANCH_CMD_RET(GetRJ45RemoteParams),
+    VANCH_CMD_RET(SetMACAddress),
+    VANCH_CMD_RET(GetMACAddress),
+    VANCH_CMD_RET(SetTagAlarm),
+    VANCH_CMD_RET(GetTagAlarm),
+    VANCH_CMD_RET(SetReaderID),
+    VANCH_CMD_RET(GetReaderID),
+    VANCH_CMD_RET(SetReaderName),
+    VANCH_CMD_RET(GetReaderName),
+    VANCH_CMD_RET(SetHeartbeatPacket),
+    VANCH_CMD_RET(GetHeartbeatPacket),
+    VANCH_CMD_RET(SetWIFIParams),
+    VANCH_CMD_RET(GetWIFIParams),
+    VANCH_CMD_RET(SetSuperNetworkParams),
+    VANCH_CMD_RET(GetSuperNetworkParams),
+    VANCH_CMD_RET(Set4GParams),
+    VANCH_CMD_RET(Get4GParams),
+    VANCH_CMD_RET(GetGPIStatus),
+    VANCH_CMD_RET(SetRelayAutoControlParams),
+    VANCH_CMD_RET(GetRelayAutoControlParams),
+    VANCH_CMD_RET(SetAutoPollingAntenna),
+    VANCH_CMD_RET(GetAutoPollingAntenna),
+    VANCH_CMD_RET(SetAutoReadTagType),
+    VANCH_CMD_RET(GetAutoReadTagType),
+    VANCH_CMD_RET(SetReportedHardwareInterface),
+    VANCH_CMD_RET(GetReportedHardwareInterface),
+    VANCH_CMD_RET(SetAutoReportingFields),
+    VANCH_CMD_RET(GetAutoReportingFields),
+    VANCH_CMD_RET(SetAutoReportingContent),
+    VANCH_CMD_RET(GetAutoReportingContent),
+    VANCH_CMD_RET(SetAutoReportingConditions),
+    VANCH_CMD_RET(GetAutoReportingConditions),
+    VANCH_CMD_RET(SetWiegandParams),
+    VANCH_CMD_RET(GetWiegandParams),
+    VANCH_CMD_RET(SetTriggerConditions),
+    VANCH_CMD_RET(GetTriggerConditions),
+    VANCH_CMD_RET(Read15693Tag),
+    VANCH_CMD_RET(Write15693Tag),
+    VANCH_CMD_RET(Write15693MultipleBlocks),
+    VANCH_CMD_RET(ReadISO15693Tag),
+    VANCH_CMD_RET(WriteISO15693Tag),
+    VANCH_CMD_RET(Read14443ATag),
+    VANCH_CMD_RET(Write14443ATag),
+    VANCH_CMD_RET(Select14443ASector),
+    VANCH_CMD_RET(Write14443AMultipleBlocks),
+    StatusAutoCardReading,
+    StatusUdpBroadcast,
+    StatusHeartbeat>;
+
+#undef VANCH_CMD_RET
+
+}  // namespace vanch
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "vanch/message.h"
+
+namespace vanch {
+
+struct MessagePoolStats {
+  uint64_t hits{0};
+  uint64_t misses{0};
+
+  [[nodiscard]] double getHitRate() const {
+    const auto total = hits + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+  }
+};
+
+// Recycles decoded messages of one type. Each slot keeps a reference to its object, so a slot whose use count has
+// dropped back to one has been released by every consumer and can be handed out again without touching the
+// allocator; strings and vectors inside the object keep their capacity between uses. The type's
+// deserializeParameters() must therefore assign every field it decodes.
+template <typename T>
+class MessagePool {
+ public:
+  explicit MessagePool(const size_t capacity) : m_slots(capacity) {}
+
+  std::shared_ptr<T> acquire() {
+    std::lock_guard lock(m_mutex);
+
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+      auto& slot = m_slots[m_cursor];
+      m_cursor = (m_cursor + 1) % m_slots.size();
+
+      if (!slot) {
+        slot = std::make_shared<T>();
+        ++m_misses;
+        return slot;
+      }
+
+      if (slot.use_count() == 1) {
+        // Pairs with the release decrement of the last consumer
+        std::atomic_thread_fence(std::memory_order_acquire);
+        slot->messageTimestamp.reset();
+        ++m_hits;
+        return slot;
+      }
+    }
+
+    ++m_misses;
+    return std::make_shared<T>();
+  }
+
+  [[nodiscard]] MessagePoolStats getStats() const { return {m_hits, m_misses}; }
+
+ private:
+  std::vector<std::shared_ptr<T>> m_slots;
+  size_t m_cursor{0};
+  std::mutex m_mutex;
+  std::atomic_uint64_t m_hits{0};
+  std::atomic_uint64_t m_misses{0};
+};
+
+}  // namespace vanch
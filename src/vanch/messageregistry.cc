@@ -1,101 +1,129 @@
 #include "messageregistry.h"
 
-#include "commands/command.h"
-#include "statuses/status.h"
-
-#define REG_CMD_RET(name)                                                                                        \
-  registerMessage(                                                                                               \
-      Cmd##name##_Traits::s_cmdCode, Cmd##name##_Traits::s_header, [] { return std::make_shared<Cmd##name>(); }, \
-      Cmd##name##_Traits::getName());                                                                            \
-  registerMessage(                                                                                               \
-      Ret##name##_Traits::s_cmdCode, Ret##name##_Traits::s_header, [] { return std::make_shared<Ret##name>(); }, \
-      Ret##name##_Traits::getName());
-
-#define REG(name)                                                                                 \
-  registerMessage(                                                                                \
-      name##_Traits::s_cmdCode, name##_Traits::s_header, [] { return std::make_shared<name>(); }, \
-      name##_Traits::getName());
+#include "messagelist.h"
 
 namespace vanch {
 
-void MessageRegistry::init() {
-  static bool initialized = false;
-  if (initialized) return;
-
-  REG_CMD_RET(SetBaudRate)
-  REG_CMD_RET(GetBaudRate)
-  REG_CMD_RET(SetRS485Address)
-  REG_CMD_RET(GetRS485Address)
-  REG_CMD_RET(GetVersionNumber)
-  REG_CMD_RET(SetRelayStatus)
-  REG_CMD_RET(GetRelayStatus)
-  REG_CMD_RET(SetBuzzer)
-  REG_CMD_RET(GetBuzzer)
-  REG_CMD_RET(SetCardReadingMode)
-  REG_CMD_RET(GetCardReadingMode)
-  REG_CMD_RET(SetOutputPower)
-  REG_CMD_RET(GetOutputPower)
-  // REG_CMD_RET(SetFrequencyPoints)
-  // REG_CMD_RET(GetFrequencyPoints)
-  REG_CMD_RET(RestoreFactorySettings)
-  REG_CMD_RET(RestartReader)
-  REG_CMD_RET(RestoreWIFISettings)
-  REG_CMD_RET(SetReaderTime)
-  REG_CMD_RET(GetReaderTime)
-  REG_CMD_RET(SetTagFilter)
-  REG_CMD_RET(GetTagFilter)
-  REG_CMD_RET(SetRJ45LocalParams)
-  REG_CMD_RET(GetRJ45LocalParams)
-  REG_CMD_RET(SetRJ45RemoteParams)
-  REG_CMD_RET(GetRJ45RemoteParams)
-  REG_CMD_RET(SetMACAddress)
-  REG_CMD_RET(GetMACAddress)
-  REG_CMD_RET(SetTagAlarm)
-  REG_CMD_RET(GetTagAlarm)
-  REG_CMD_RET(SetReaderID)
-  REG_CMD_RET(GetReaderID)
-  REG_CMD_RET(SetReaderName)
-  REG_CMD_RET(GetReaderName)
-  REG_CMD_RET(SetHeartbeatPacket)
-  REG_CMD_RET(GetHeartbeatPacket)
-  REG_CMD_RET(SetWIFIParams)
-  REG_CMD_RET(GetWIFIParams)
-  REG_CMD_RET(SetSuperNetworkParams)
-  REG_CMD_RET(GetSuperNetworkParams)
-  REG_CMD_RET(Set4GParams)
-  REG_CMD_RET(Get4GParams)
-  REG_CMD_RET(GetGPIStatus)
-  REG_CMD_RET(SetRelayAutoControlParams)
-  REG_CMD_RET(GetRelayAutoControlParams)
-  REG_CMD_RET(SetAutoPollingAntenna)
-  REG_CMD_RET(GetAutoPollingAntenna)
-  REG_CMD_RET(SetAutoReadTagType)
-  REG_CMD_RET(GetAutoReadTagType)
-  REG_CMD_RET(SetReportedHardwareInterface)
-  REG_CMD_RET(GetReportedHardwareInterface)
-  REG_CMD_RET(SetAutoReportingFields)
-  REG_CMD_RET(GetAutoReportingFields)
-  REG_CMD_RET(SetAutoReportingContent)
-  REG_CMD_RET(GetAutoReportingContent)
-  REG_CMD_RET(SetAutoReportingConditions)
-  REG_CMD_RET(GetAutoReportingConditions)
-  REG_CMD_RET(SetWiegandParams)
-  REG_CMD_RET(GetWiegandParams)
-  REG_CMD_RET(SetTriggerConditions)
-  REG_CMD_RET(GetTriggerConditions)
-  REG_CMD_RET(Read15693Tag)
-  REG_CMD_RET(Write15693Tag)
-  REG_CMD_RET(Write15693MultipleBlocks)
-  REG_CMD_RET(ReadISO15693Tag)
-  REG_CMD_RET(WriteISO15693Tag)
-  REG_CMD_RET(Read14443ATag)
-  REG_CMD_RET(Write14443ATag)
-  REG_CMD_RET(Select14443ASector)
-  REG_CMD_RET(Write14443AMultipleBlocks)
-
-  REG(StatusAutoCardReading)
-  REG(StatusUdpBroadcast)
-  REG(StatusHeartbeat)
+namespace {
+
+using DispatchTable = std::array<std::array<MessageRegistry::FactoryFunction, 256>, k_headerCount>;
+
+constexpr size_t k_messagePoolCapacity = 256;
+
+// Status packets arrive continuously while auto-reporting is on, so they are recycled instead of allocated
+template <typename T>
+constexpr bool k_isPooled = T::Traits::s_header == MessageType_Status;
+
+template <typename T>
+MessagePool<T>& getMessagePool() {
+  static MessagePool<T> pool{k_messagePoolCapacity};
+  return pool;
+}
+
+template <typename T>
+std::shared_ptr<IMessage> makeMessage() {
+  if constexpr (k_isPooled<T>) {
+    return getMessagePool<T>().acquire();
+  } else {
+    return std::make_shared<T>();
+  }
+}
+
+template <typename... Ts>
+MessagePoolStats collectPoolStats(MessageList<Ts...>) {
+  MessagePoolStats total;
+
+  (
+      [&] {
+        if constexpr (k_isPooled<Ts>) {
+          const auto stats = getMessagePool<Ts>().getStats();
+          total.hits += stats.hits;
+          total.misses += stats.misses;
+        }
+      }(),
+      ...);
+
+  return total;
+}
+
+template <typename... Ts>
+consteval bool hasUniqueKeys(MessageList<Ts...>) {
+  constexpr std::array<std::pair<uint8_t, uint8_t>, sizeof...(Ts)> keys = {
+      std::pair<uint8_t, uint8_t>{Ts::Traits::s_header, Ts::Traits::s_cmdCode}...};
+  for (size_t i = 0; i < keys.size(); ++i) {
+    for (size_t j = i + 1; j < keys.size(); ++j) {
+      if (keys[i] == keys[j]) return false;
+    }
+  }
+  return true;
+}
+
+template <typename... Ts>
+consteval DispatchTable makeDispatchTable(MessageList<Ts...>) {
+  DispatchTable table{};
+
+  // Error frames echo the code of the failed command, so every code maps to the same error message
+  table[getHeaderIndex(MessageType_Error)].fill(&makeMessage<Error>);
+
+  ((table[getHeaderIndex(Ts::Traits::s_header)][Ts::Traits::s_cmdCode] = &makeMessage<Ts>), ...);
+
+  return table;
+}
+
+template <typename... Ts>
+consteval size_t countCommands(MessageList<Ts...>) {
+  return ((Ts::Traits::s_header == MessageType_Command ? 1 : 0) + ...);
+}
+
+template <size_t N, typename... Ts>
+consteval std::array<CommandMetadata, N> makeCommandMetadata(MessageList<Ts...>) {
+  std::array<CommandMetadata, N> metadata{};
+  size_t index = 0;
+
+  (
+      [&] {
+        if constexpr (Ts::Traits::s_header == MessageType_Command) {
+          metadata[index++] = {Ts::Traits::s_cmdCode, Ts::Traits::getName()};
+        }
+      }(),
+      ...);
+
+  return metadata;
+}
+
+static_assert(hasUniqueKeys(RegisteredMessages{}), "Message registered twice with the same header and code");
+
+constexpr DispatchTable k_dispatchTable = makeDispatchTable(RegisteredMessages{});
+
+constexpr auto k_commandMetadata =
+    makeCommandMetadata<countCommands(RegisteredMessages{})>(RegisteredMessages{});
+
+}  // namespace
+
+std::shared_ptr<IMessage> MessageRegistry::create(const uint8_t cmdCode, const MessageType type) {
+  const auto index = getHeaderIndex(type);
+  if (index < 0) return nullptr;
+
+  if (const auto factory = k_dispatchTable[index][cmdCode]) {
+    return factory();
+  }
+  return nullptr;
 }
 
+std::shared_ptr<IMessage> MessageRegistry::createFromData(const std::span<const uint8_t> data) {
+  if (FrameDecoder::validate(data) != FrameError::None) return nullptr;
+
+  // validate() guarantees a known header, so the index is in range
+  const auto factory = k_dispatchTable[getHeaderIndex(data[0])][data[4]];
+  if (!factory) return nullptr;
+
+  auto msg = factory();
+  msg->deserialize(data);
+  return msg;
+}
+
+std::span<const CommandMetadata> MessageRegistry::getCommandMetadata() { return k_commandMetadata; }
+
+MessagePoolStats MessageRegistry::getPoolStats() { return collectPoolStats(RegisteredMessages{}); }
+
 }  // namespace vanch
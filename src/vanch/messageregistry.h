@@ -2,70 +2,29 @@
 
 #include <frozen/unordered_map.h>
 
+#include "vanch/framedecoder.h"
 #include "vanch/message.h"
+#include "vanch/messagepool.h"
 
 namespace vanch {
 
 struct CommandMetadata {
   uint8_t cmdCode;
-  std::string name;
+  std::string_view name;
 };
 
 class MessageRegistry {
  public:
-  using FactoryFunction = std::function<std::shared_ptr<IMessage>()>;
+  using FactoryFunction = std::shared_ptr<IMessage> (*)();
 
-  static void init();
+  static std::shared_ptr<IMessage> create(uint8_t cmdCode, MessageType type);
 
-  static void registerMessage(uint8_t cmdCode, MessageType type, const FactoryFunction& factory,
-                              const std::string& name) {
-    const auto& registry = getRegistry();
-    const auto key = std::make_pair(cmdCode, type);
+  static std::shared_ptr<IMessage> createFromData(std::span<const uint8_t> data);
 
-    if (registry.contains(key)) {
-      return;
-    }
-
-    getRegistry()[key] = factory;
-
-    if (type == MessageType_Command) getCommandMetadata().push_back({cmdCode, name});
-  }
-
-  static std::shared_ptr<IMessage> create(uint8_t cmdCode, MessageType type) {
-    auto& registry = getRegistry();
-    const auto key = std::make_pair(cmdCode, type);
-    if (const auto it = registry.find(key); it != registry.end()) {
-      return it->second();
-    }
-    return nullptr;
-  }
-
-  static std::shared_ptr<IMessage> createFromData(std::span<const uint8_t> data) {
-    if (data.size() < 6) return nullptr;
+  static std::span<const CommandMetadata> getCommandMetadata();
 
-    auto type = static_cast<MessageType>(data[0]);
-    auto cmdCode = data[4];
-
-    std::shared_ptr<IMessage> msg{};
-
-    auto& registry = getRegistry();
-    const auto key = std::make_pair(cmdCode, type);
-    if (const auto it = registry.find(key); it != registry.end()) {
-      msg = it->second();
-      msg->deserialize(data);
-    }
-
-    if (type == MessageType_Error) {
-      msg = std::make_shared<Error>();
-    }
-
-    return msg;
-  }
-
-  static std::vector<CommandMetadata>& getCommandMetadata() {
-    static std::vector<CommandMetadata> commandMetadata;
-    return commandMetadata;
-  }
+  // Combined recycling statistics of the pools backing status messages.
+  static MessagePoolStats getPoolStats();
 
   static constexpr std::string_view getErrorMessage(const uint8_t errorCode) {
     if (const auto it = m_errorDescriptions.find(errorCode); it != m_errorDescriptions.end()) {
@@ -75,11 +34,6 @@ class MessageRegistry {
   }
 
  private:
-  static std::map<std::pair<uint8_t, MessageType>, FactoryFunction>& getRegistry() {
-    static std::map<std::pair<uint8_t, MessageType>, FactoryFunction> registry;
-    return registry;
-  }
-
   static constexpr frozen::unordered_map<uint8_t, std::string_view, 95> m_errorDescriptions = {
       {0x00, "0x00 Successful"},
       {0x01, "0x01 Unsupported function code"},
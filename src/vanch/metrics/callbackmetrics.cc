@@ -0,0 +1,44 @@
+#include "callbackmetrics.h"
+
+namespace vanch {
+
+std::array<CallbackMetrics::Counters, k_callbackKindCount> CallbackMetrics::s_counters{};
+
+std::string_view getCallbackKindName(const CallbackKind kind) {
+  switch (kind) {
+    case CallbackKind::Return:
+      return "return";
+    case CallbackKind::Status:
+      return "status";
+    case CallbackKind::Error:
+      return "error";
+  }
+  return "unknown";
+}
+
+void CallbackMetrics::record(const CallbackKind kind, const std::chrono::steady_clock::duration elapsed) {
+  auto& counters = s_counters[static_cast<size_t>(kind)];
+
+  const auto bucket = std::ranges::lower_bound(k_bucketBounds, elapsed) - k_bucketBounds.begin();
+  counters.add(static_cast<size_t>(bucket));
+
+  const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  counters.add(k_sumIndex, static_cast<uint64_t>(std::max<int64_t>(nanos, 0)));
+}
+
+CallbackLatency CallbackMetrics::snapshot(const CallbackKind kind) {
+  const auto values = s_counters[static_cast<size_t>(kind)].loadAll();
+
+  CallbackLatency latency{
+      .kind = kind,
+      .buckets = {values.begin(), values.begin() + k_overflowIndex + 1},
+      .count = 0,
+      .sum = std::chrono::nanoseconds(values[k_sumIndex]),
+  };
+
+  for (const auto count : latency.buckets) latency.count += count;
+
+  return latency;
+}
+
+}  // namespace vanch
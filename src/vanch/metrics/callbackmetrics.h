@@ -0,0 +1,50 @@
+#pragma once
+
+#include "shardedcounter.h"
+
+namespace vanch {
+
+enum class CallbackKind : uint8_t {
+  Return,
+  Status,
+  Error,
+};
+
+inline constexpr size_t k_callbackKindCount{3};
+
+std::string_view getCallbackKindName(CallbackKind kind);
+
+// Time spent in the subscribers of one kind of message, bucketed by CallbackMetrics::k_bucketBounds.
+struct CallbackLatency {
+  CallbackKind kind{CallbackKind::Return};
+  std::vector<uint64_t> buckets;  // Per bound and not cumulative; the last bucket holds everything above
+  uint64_t count{0};
+  std::chrono::nanoseconds sum{};
+};
+
+// Process-wide histograms of how long subscribers hold up dispatch. Every session on every I/O thread records into
+// them, so the counters are sharded per thread to keep recording off shared cache lines.
+class CallbackMetrics {
+ public:
+  static constexpr std::array k_bucketBounds{
+      std::chrono::microseconds(1),   std::chrono::microseconds(2),    std::chrono::microseconds(5),
+      std::chrono::microseconds(10),  std::chrono::microseconds(25),   std::chrono::microseconds(50),
+      std::chrono::microseconds(100), std::chrono::microseconds(250),  std::chrono::microseconds(500),
+      std::chrono::microseconds(1000), std::chrono::microseconds(2500), std::chrono::microseconds(10000),
+  };
+
+  static void record(CallbackKind kind, std::chrono::steady_clock::duration elapsed);
+
+  [[nodiscard]] static CallbackLatency snapshot(CallbackKind kind);
+
+ private:
+  // One counter per bound, one for the overflow and one for the sum in nanoseconds
+  static constexpr size_t k_overflowIndex{k_bucketBounds.size()};
+  static constexpr size_t k_sumIndex{k_bucketBounds.size() + 1};
+
+  using Counters = ShardedCounters<k_bucketBounds.size() + 2>;
+
+  static std::array<Counters, k_callbackKindCount> s_counters;
+};
+
+}  // namespace vanch
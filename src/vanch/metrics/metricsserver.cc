@@ -0,0 +1,132 @@
+#include "metricsserver.h"
+
+#include <fmt/format.h>
+
+namespace vanch {
+
+MetricsServer::Listener::Listener(asio::io_context& io, Source source)
+    : strand(asio::make_strand(io)), acceptor(strand), source(std::move(source)) {}
+
+MetricsServer::MetricsServer(asio::io_context& io, Source source)
+    : Loggable("MetricsServer"), m_io(io), m_source(std::move(source)) {}
+
+MetricsServer::~MetricsServer() { stop(); }
+
+bool MetricsServer::start(const MetricsServerOptions& options) {
+  if (m_listener) return true;
+
+  asio::error_code ec;
+  const auto address = asio::ip::make_address(options.address, ec);
+
+  if (ec) {
+    logger->error("Invalid metrics address {}: {}", options.address, ec.message());
+    return false;
+  }
+
+  auto listener = std::make_shared<Listener>(m_io, m_source);
+  const asio::ip::tcp::endpoint endpoint{address, options.port};
+
+  listener->acceptor.open(endpoint.protocol(), ec);
+  if (!ec) listener->acceptor.set_option(asio::socket_base::reuse_address(true), ec);
+  if (!ec) listener->acceptor.bind(endpoint, ec);
+  if (!ec) listener->acceptor.listen(asio::socket_base::max_listen_connections, ec);
+
+  if (ec) {
+    logger->error("Failed to serve metrics on {}:{}: {}", options.address, options.port, ec.message());
+    return false;
+  }
+
+  listener->endpoint = listener->acceptor.local_endpoint();
+  m_listener = std::move(listener);
+
+  co_spawn(m_listener->strand, acceptLoop(m_listener), asio::detached);
+
+  logger->info("Serving metrics on http://{}:{}/metrics", options.address, m_listener->endpoint.port());
+  return true;
+}
+
+void MetricsServer::stop() {
+  if (!m_listener) return;
+
+  // The acceptor belongs to the listener's strand; connections in flight finish on their own
+  asio::post(m_listener->strand, [listener = m_listener] {
+    asio::error_code ec;
+    listener->acceptor.close(ec);
+  });
+
+  m_listener.reset();
+}
+
+asio::ip::tcp::endpoint MetricsServer::getEndpoint() const {
+  return m_listener ? m_listener->endpoint : asio::ip::tcp::endpoint{};
+}
+
+uint64_t MetricsServer::getScrapeCount() const {
+  return m_listener ? m_listener->scrapes.load(std::memory_order_relaxed) : 0;
+}
+
+asio::awaitable<void> MetricsServer::acceptLoop(const std::shared_ptr<Listener> listener) {
+  while (true) {
+    // Every connection gets its own strand, so its request timeout and I/O never run concurrently
+    auto [ec, socket] = co_await listener->acceptor.async_accept(asio::make_strand(listener->acceptor.get_executor()));
+
+    if (ec == asio::error::operation_aborted || !listener->acceptor.is_open()) break;
+    if (ec) continue;
+
+    const auto executor = socket.get_executor();
+    co_spawn(executor, serve(listener, tcp_socket(std::move(socket))), asio::detached);
+  }
+}
+
+asio::awaitable<void> MetricsServer::serve(const std::shared_ptr<Listener> listener, tcp_socket socket) {
+  // A client that never finishes its request must not hold the connection open
+  steady_timer deadline{socket.get_executor(), k_requestTimeout};
+  deadline.async_wait([&socket](const asio::error_code ec) {
+    asio::error_code closeEc;
+    if (!ec) socket.close(closeEc);
+  });
+
+  std::string request;
+  auto [readEc, headerSize] =
+      co_await asio::async_read_until(socket, asio::dynamic_buffer(request, k_maxRequestSize), "\r\n\r\n");
+
+  if (readEc) co_return;
+
+  // Only the request line matters, e.g. "GET /metrics HTTP/1.1"
+  const std::string_view line = std::string_view(request).substr(0, request.find("\r\n"));
+  const auto methodEnd = line.find(' ');
+  const auto method = line.substr(0, methodEnd);
+  const auto target = methodEnd == std::string_view::npos ? std::string_view{} : line.substr(methodEnd + 1);
+  const auto path = target.substr(0, target.find_first_of(" ?"));
+
+  std::string status = "200 OK";
+  std::string contentType = "text/plain; version=0.0.4; charset=utf-8";
+  std::string body;
+
+  if (method != "GET") {
+    status = "405 Method Not Allowed";
+    contentType = "text/plain";
+    body = "Only GET is supported\n";
+  } else if (path != "/metrics") {
+    status = "404 Not Found";
+    contentType = "text/plain";
+    body = "Metrics are served at /metrics\n";
+  } else {
+    body = formatPrometheus(listener->source());
+    listener->scrapes.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const auto header = fmt::format("HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n",
+                                  status, contentType, body.size());
+
+  const std::array<asio::const_buffer, 2> buffers{asio::buffer(header), asio::buffer(body)};
+  co_await asio::async_write(socket, buffers);
+
+  deadline.cancel();
+
+  asio::error_code ec;
+  socket.shutdown(asio::ip::tcp::socket::shutdown_send, ec);
+  socket.close(ec);
+}
+
+}  // namespace vanch
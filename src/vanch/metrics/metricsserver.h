@@ -0,0 +1,64 @@
+#pragma once
+
+#include "krog/util/loggable.h"
+#include "metricssnapshot.h"
+#include "vanch/asiotypes.h"
+
+namespace vanch {
+
+struct MetricsServerOptions {
+  std::string address{"127.0.0.1"};  // Loopback only by default; the endpoint has no authentication
+  uint16_t port{9464};
+};
+
+// Serves GET /metrics in the Prometheus text format over plain HTTP/1.1. Every scrape calls the source on an I/O
+// thread, so it must only read state that is safe to read from there, such as session stats. One request is served
+// per connection, which is all a scraper needs.
+class MetricsServer final : kr::Loggable {
+ public:
+  using Source = std::function<MetricsSnapshot()>;
+
+  MetricsServer(asio::io_context& io, Source source);
+
+  ~MetricsServer() override;
+
+  MetricsServer(const MetricsServer&) = delete;
+
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  bool start(const MetricsServerOptions& options);
+
+  void stop();
+
+  [[nodiscard]] bool isRunning() const { return m_listener != nullptr; }
+
+  // Bound endpoint, e.g. to find the port picked for port 0. Only valid while running.
+  [[nodiscard]] asio::ip::tcp::endpoint getEndpoint() const;
+
+  [[nodiscard]] uint64_t getScrapeCount() const;
+
+ private:
+  // Shared with the coroutines so that a connection still being served never touches a destroyed server
+  struct Listener {
+    Listener(asio::io_context& io, Source source);
+
+    asio::strand<asio::io_context::executor_type> strand;
+    tcp_acceptor acceptor;
+    asio::ip::tcp::endpoint endpoint;
+    Source source;
+    std::atomic<uint64_t> scrapes{0};
+  };
+
+  static asio::awaitable<void> acceptLoop(std::shared_ptr<Listener> listener);
+
+  static asio::awaitable<void> serve(std::shared_ptr<Listener> listener, tcp_socket socket);
+
+  static constexpr size_t k_maxRequestSize{8192};
+  static constexpr std::chrono::seconds k_requestTimeout{5};
+
+  asio::io_context& m_io;
+  Source m_source;
+  std::shared_ptr<Listener> m_listener;
+};
+
+}  // namespace vanch
@@ -0,0 +1,137 @@
+#include "metricssnapshot.h"
+
+#include <fmt/format.h>
+
+namespace vanch {
+
+namespace {
+
+class PrometheusWriter {
+ public:
+  // Every family is written as a whole: help and type first, then all of its samples
+  void family(const std::string_view name, const std::string_view type, const std::string_view help) {
+    fmt::format_to(std::back_inserter(m_text), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+  }
+
+  void sample(const std::string_view name, const std::string_view labels, const uint64_t value) {
+    fmt::format_to(std::back_inserter(m_text), "{}{{{}}} {}\n", name, labels, value);
+  }
+
+  void sample(const std::string_view name, const std::string_view labels, const double value) {
+    fmt::format_to(std::back_inserter(m_text), "{}{{{}}} {}\n", name, labels, value);
+  }
+
+  // Counters of every reader as one family
+  template <typename Fn>
+  void readers(const MetricsSnapshot& snapshot, const std::string_view name, const std::string_view type,
+               const std::string_view help, Fn&& value) {
+    family(name, type, help);
+    for (const auto& reader : snapshot.readers) sample(name, readerLabel(reader), value(reader.stats));
+  }
+
+  // Per lane of every reader's command queue
+  template <typename Fn>
+  void lanes(const MetricsSnapshot& snapshot, const std::string_view name, const std::string_view type,
+             const std::string_view help, Fn&& value) {
+    family(name, type, help);
+    for (const auto& reader : snapshot.readers) {
+      for (size_t i = 0; i < k_commandPriorityCount; ++i) {
+        const auto lane = getCommandPriorityName(static_cast<CommandPriority>(i));
+        sample(name, fmt::format("{},lane=\"{}\"", readerLabel(reader), lane), value(reader.stats.queue.lanes[i]));
+      }
+    }
+  }
+
+  static std::string readerLabel(const ReaderMetrics& reader) { return fmt::format("reader=\"{}\"", reader.reader); }
+
+  std::string take() { return std::move(m_text); }
+
+ private:
+  std::string m_text;
+};
+
+}  // namespace
+
+MetricsSnapshot captureMetrics() {
+  MetricsSnapshot snapshot;
+
+  for (size_t i = 0; i < k_callbackKindCount; ++i) {
+    snapshot.callbacks[i] = CallbackMetrics::snapshot(static_cast<CallbackKind>(i));
+  }
+
+  return snapshot;
+}
+
+std::string formatPrometheus(const MetricsSnapshot& snapshot) {
+  using Stats = ReaderSessionStats;
+  PrometheusWriter writer;
+
+  writer.readers(snapshot, "vanch_datagrams_received_total", "counter", "Datagrams received from the reader.",
+                 [](const Stats& stats) { return stats.datagramsReceived; });
+  writer.readers(snapshot, "vanch_datagrams_sent_total", "counter", "Datagrams sent to the reader.",
+                 [](const Stats& stats) { return stats.framesSent; });
+  writer.readers(snapshot, "vanch_bytes_received_total", "counter", "Bytes received from the reader.",
+                 [](const Stats& stats) { return stats.bytesReceived; });
+  writer.readers(snapshot, "vanch_bytes_sent_total", "counter", "Bytes sent to the reader.",
+                 [](const Stats& stats) { return stats.bytesSent; });
+  writer.readers(snapshot, "vanch_frames_received_total", "counter", "Messages decoded from the reader's datagrams.",
+                 [](const Stats& stats) { return stats.framesReceived; });
+  writer.readers(snapshot, "vanch_datagrams_dropped_total", "counter",
+                 "Datagrams dropped because the session inbox was full.",
+                 [](const Stats& stats) { return stats.droppedDatagrams; });
+  writer.readers(snapshot, "vanch_unsolicited_responses_total", "counter",
+                 "Returns and errors that matched no outstanding request.",
+                 [](const Stats& stats) { return stats.unsolicited; });
+  writer.readers(snapshot, "vanch_send_errors_total", "counter", "Commands the socket failed to send.",
+                 [](const Stats& stats) { return stats.sendErrors; });
+  writer.readers(snapshot, "vanch_decode_noise_bytes_total", "counter",
+                 "Bytes skipped while resynchronising on a frame header.",
+                 [](const Stats& stats) { return stats.noiseBytes; });
+
+  writer.family("vanch_decode_failures_total", "counter", "Frames rejected during decoding, by reason.");
+  for (const auto& reader : snapshot.readers) {
+    const auto label = PrometheusWriter::readerLabel(reader);
+    writer.sample("vanch_decode_failures_total", label + ",reason=\"bad_length\"", reader.stats.badLength);
+    writer.sample("vanch_decode_failures_total", label + ",reason=\"bad_checksum\"", reader.stats.badChecksum);
+    writer.sample("vanch_decode_failures_total", label + ",reason=\"unknown_message\"", reader.stats.unknownMessages);
+  }
+
+  using LaneStats = CommandLaneStats;
+
+  writer.lanes(snapshot, "vanch_command_queue_depth", "gauge", "Commands waiting for the request window.",
+               [](const LaneStats& lane) { return lane.depth; });
+  writer.lanes(snapshot, "vanch_command_queue_blocked_producers", "gauge", "Producers waiting for space in the lane.",
+               [](const LaneStats& lane) { return lane.blocked; });
+  writer.lanes(snapshot, "vanch_command_queue_enqueued_total", "counter", "Commands queued.",
+               [](const LaneStats& lane) { return lane.enqueued; });
+  writer.lanes(snapshot, "vanch_command_queue_dropped_total", "counter",
+               "Commands rejected because their lane of the command queue was full.",
+               [](const LaneStats& lane) { return lane.dropped; });
+
+  writer.family("vanch_callback_duration_seconds", "histogram", "Time spent in the subscribers of a message.");
+  for (const auto& callback : snapshot.callbacks) {
+    const auto kind = fmt::format("kind=\"{}\"", getCallbackKindName(callback.kind));
+    uint64_t cumulative = 0;
+
+    for (size_t i = 0; i < CallbackMetrics::k_bucketBounds.size(); ++i) {
+      cumulative += callback.buckets[i];
+      const auto bound = std::chrono::duration<double>(CallbackMetrics::k_bucketBounds[i]).count();
+      writer.sample("vanch_callback_duration_seconds_bucket", fmt::format("{},le=\"{}\"", kind, bound), cumulative);
+    }
+
+    writer.sample("vanch_callback_duration_seconds_bucket", kind + ",le=\"+Inf\"", callback.count);
+    writer.sample("vanch_callback_duration_seconds_sum", kind, std::chrono::duration<double>(callback.sum).count());
+    writer.sample("vanch_callback_duration_seconds_count", kind, callback.count);
+  }
+
+  writer.family("vanch_io_thread_busy_seconds_total", "counter", "CPU time consumed by an I/O thread.");
+  for (size_t i = 0; i < snapshot.ioThreads.size(); ++i) {
+    const auto& thread = snapshot.ioThreads[i];
+    writer.sample("vanch_io_thread_busy_seconds_total", fmt::format("thread=\"{}\",cpu=\"{}\"", i, thread.cpu),
+                  std::chrono::duration<double>(thread.busyTime).count());
+  }
+
+  return writer.take();
+}
+
+}  // namespace vanch
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "callbackmetrics.h"
+#include "vanch/readersession.h"
+
+namespace vanch {
+
+struct ReaderMetrics {
+  std::string reader;  // "ip:port"
+  ReaderSessionStats stats;
+};
+
+struct IoThreadMetrics {
+  int cpu{-1};  // Pinned CPU, or -1
+  std::chrono::nanoseconds busyTime{};
+};
+
+// Everything the metrics endpoint and panel show, read without stopping any I/O. Which readers and threads exist is
+// only known to the owner of the client or fleet, so it adds them; the process-wide callback histograms are filled
+// by captureMetrics().
+struct MetricsSnapshot {
+  std::vector<ReaderMetrics> readers;
+  std::vector<IoThreadMetrics> ioThreads;
+  std::array<CallbackLatency, k_callbackKindCount> callbacks;
+};
+
+[[nodiscard]] MetricsSnapshot captureMetrics();
+
+// Prometheus text exposition format, version 0.0.4.
+[[nodiscard]] std::string formatPrometheus(const MetricsSnapshot& snapshot);
+
+}  // namespace vanch
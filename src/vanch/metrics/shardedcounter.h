@@ -0,0 +1,46 @@
+#pragma once
+
+namespace vanch {
+
+inline constexpr size_t k_counterShards{16};
+
+// Shard of the calling thread. Threads take shards round robin on first use, so up to k_counterShards threads
+// never write to the same cache line.
+inline size_t getCounterShard() {
+  static std::atomic<size_t> s_nextShard{0};
+  thread_local const size_t shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % k_counterShards;
+  return shard;
+}
+
+// N counters that are incremented from many threads and read rarely. Every thread adds to its own shard, so an
+// increment is an uncontended relaxed add; a read sums the shards and may miss increments still in flight.
+template <size_t N>
+class ShardedCounters {
+ public:
+  void add(const size_t index, const uint64_t value = 1) {
+    m_shards[getCounterShard()].values[index].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t load(const size_t index) const {
+    uint64_t sum = 0;
+    for (const auto& shard : m_shards) sum += shard.values[index].load(std::memory_order_relaxed);
+    return sum;
+  }
+
+  [[nodiscard]] std::array<uint64_t, N> loadAll() const {
+    std::array<uint64_t, N> sums{};
+    for (const auto& shard : m_shards) {
+      for (size_t i = 0; i < N; ++i) sums[i] += shard.values[i].load(std::memory_order_relaxed);
+    }
+    return sums;
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, N> values{};
+  };
+
+  std::array<Shard, k_counterShards> m_shards;
+};
+
+}  // namespace vanch
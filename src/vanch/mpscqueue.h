@@ -0,0 +1,80 @@
+#pragma once
+
+namespace vanch {
+
+// Bounded lock-free queue for many producers and a single consumer, after Dmitry Vyukov's bounded MPMC ring. Each
+// cell carries a sequence number that tells producers whether it is free and the consumer whether it is filled, so
+// neither side ever blocks; a push into a full queue fails instead.
+template <typename T>
+class MpscQueue {
+ public:
+  explicit MpscQueue(const size_t capacity)
+      : m_capacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+        m_mask(m_capacity - 1),
+        m_cells(std::make_unique<Cell[]>(m_capacity)) {
+    for (size_t i = 0; i < m_capacity; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  bool tryPush(T&& value) {
+    auto position = m_tail.load(std::memory_order_relaxed);
+
+    while (true) {
+      auto& cell = m_cells[position & m_mask];
+      const auto sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Must only be called from the consumer thread.
+  bool tryPop(T& out) {
+    const auto position = m_head.load(std::memory_order_relaxed);
+    auto& cell = m_cells[position & m_mask];
+
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) return false;
+
+    out = std::move(cell.value);
+    cell.value = T{};  // Do not keep references alive until the cell is reused
+    cell.sequence.store(position + m_capacity, std::memory_order_release);
+    m_head.store(position + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  [[nodiscard]] size_t sizeApprox() const {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    const auto head = m_head.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  size_t m_capacity;
+  size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+
+  alignas(64) std::atomic<size_t> m_tail{0};
+  alignas(64) std::atomic<size_t> m_head{0};
+};
+
+}  // namespace vanch
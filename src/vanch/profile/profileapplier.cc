@@ -0,0 +1,445 @@
+#include "profileapplier.h"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "vanch/messageregistry.h"
+
+namespace vanch {
+
+namespace {
+
+// Each setting pairs a Get command with the Set command that takes the same value: how to build both, how to pull
+// the value out of the return and how to show it in the report.
+
+struct OutputPowerSetting {
+  using Value = uint8_t;
+
+  uint8_t antenna{0};
+
+  [[nodiscard]] std::shared_ptr<CmdGetOutputPower> makeGet() const {
+    auto command = std::make_shared<CmdGetOutputPower>();
+    command->antennaNumber = antenna;
+    return command;
+  }
+
+  [[nodiscard]] std::shared_ptr<CmdSetOutputPower> makeSet(const Value& value) const {
+    auto command = std::make_shared<CmdSetOutputPower>();
+    command->antennaNumber = antenna;
+    command->powerValue = value;
+    return command;
+  }
+
+  static Value getValue(const RetGetOutputPower& ret) { return ret.powerValue; }
+
+  static std::string describe(const Value& value) { return fmt::format("{} dBm", value); }
+};
+
+struct PollingAntennasSetting {
+  using Value = std::vector<uint8_t>;
+
+  static std::shared_ptr<CmdGetAutoPollingAntenna> makeGet() { return std::make_shared<CmdGetAutoPollingAntenna>(); }
+
+  static std::shared_ptr<CmdSetAutoPollingAntenna> makeSet(const Value& value) {
+    auto command = std::make_shared<CmdSetAutoPollingAntenna>();
+    command->antennas = value;
+    return command;
+  }
+
+  static Value getValue(const RetGetAutoPollingAntenna& ret) { return ret.antennas; }
+
+  static std::string describe(const Value& value) { return fmt::format("{}", fmt::join(value, ", ")); }
+};
+
+struct ReportingFieldsSetting {
+  using Value = ReportingFieldsSettings;
+
+  static std::shared_ptr<CmdGetAutoReportingFields> makeGet() { return std::make_shared<CmdGetAutoReportingFields>(); }
+
+  static std::shared_ptr<CmdSetAutoReportingFields> makeSet(const Value& value) {
+    auto command = std::make_shared<CmdSetAutoReportingFields>();
+    command->fieldBitmap = value.fieldBitmap;
+    command->tidStartAddress = value.tidStartAddress;
+    command->tidLength = value.tidLength;
+    command->userStartAddress = value.userStartAddress;
+    command->userLength = value.userLength;
+    return command;
+  }
+
+  static Value getValue(const RetGetAutoReportingFields& ret) {
+    return {
+        .fieldBitmap = ret.fieldBitmap,
+        .tidStartAddress = ret.tidStartAddress,
+        .tidLength = ret.tidLength,
+        .userStartAddress = ret.userStartAddress,
+        .userLength = ret.userLength,
+    };
+  }
+
+  static std::string describe(const Value& value) {
+    return fmt::format("fields 0x{:08X}, TID {}+{}, user {}+{}", value.fieldBitmap, value.tidStartAddress,
+                       value.tidLength, value.userStartAddress, value.userLength);
+  }
+};
+
+struct ReportingConditionsSetting {
+  using Value = ReportingConditionsSettings;
+
+  static std::shared_ptr<CmdGetAutoReportingConditions> makeGet() {
+    return std::make_shared<CmdGetAutoReportingConditions>();
+  }
+
+  static std::shared_ptr<CmdSetAutoReportingConditions> makeSet(const Value& value) {
+    auto command = std::make_shared<CmdSetAutoReportingConditions>();
+    command->reportingMode = value.mode;
+    command->reportingInterval = value.interval;
+    return command;
+  }
+
+  static Value getValue(const RetGetAutoReportingConditions& ret) {
+    return {.mode = ret.reportingMode, .interval = ret.reportingInterval};
+  }
+
+  static std::string describe(const Value& value) {
+    return fmt::format("mode {}, every {} s", value.mode, value.interval);
+  }
+};
+
+std::string describeTagMask(const TagMaskSettings& value) {
+  return fmt::format("{}, {} bytes at {}: {:02X}", value.enabled ? "on" : "off", value.maskLength, value.maskAddress,
+                     fmt::join(value.mask, ""));
+}
+
+// The tag filter and the tag alarm only differ in their command codes
+template <typename GetCmd, typename SetCmd>
+struct TagMaskSetting {
+  using Value = TagMaskSettings;
+
+  static std::shared_ptr<GetCmd> makeGet() { return std::make_shared<GetCmd>(); }
+
+  static std::shared_ptr<SetCmd> makeSet(const Value& value) {
+    auto command = std::make_shared<SetCmd>();
+    command->isEnabled = value.enabled;
+    command->maskAddress = value.maskAddress;
+    command->maskLength = value.maskLength;
+    command->maskData = value.mask;
+    return command;
+  }
+
+  static Value getValue(const ReturnOf_t<GetCmd>& ret) {
+    return {
+        .enabled = ret.isEnabled != 0,
+        .maskAddress = ret.maskAddress,
+        .maskLength = ret.maskLength,
+        .mask = ret.maskData,
+    };
+  }
+
+  static std::string describe(const Value& value) { return describeTagMask(value); }
+};
+
+using TagFilterSetting = TagMaskSetting<CmdGetTagFilter, CmdSetTagFilter>;
+using TagAlarmSetting = TagMaskSetting<CmdGetTagAlarm, CmdSetTagAlarm>;
+
+struct HeartbeatSetting {
+  using Value = HeartbeatSettings;
+
+  static std::shared_ptr<CmdGetHeartbeatPacket> makeGet() { return std::make_shared<CmdGetHeartbeatPacket>(); }
+
+  static std::shared_ptr<CmdSetHeartbeatPacket> makeSet(const Value& value) {
+    auto command = std::make_shared<CmdSetHeartbeatPacket>();
+    command->isEnabled = value.enabled;
+    command->interval = value.interval;
+    command->heartbeatData = value.data;
+    return command;
+  }
+
+  static Value getValue(const RetGetHeartbeatPacket& ret) {
+    return {.enabled = ret.isEnabled != 0, .interval = ret.interval, .data = ret.heartbeatData};
+  }
+
+  static std::string describe(const Value& value) {
+    return fmt::format("{}, every {} s, \"{}\"", value.enabled ? "on" : "off", value.interval, value.data);
+  }
+};
+
+struct RemoteServerSetting {
+  using Value = RemoteServerSettings;
+
+  static std::shared_ptr<CmdGetRJ45RemoteParams> makeGet() { return std::make_shared<CmdGetRJ45RemoteParams>(); }
+
+  static std::shared_ptr<CmdSetRJ45RemoteParams> makeSet(const Value& value) {
+    auto command = std::make_shared<CmdSetRJ45RemoteParams>();
+    command->udpServerIP = value.udpIp;
+    command->udpServerPort = value.udpPort;
+    command->udpEnabled = value.udpEnabled;
+    command->tcpServerIP = value.tcpIp;
+    command->tcpServerPort = value.tcpPort;
+    command->tcpEnabled = value.tcpEnabled;
+    return command;
+  }
+
+  static Value getValue(const RetGetRJ45RemoteParams& ret) {
+    return {
+        .udpIp = ret.udpServerIP,
+        .udpPort = ret.udpServerPort,
+        .udpEnabled = ret.udpEnabled != 0,
+        .tcpIp = ret.tcpServerIP,
+        .tcpPort = ret.tcpServerPort,
+        .tcpEnabled = ret.tcpEnabled != 0,
+    };
+  }
+
+  static std::string describe(const Value& value) {
+    return fmt::format("UDP {}:{} {}, TCP {}:{} {}", fmt::join(value.udpIp, "."), value.udpPort,
+                       value.udpEnabled ? "on" : "off", fmt::join(value.tcpIp, "."), value.tcpPort,
+                       value.tcpEnabled ? "on" : "off");
+  }
+};
+
+// One setting of the profile on one reader, type-erased so a reader's settings go through the same two passes
+struct SettingCheck {
+  SettingResult result;
+
+  // Reads the reader's value into the result and prepares the write if it differs from the profile
+  std::function<asio::awaitable<void>(ReaderSession&, const RequestOptions&, SettingCheck&)> read;
+
+  // Sends the profile's value; empty while no write is needed
+  std::function<asio::awaitable<void>(ReaderSession&, const RequestOptions&, SettingResult&)> write;
+};
+
+template <typename Setting>
+asio::awaitable<void> writeSetting(ReaderSession& session, const RequestOptions options, const Setting setting,
+                                   const typename Setting::Value value, SettingResult& result) {
+  const auto written = co_await session.request(setting.makeSet(value), options);
+
+  result.outcome = written.ok() ? SettingOutcome::Changed : SettingOutcome::WriteFailed;
+  result.status = written.status;
+  result.errorCode = written.errorCode;
+}
+
+template <typename Setting>
+asio::awaitable<void> readSetting(ReaderSession& session, const RequestOptions options, const Setting setting,
+                                  const typename Setting::Value desired, SettingCheck& check) {
+  const auto read = co_await session.request(setting.makeGet(), options);
+
+  check.result.status = read.status;
+  check.result.errorCode = read.errorCode;
+
+  if (!read.ok() || !read.response) {
+    check.result.outcome = SettingOutcome::ReadFailed;
+    co_return;
+  }
+
+  const auto current = Setting::getValue(*read.response);
+  check.result.current = Setting::describe(current);
+
+  if (current == desired) {
+    check.result.outcome = SettingOutcome::Unchanged;
+    co_return;
+  }
+
+  check.result.outcome = SettingOutcome::WouldChange;
+  check.write = [setting, desired](ReaderSession& session, const RequestOptions& options, SettingResult& result) {
+    return writeSetting(session, options, setting, desired, result);
+  };
+}
+
+template <typename Setting>
+SettingCheck makeCheck(std::string name, const Setting setting, typename Setting::Value desired) {
+  SettingCheck check;
+  check.result.name = std::move(name);
+  check.result.desired = Setting::describe(desired);
+  check.read = [setting, desired = std::move(desired)](ReaderSession& session, const RequestOptions& options,
+                                                      SettingCheck& check) {
+    return readSetting(session, options, setting, desired, check);
+  };
+  return check;
+}
+
+std::vector<SettingCheck> makeChecks(const ReaderProfile& profile) {
+  std::vector<SettingCheck> checks;
+
+  for (const auto& [antenna, power] : profile.outputPower) {
+    checks.push_back(makeCheck(fmt::format("outputPower.{}", antenna), OutputPowerSetting{antenna}, power));
+  }
+  if (profile.pollingAntennas) {
+    checks.push_back(makeCheck("pollingAntennas", PollingAntennasSetting{}, *profile.pollingAntennas));
+  }
+  if (profile.reportingFields) {
+    checks.push_back(makeCheck("reportingFields", ReportingFieldsSetting{}, *profile.reportingFields));
+  }
+  if (profile.reportingConditions) {
+    checks.push_back(makeCheck("reportingConditions", ReportingConditionsSetting{}, *profile.reportingConditions));
+  }
+  if (profile.tagFilter) checks.push_back(makeCheck("tagFilter", TagFilterSetting{}, *profile.tagFilter));
+  if (profile.tagAlarm) checks.push_back(makeCheck("tagAlarm", TagAlarmSetting{}, *profile.tagAlarm));
+  if (profile.heartbeat) checks.push_back(makeCheck("heartbeat", HeartbeatSetting{}, *profile.heartbeat));
+  if (profile.remoteServer) checks.push_back(makeCheck("remoteServer", RemoteServerSetting{}, *profile.remoteServer));
+
+  return checks;
+}
+
+std::string_view describeFailure(const SettingResult& setting) {
+  if (setting.status == RequestStatus::DeviceError) return MessageRegistry::getErrorMessage(setting.errorCode);
+  return getRequestStatusName(setting.status);
+}
+
+// Reads every setting, then writes the ones that differ. Each pass is pipelined through the session's request window;
+// the writes only start once every read is back, so no Get can observe a Set of the same rollout.
+asio::awaitable<void> checkReader(TaskGroup& group, ReaderSession& session, const RequestOptions& request,
+                                  const bool dryRun, std::vector<SettingCheck>& checks) {
+  for (auto& check : checks) {
+    co_await group.launch([&session, &request, &check]() { return check.read(session, request, check); });
+  }
+  co_await group.wait();
+
+  if (dryRun) co_return;
+
+  for (auto& check : checks) {
+    if (!check.write) continue;
+    co_await group.launch([&session, &request, &check]() { return check.write(session, request, check.result); });
+  }
+  co_await group.wait();
+}
+
+}  // namespace
+
+const char* getSettingOutcomeName(const SettingOutcome outcome) {
+  switch (outcome) {
+    case SettingOutcome::Unchanged:
+      return "Unchanged";
+    case SettingOutcome::Changed:
+      return "Changed";
+    case SettingOutcome::WouldChange:
+      return "WouldChange";
+    case SettingOutcome::ReadFailed:
+      return "ReadFailed";
+    case SettingOutcome::WriteFailed:
+      return "WriteFailed";
+  }
+  return "Unknown";
+}
+
+ProfileApplier::ProfileApplier() : Loggable("ProfileApplier") {}
+
+asio::awaitable<std::vector<ReaderProfileResult>> ProfileApplier::apply(
+    const ReaderProfile profile, const std::vector<std::shared_ptr<ReaderSession>> readers,
+    const ProfileApplyOptions options) {
+  m_finished = 0;
+
+  TaskGroup group(co_await asio::this_coro::executor, options.concurrency);
+  co_return co_await co_spawn(group.getStrand(), run(group, profile, readers, options), asio::use_awaitable);
+}
+
+asio::awaitable<std::vector<ReaderProfileResult>> ProfileApplier::run(
+    TaskGroup& group, const ReaderProfile& profile, const std::vector<std::shared_ptr<ReaderSession>>& readers,
+    const ProfileApplyOptions& options) {
+  const auto started = std::chrono::steady_clock::now();
+  std::vector<ReaderProfileResult> results(readers.size());
+
+  logger->info("Applying profile '{}' with {} settings to {} readers{}", profile.name, profile.getSettingCount(),
+               readers.size(), options.dryRun ? " (dry run)" : "");
+
+  for (size_t i = 0; i < readers.size(); ++i) {
+    co_await group.launch([this, &profile, &options, &session = *readers[i],
+                           &result = results[i]]() -> asio::awaitable<void> {
+      result = co_await applyTo(profile, session, options);
+      ++m_finished;
+    });
+  }
+
+  co_await group.wait();
+
+  const auto failedReaders = std::ranges::count_if(results, [](const auto& result) { return !result.ok(); });
+  const auto changedReaders = std::ranges::count_if(results, [](const auto& result) { return result.changed > 0; });
+
+  logger->info("Profile '{}' {} {} of {} readers, {} failed, in {} ms", profile.name,
+               options.dryRun ? "would change" : "changed", changedReaders, readers.size(), failedReaders,
+               std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started)
+                   .count());
+
+  co_return results;
+}
+
+asio::awaitable<ReaderProfileResult> ProfileApplier::applyTo(const ReaderProfile& profile, ReaderSession& session,
+                                                             const ProfileApplyOptions& options) {
+  const auto started = std::chrono::steady_clock::now();
+  const RequestOptions request{
+      .timeout = options.timeout,
+      .retries = options.retries,
+      .priority = CommandPriority::Bulk,
+      .waitForSpace = true,
+  };
+
+  auto checks = makeChecks(profile);
+
+  // Every setting at once; the session's request window paces them
+  TaskGroup group(co_await asio::this_coro::executor, checks.size());
+  co_await co_spawn(group.getStrand(), checkReader(group, session, request, options.dryRun, checks),
+                    asio::use_awaitable);
+
+  ReaderProfileResult result;
+  result.reader = session.getEndpoint();
+
+  for (auto& check : checks) {
+    auto& setting = check.result;
+
+    if (setting.failed()) {
+      ++result.failed;
+      logger->warn("{}:{}: {} {} failed: {}", session.getEndpoint().address().to_string(),
+                   session.getEndpoint().port(), setting.outcome == SettingOutcome::ReadFailed ? "Reading" : "Writing",
+                   setting.name, describeFailure(setting));
+    } else if (setting.outcome == SettingOutcome::Unchanged) {
+      ++result.unchanged;
+    } else {
+      ++result.changed;
+    }
+
+    result.settings.push_back(std::move(setting));
+  }
+
+  result.elapsed = std::chrono::steady_clock::now() - started;
+  co_return result;
+}
+
+nlohmann::json makeProfileReport(const std::span<const ReaderProfileResult> results) {
+  auto report = nlohmann::json::array();
+
+  for (const auto& result : results) {
+    auto settings = nlohmann::json::array();
+
+    for (const auto& setting : result.settings) {
+      nlohmann::json entry = {
+          {"name", setting.name},
+          {"outcome", getSettingOutcomeName(setting.outcome)},
+          {"current", setting.current},
+          {"desired", setting.desired},
+      };
+
+      if (setting.failed()) {
+        entry["status"] = getRequestStatusName(setting.status);
+        if (setting.status == RequestStatus::DeviceError) {
+          entry["errorCode"] = setting.errorCode;
+        }
+        entry["error"] = describeFailure(setting);
+      }
+
+      settings.push_back(std::move(entry));
+    }
+
+    report.push_back({
+        {"reader", fmt::format("{}:{}", result.reader.address().to_string(), result.reader.port())},
+        {"ok", result.ok()},
+        {"changed", result.changed},
+        {"unchanged", result.unchanged},
+        {"failed", result.failed},
+        {"elapsedMs", std::chrono::duration_cast<std::chrono::milliseconds>(result.elapsed).count()},
+        {"settings", std::move(settings)},
+    });
+  }
+
+  return report;
+}
+
+}  // namespace vanch
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "krog/util/loggable.h"
+#include "readerprofile.h"
+#include "vanch/readersession.h"
+#include "vanch/taskgroup.h"
+
+namespace vanch {
+
+enum class SettingOutcome : uint8_t {
+  Unchanged,    // The reader already had the profile's value
+  Changed,      // Sent and accepted
+  WouldChange,  // Differs, but nothing is sent on a dry run
+  ReadFailed,
+  WriteFailed,
+};
+
+const char* getSettingOutcomeName(SettingOutcome outcome);
+
+struct SettingResult {
+  std::string name;  // Profile key, with the antenna for output power: "outputPower.2"
+  SettingOutcome outcome{SettingOutcome::ReadFailed};
+  RequestStatus status{RequestStatus::Cancelled};  // Of the failed request
+  uint8_t errorCode{0xFF};                         // Set when status is DeviceError
+  std::string current;                             // As read from the reader
+  std::string desired;
+
+  [[nodiscard]] bool failed() const {
+    return outcome == SettingOutcome::ReadFailed || outcome == SettingOutcome::WriteFailed;
+  }
+};
+
+struct ReaderProfileResult {
+  asio::ip::udp::endpoint reader;
+  std::vector<SettingResult> settings;  // In profile order
+  size_t changed{0};                    // Changed, or would change on a dry run
+  size_t unchanged{0};
+  size_t failed{0};
+  std::chrono::steady_clock::duration elapsed{};
+
+  [[nodiscard]] bool ok() const { return failed == 0; }
+};
+
+struct ProfileApplyOptions {
+  size_t concurrency{16};  // Readers being configured at once
+  bool dryRun{false};      // Compare only and report what would change
+  std::chrono::milliseconds timeout{1000};
+  uint8_t retries{1};  // Per command, after a timeout
+};
+
+// Rolls a profile out to many readers. Each reader first gets every Get command the profile needs, pipelined through
+// its request window, and then only the Set commands whose value differs from what came back, so a reader that is
+// already configured sees no write at all and a rerun after a partial failure only touches what is still wrong.
+// Settings whose Get fails are not written, since nothing says they need it.
+//
+// Up to the concurrency limit of readers are worked on at once, in the order given. All commands use the bulk lane,
+// so a rollout does not hold up interactive commands to the same readers.
+class ProfileApplier final : kr::Loggable {
+ public:
+  ProfileApplier();
+
+  // Results are in the order of the readers.
+  asio::awaitable<std::vector<ReaderProfileResult>> apply(ReaderProfile profile,
+                                                          std::vector<std::shared_ptr<ReaderSession>> readers,
+                                                          ProfileApplyOptions options = {});
+
+  // Readers finished by the running apply, for progress reporting from other threads
+  [[nodiscard]] size_t getFinishedCount() const { return m_finished; }
+
+ private:
+  asio::awaitable<std::vector<ReaderProfileResult>> run(TaskGroup& group, const ReaderProfile& profile,
+                                                        const std::vector<std::shared_ptr<ReaderSession>>& readers,
+                                                        const ProfileApplyOptions& options);
+
+  // Reads every setting of the profile from one reader, then writes the ones that differ.
+  asio::awaitable<ReaderProfileResult> applyTo(const ReaderProfile& profile, ReaderSession& session,
+                                               const ProfileApplyOptions& options);
+
+  std::atomic<size_t> m_finished{0};
+};
+
+// Outcome of every setting per reader, with current and desired values, for an audit trail of the rollout.
+nlohmann::json makeProfileReport(std::span<const ReaderProfileResult> results);
+
+}  // namespace vanch
@@ -0,0 +1,271 @@
+#include "readerprofile.h"
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <nlohmann/json.hpp>
+
+#include "vanch/asiotypes.h"
+#include "vanch/tagid.h"
+
+namespace vanch {
+
+namespace {
+
+using nlohmann::json;
+
+std::string joinPath(const std::string_view path, const std::string_view key) {
+  return path.empty() ? std::string(key) : fmt::format("{}.{}", path, key);
+}
+
+// Reads a profile document, keeping only the first problem so the settings can be read without a check after every
+// field.
+class ProfileReader {
+ public:
+  explicit ProfileReader(std::string& error) : m_error(error) {}
+
+  [[nodiscard]] bool ok() const { return m_error.empty(); }
+
+  void fail(const std::string_view path, const std::string_view problem) {
+    if (ok()) m_error = path.empty() ? std::string(problem) : fmt::format("{}: {}", path, problem);
+  }
+
+  // Whether the value is an object with no keys but the given ones
+  bool expectObject(const json& value, const std::string_view path,
+                    const std::initializer_list<std::string_view> keys) {
+    if (!value.is_object()) {
+      fail(path, "expected an object");
+      return false;
+    }
+
+    for (const auto& [key, field] : value.items()) {
+      if (std::ranges::find(keys, std::string_view(key)) == keys.end()) {
+        fail(joinPath(path, key), "unknown key");
+        return false;
+      }
+    }
+
+    return ok();
+  }
+
+  template <std::unsigned_integral T>
+  void read(const json& value, const std::string_view path, T& out) {
+    if (!value.is_number_unsigned() || value.get<uint64_t>() > std::numeric_limits<T>::max()) {
+      fail(path, fmt::format("expected an integer from 0 to {}", uint64_t{std::numeric_limits<T>::max()}));
+      return;
+    }
+    out = static_cast<T>(value.get<uint64_t>());
+  }
+
+  void read(const json& value, const std::string_view path, bool& out) {
+    if (!value.is_boolean()) return fail(path, "expected true or false");
+    out = value.get<bool>();
+  }
+
+  void read(const json& value, const std::string_view path, std::string& out) {
+    if (!value.is_string()) return fail(path, "expected a string");
+    out = value.get<std::string>();
+  }
+
+  void read(const json& value, const std::string_view path, std::array<uint8_t, 4>& out) {
+    asio::error_code ec;
+    const auto address = value.is_string() ? asio::ip::make_address_v4(value.get<std::string>(), ec)
+                                           : asio::ip::address_v4{};
+    if (!value.is_string() || ec) return fail(path, "expected an IPv4 address");
+    out = address.to_bytes();
+  }
+
+  void readHex(const json& value, const std::string_view path, std::vector<uint8_t>& out) {
+    const auto* hex = value.get_ptr<const std::string*>();
+    TagId bytes;
+    if (!hex || !bytes.assignHex(*hex)) return fail(path, "expected a hex string");
+    out.assign(bytes.bytes().begin(), bytes.bytes().end());
+  }
+
+  // Leaves out untouched if the object has no such key
+  template <typename T>
+  void readField(const json& object, const std::string_view path, const std::string_view key, T& out) {
+    if (const auto it = object.find(key); it != object.end()) read(*it, joinPath(path, key), out);
+  }
+
+  std::map<uint8_t, uint8_t> readOutputPower(const json& value) {
+    std::map<uint8_t, uint8_t> power;
+    if (!value.is_object()) {
+      fail("outputPower", "expected an object of dBm by antenna number");
+      return power;
+    }
+
+    for (const auto& [key, dbm] : value.items()) {
+      unsigned antenna = 0;
+      const auto [end, ec] = std::from_chars(key.data(), key.data() + key.size(), antenna);
+      if (ec != std::errc{} || end != key.data() + key.size() || antenna < 1 || antenna > 255) {
+        fail(joinPath("outputPower", key), "expected an antenna number from 1 to 255");
+        break;
+      }
+      read(dbm, joinPath("outputPower", key), power[static_cast<uint8_t>(antenna)]);
+    }
+
+    return power;
+  }
+
+  std::vector<uint8_t> readAntennas(const json& value) {
+    std::vector<uint8_t> antennas;
+    if (!value.is_array() || value.empty()) {
+      fail("pollingAntennas", "expected a non-empty array of antenna numbers");
+      return antennas;
+    }
+
+    for (const auto& antenna : value) {
+      const auto path = fmt::format("pollingAntennas[{}]", antennas.size());
+      read(antenna, path, antennas.emplace_back());
+    }
+
+    return antennas;
+  }
+
+  ReportingFieldsSettings readReportingFields(const json& value) {
+    constexpr std::string_view path = "reportingFields";
+    ReportingFieldsSettings fields;
+    if (!expectObject(value, path, {"fieldBitmap", "tidStartAddress", "tidLength", "userStartAddress", "userLength"})) {
+      return fields;
+    }
+
+    readField(value, path, "fieldBitmap", fields.fieldBitmap);
+    readField(value, path, "tidStartAddress", fields.tidStartAddress);
+    readField(value, path, "tidLength", fields.tidLength);
+    readField(value, path, "userStartAddress", fields.userStartAddress);
+    readField(value, path, "userLength", fields.userLength);
+    return fields;
+  }
+
+  ReportingConditionsSettings readReportingConditions(const json& value) {
+    constexpr std::string_view path = "reportingConditions";
+    ReportingConditionsSettings conditions;
+    if (!expectObject(value, path, {"mode", "interval"})) return conditions;
+
+    readField(value, path, "mode", conditions.mode);
+    readField(value, path, "interval", conditions.interval);
+    return conditions;
+  }
+
+  TagMaskSettings readTagMask(const json& value, const std::string_view path) {
+    TagMaskSettings mask;
+    if (!expectObject(value, path, {"enabled", "maskAddress", "mask"})) return mask;
+
+    readField(value, path, "enabled", mask.enabled);
+    readField(value, path, "maskAddress", mask.maskAddress);
+    if (const auto it = value.find("mask"); it != value.end()) readHex(*it, joinPath(path, "mask"), mask.mask);
+
+    if (mask.mask.size() > std::numeric_limits<uint8_t>::max()) fail(joinPath(path, "mask"), "too long");
+    mask.maskLength = static_cast<uint8_t>(mask.mask.size());
+    return mask;
+  }
+
+  HeartbeatSettings readHeartbeat(const json& value) {
+    constexpr std::string_view path = "heartbeat";
+    HeartbeatSettings heartbeat;
+    if (!expectObject(value, path, {"enabled", "interval", "data"})) return heartbeat;
+
+    readField(value, path, "enabled", heartbeat.enabled);
+    readField(value, path, "interval", heartbeat.interval);
+    readField(value, path, "data", heartbeat.data);
+    return heartbeat;
+  }
+
+  RemoteServerSettings readRemoteServer(const json& value) {
+    constexpr std::string_view path = "remoteServer";
+    RemoteServerSettings server;
+    if (!expectObject(value, path, {"udp", "tcp"})) return server;
+
+    const auto readServer = [this, &value, path](const std::string_view key, std::array<uint8_t, 4>& ip,
+                                                 uint16_t& port, bool& enabled) {
+      const auto it = value.find(key);
+      const auto serverPath = joinPath(path, key);
+      if (it == value.end() || !expectObject(*it, serverPath, {"ip", "port", "enabled"})) return;
+
+      readField(*it, serverPath, "ip", ip);
+      readField(*it, serverPath, "port", port);
+      readField(*it, serverPath, "enabled", enabled);
+    };
+
+    readServer("udp", server.udpIp, server.udpPort, server.udpEnabled);
+    readServer("tcp", server.tcpIp, server.tcpPort, server.tcpEnabled);
+    return server;
+  }
+
+ private:
+  std::string& m_error;
+};
+
+}  // namespace
+
+size_t ReaderProfile::getSettingCount() const {
+  return outputPower.size() + pollingAntennas.has_value() + reportingFields.has_value() +
+         reportingConditions.has_value() + tagFilter.has_value() + tagAlarm.has_value() + heartbeat.has_value() +
+         remoteServer.has_value();
+}
+
+bool parseReaderProfile(const std::string_view text, ReaderProfile& profile, std::string& error) {
+  error.clear();
+
+  const auto document = json::parse(text, nullptr, false);
+  if (document.is_discarded()) {
+    error = "Not a valid JSON document";
+    return false;
+  }
+
+  ProfileReader reader(error);
+  ReaderProfile parsed;
+
+  if (!reader.expectObject(document, "", {"name", "outputPower", "pollingAntennas", "reportingFields",
+                                          "reportingConditions", "tagFilter", "tagAlarm", "heartbeat",
+                                          "remoteServer"})) {
+    return false;
+  }
+
+  reader.readField(document, "", "name", parsed.name);
+
+  if (const auto it = document.find("outputPower"); it != document.end()) {
+    parsed.outputPower = reader.readOutputPower(*it);
+  }
+  if (const auto it = document.find("pollingAntennas"); it != document.end()) {
+    parsed.pollingAntennas = reader.readAntennas(*it);
+  }
+  if (const auto it = document.find("reportingFields"); it != document.end()) {
+    parsed.reportingFields = reader.readReportingFields(*it);
+  }
+  if (const auto it = document.find("reportingConditions"); it != document.end()) {
+    parsed.reportingConditions = reader.readReportingConditions(*it);
+  }
+  if (const auto it = document.find("tagFilter"); it != document.end()) {
+    parsed.tagFilter = reader.readTagMask(*it, "tagFilter");
+  }
+  if (const auto it = document.find("tagAlarm"); it != document.end()) {
+    parsed.tagAlarm = reader.readTagMask(*it, "tagAlarm");
+  }
+  if (const auto it = document.find("heartbeat"); it != document.end()) {
+    parsed.heartbeat = reader.readHeartbeat(*it);
+  }
+  if (const auto it = document.find("remoteServer"); it != document.end()) {
+    parsed.remoteServer = reader.readRemoteServer(*it);
+  }
+
+  if (reader.ok() && parsed.getSettingCount() == 0) reader.fail("", "The profile names no setting");
+  if (!reader.ok()) return false;
+
+  profile = std::move(parsed);
+  return true;
+}
+
+bool loadReaderProfile(const std::filesystem::path& path, ReaderProfile& profile, std::string& error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    error = fmt::format("Could not open {}", path.string());
+    return false;
+  }
+
+  const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  return parseReaderProfile(text, profile, error);
+}
+
+}  // namespace vanch
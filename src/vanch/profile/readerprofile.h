@@ -0,0 +1,91 @@
+#pragma once
+
+namespace vanch {
+
+struct ReportingFieldsSettings {
+  uint32_t fieldBitmap{0};
+  uint8_t tidStartAddress{0};
+  uint8_t tidLength{0};
+  uint8_t userStartAddress{0};
+  uint8_t userLength{0};
+
+  bool operator==(const ReportingFieldsSettings&) const = default;
+};
+
+struct ReportingConditionsSettings {
+  uint8_t mode{0};
+  uint8_t interval{0};  // Seconds
+
+  bool operator==(const ReportingConditionsSettings&) const = default;
+};
+
+// Layout shared by the tag filter and the tag alarm
+struct TagMaskSettings {
+  bool enabled{false};
+  uint8_t maskAddress{0};
+  uint8_t maskLength{0};  // Taken from the mask when read from a profile
+  std::vector<uint8_t> mask;
+
+  bool operator==(const TagMaskSettings&) const = default;
+};
+
+struct HeartbeatSettings {
+  bool enabled{false};
+  uint8_t interval{0};  // Seconds
+  std::string data;
+
+  bool operator==(const HeartbeatSettings&) const = default;
+};
+
+// Servers the reader reports to, from the RJ45 remote network parameters
+struct RemoteServerSettings {
+  std::array<uint8_t, 4> udpIp{};
+  uint16_t udpPort{0};
+  bool udpEnabled{false};
+  std::array<uint8_t, 4> tcpIp{};
+  uint16_t tcpPort{0};
+  bool tcpEnabled{false};
+
+  bool operator==(const RemoteServerSettings&) const = default;
+};
+
+// Reader settings to roll out to a fleet. Only the settings a profile names are compared and applied; the rest stay
+// as each reader has them. Per-device settings such as the reader's own address have no place in a profile.
+//
+// Profiles are JSON objects, for example:
+//
+//   {
+//     "name": "Dock doors",
+//     "outputPower": {"1": 30, "2": 30},
+//     "pollingAntennas": [1, 2],
+//     "reportingFields": {"fieldBitmap": 3, "tidStartAddress": 0, "tidLength": 6},
+//     "reportingConditions": {"mode": 1, "interval": 5},
+//     "tagFilter": {"enabled": true, "maskAddress": 0, "mask": "E280"},
+//     "tagAlarm": {"enabled": false},
+//     "heartbeat": {"enabled": true, "interval": 10, "data": "dock"},
+//     "remoteServer": {"udp": {"ip": "10.0.0.5", "port": 1969, "enabled": true}, "tcp": {"enabled": false}}
+//   }
+//
+// Fields left out of a setting's object are zero, false or empty, since the reader always takes a setting whole.
+struct ReaderProfile {
+  std::string name;
+  std::map<uint8_t, uint8_t> outputPower;  // dBm by antenna number
+  std::optional<std::vector<uint8_t>> pollingAntennas;
+  std::optional<ReportingFieldsSettings> reportingFields;
+  std::optional<ReportingConditionsSettings> reportingConditions;
+  std::optional<TagMaskSettings> tagFilter;
+  std::optional<TagMaskSettings> tagAlarm;
+  std::optional<HeartbeatSettings> heartbeat;
+  std::optional<RemoteServerSettings> remoteServer;
+
+  // Number of Get/Set pairs the profile covers
+  [[nodiscard]] size_t getSettingCount() const;
+};
+
+// Returns false and describes the first problem, with its location in the document, if the text is not a valid
+// profile. Unknown keys are rejected so that a misspelt setting is not silently left alone.
+bool parseReaderProfile(std::string_view text, ReaderProfile& profile, std::string& error);
+
+bool loadReaderProfile(const std::filesystem::path& path, ReaderProfile& profile, std::string& error);
+
+}  // namespace vanch
@@ -0,0 +1,166 @@
+#include "readerfleet.h"
+
+namespace vanch {
+
+ReaderFleet::ReaderFleet(asio::io_context& io, const uint16_t localPort)
+    : Loggable("ReaderFleet"), m_io(io), m_socket(io), m_localPort(localPort) {}
+
+ReaderFleet::~ReaderFleet() { stop(); }
+
+bool ReaderFleet::start() {
+  if (m_isRunning) return true;
+
+  asio::error_code ec;
+
+  m_socket.open(asio::ip::udp::v4(), ec);
+
+  if (ec) {
+    logger->error("Failed to open fleet socket: {}", ec.message());
+    return false;
+  }
+
+  m_socket.bind(asio::ip::udp::endpoint(asio::ip::udp::v4(), m_localPort), ec);
+
+  if (ec) {
+    logger->error("Failed to bind port {} for fleet socket: {}", m_localPort, ec.message());
+    m_socket.close();
+    return false;
+  }
+
+  // Hundreds of readers answering at once must not overflow the default receive buffer
+  m_socket.set_option(asio::socket_base::receive_buffer_size(4 * 1024 * 1024), ec);
+  m_socket.non_blocking(true, ec);
+
+  logger->info("Fleet socket port: {}", m_socket.local_endpoint().port());
+
+  m_isRunning = true;
+
+  for (const auto& session : getReaders()) session->start();
+
+  co_spawn(m_io, listenLoop(), asio::detached);
+  return true;
+}
+
+void ReaderFleet::stop() {
+  if (!m_isRunning) return;
+
+  logger->info("Stopping fleet");
+
+  m_isRunning = false;
+
+  for (const auto& session : getReaders()) session->stop();
+
+  m_socket.close();
+}
+
+std::shared_ptr<ReaderSession> ReaderFleet::addReader(const asio::ip::udp::endpoint& endpoint) {
+  if (!endpoint.address().is_v4()) {
+    logger->error("Reader {} is not an IPv4 endpoint", endpoint.address().to_string());
+    return nullptr;
+  }
+
+  std::shared_ptr<ReaderSession> session;
+
+  {
+    std::unique_lock lock(m_sessionsMutex);
+
+    auto& slot = m_sessions[makeKey(endpoint)];
+    if (slot) return slot;
+
+    slot = std::make_shared<ReaderSession>(m_socket, endpoint);
+    session = slot;
+  }
+
+  if (m_isRunning) session->start();
+  return session;
+}
+
+void ReaderFleet::removeReader(const asio::ip::udp::endpoint& endpoint) {
+  if (!endpoint.address().is_v4()) return;
+
+  std::shared_ptr<ReaderSession> session;
+
+  {
+    std::unique_lock lock(m_sessionsMutex);
+
+    const auto it = m_sessions.find(makeKey(endpoint));
+    if (it == m_sessions.end()) return;
+
+    session = std::move(it->second);
+    m_sessions.erase(it);
+  }
+
+  session->stop();
+}
+
+std::shared_ptr<ReaderSession> ReaderFleet::findReader(const asio::ip::udp::endpoint& endpoint) const {
+  if (!endpoint.address().is_v4()) return nullptr;
+
+  std::shared_lock lock(m_sessionsMutex);
+
+  const auto it = m_sessions.find(makeKey(endpoint));
+  return it != m_sessions.end() ? it->second : nullptr;
+}
+
+std::vector<std::shared_ptr<ReaderSession>> ReaderFleet::getReaders() const {
+  std::shared_lock lock(m_sessionsMutex);
+
+  std::vector<std::shared_ptr<ReaderSession>> readers;
+  readers.reserve(m_sessions.size());
+
+  for (const auto& session : m_sessions | std::views::values) readers.push_back(session);
+
+  return readers;
+}
+
+size_t ReaderFleet::getReaderCount() const {
+  std::shared_lock lock(m_sessionsMutex);
+  return m_sessions.size();
+}
+
+asio::awaitable<void> ReaderFleet::listenLoop() {
+  DatagramBatch batch{k_receiveBatchSize};
+
+  while (m_isRunning) {
+    auto [waitEc] = co_await m_socket.async_wait(asio::socket_base::wait_read);
+
+    if (waitEc) {
+      if (waitEc == asio::error::operation_aborted && !m_isRunning) break;
+      logger->error("Error receiving responses: {}", waitEc.message());
+      continue;
+    }
+
+    asio::error_code ec;
+    batch.receive(m_socket, ec);
+
+    if (ec) {
+      // An unreachable reader surfaces as an error on the shared socket without telling which one it was
+      if (ec != asio::error::connection_refused && ec != asio::error::connection_reset) {
+        logger->error("Error receiving responses: {}", ec.message());
+      }
+      continue;
+    }
+
+    handleDatagrams(batch);
+  }
+}
+
+void ReaderFleet::handleDatagrams(const DatagramBatch& batch) {
+  std::shared_lock lock(m_sessionsMutex);
+
+  // Sessions decode and run callbacks on their own strands, so the index lock is never held by a callback
+  for (const auto& datagram : batch.datagrams()) {
+    if (!datagram.endpoint.address().is_v4()) continue;
+
+    const auto it = m_sessions.find(makeKey(datagram.endpoint));
+
+    if (it == m_sessions.end()) {
+      m_unknownDatagrams.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    it->second->receive(datagram.data);
+  }
+}
+
+}  // namespace vanch
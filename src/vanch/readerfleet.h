@@ -0,0 +1,61 @@
+#pragma once
+
+#include "asiotypes.h"
+#include "datagrambatch.h"
+#include "krog/util/loggable.h"
+#include "readersession.h"
+
+namespace vanch {
+
+// Talks to many readers over a single socket. Incoming datagrams are routed to the session of their source
+// endpoint through a hash index, so each reader keeps its own command queue, request window, callbacks and stats.
+// Readers are addressed over IPv4 only.
+class ReaderFleet final : kr::Loggable {
+ public:
+  explicit ReaderFleet(asio::io_context& io, uint16_t localPort = 0);
+
+  ~ReaderFleet() override;
+
+  bool isRunning() const { return m_isRunning; }
+
+  bool start();
+
+  void stop();
+
+  // Returns the session for the endpoint, creating it if needed. New sessions start with the fleet.
+  std::shared_ptr<ReaderSession> addReader(const asio::ip::udp::endpoint& endpoint);
+
+  void removeReader(const asio::ip::udp::endpoint& endpoint);
+
+  [[nodiscard]] std::shared_ptr<ReaderSession> findReader(const asio::ip::udp::endpoint& endpoint) const;
+
+  [[nodiscard]] std::vector<std::shared_ptr<ReaderSession>> getReaders() const;
+
+  [[nodiscard]] size_t getReaderCount() const;
+
+  // Datagrams from endpoints that belong to no session
+  [[nodiscard]] uint64_t getUnknownDatagramCount() const { return m_unknownDatagrams; }
+
+ private:
+  static uint64_t makeKey(const asio::ip::udp::endpoint& endpoint) {
+    return (static_cast<uint64_t>(endpoint.address().to_v4().to_uint()) << 16) | endpoint.port();
+  }
+
+  asio::awaitable<void> listenLoop();
+
+  void handleDatagrams(const DatagramBatch& batch);
+
+  static constexpr size_t k_receiveBatchSize{64};
+
+  asio::io_context& m_io;
+  udp_socket m_socket;
+  uint16_t m_localPort;
+
+  mutable std::shared_mutex m_sessionsMutex;
+  std::unordered_map<uint64_t, std::shared_ptr<ReaderSession>> m_sessions;
+
+  std::atomic<uint64_t> m_unknownDatagrams{0};
+  std::atomic_bool m_isRunning{false};
+};
+
+}  // namespace vanch
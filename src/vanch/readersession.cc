@@ -0,0 +1,297 @@
+#include "readersession.h"
+
+#include "messageregistry.h"
+#include "metrics/callbackmetrics.h"
+
+namespace vanch {
+
+ReaderSession::ReaderSession(udp_socket& socket, const asio::ip::udp::endpoint& endpoint)
+    : Loggable("ReaderSession"),
+      m_socket(socket),
+      m_endpoint(endpoint),
+      m_strand(socket.get_executor()),
+      m_commandQueue(m_strand, k_commandLaneCapacity),
+      m_requests(m_strand, k_defaultRequestWindow) {}
+
+ReaderSession::~ReaderSession() { stop(); }
+
+void ReaderSession::setEndpoint(const asio::ip::udp::endpoint& endpoint) {
+  if (m_isRunning) {
+    logger->error("Cannot change the endpoint of a running session");
+    return;
+  }
+
+  m_endpoint = endpoint;
+  m_decoder.reset();
+}
+
+void ReaderSession::start() {
+  if (m_isRunning) return;
+
+  m_isRunning = true;
+
+  // A previous stop() closed the queue and cancelled whatever was still in it
+  asio::post(m_strand, [self = shared_from_this()] { self->m_commandQueue.open(); });
+
+  co_spawn(m_strand, [self = shared_from_this()] { return self->sendLoop(); }, asio::detached);
+}
+
+void ReaderSession::stop() {
+  if (!m_isRunning) return;
+
+  m_isRunning = false;
+
+  asio::post(m_strand, [self = weak_from_this()] {
+    if (const auto session = self.lock()) {
+      session->m_commandQueue.close();
+      session->m_requests.cancelAll();
+    }
+  });
+}
+
+void ReaderSession::sendCommand(const std::shared_ptr<IMessage>& command,
+                                const std::optional<CommandPriority> priority) {
+  if (!m_isRunning) {
+    logger->warn("Could not enqueue command for {}:{}. Session is stopped!", m_endpoint.address().to_string(),
+                 m_endpoint.port());
+    return;
+  }
+
+  co_spawn(
+      m_strand,
+      [self = shared_from_this(), command, priority] { return self->execute(command, {.priority = priority}); },
+      asio::detached);
+}
+
+void ReaderSession::setRequestWindow(const size_t window) {
+  const auto clamped = std::clamp<size_t>(window, 1, k_maxRequestWindow);
+  asio::post(m_strand, [self = shared_from_this(), clamped] { self->m_requests.setWindow(clamped); });
+}
+
+void ReaderSession::receive(const std::span<const uint8_t> datagram) {
+  m_datagramsReceived.fetch_add(1, std::memory_order_relaxed);
+  m_bytesReceived.fetch_add(datagram.size(), std::memory_order_relaxed);
+
+  if (const auto capture = m_capture.load()) {
+    capture->record(FrameDirection::Inbound, CaptureChannel::Session, m_endpoint, datagram);
+  }
+
+  if (!enqueue(datagram)) m_droppedDatagrams.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ReaderSession::inject(const std::span<const uint8_t> datagram) { return enqueue(datagram); }
+
+bool ReaderSession::enqueue(const std::span<const uint8_t> datagram) {
+  {
+    std::lock_guard lock(m_inboxMutex);
+
+    if (m_inboxSize >= k_inboxCapacity) return false;
+
+    if (m_inboxSize == m_inbox.size()) m_inbox.emplace_back();
+    m_inbox[m_inboxSize++].assign(datagram.begin(), datagram.end());
+
+    // The rest of a batch joins the drain that is already scheduled
+    if (m_drainScheduled) return true;
+    m_drainScheduled = true;
+  }
+
+  asio::post(m_strand, [self = shared_from_this()] { self->drainInbox(); });
+  return true;
+}
+
+void ReaderSession::drainInbox() {
+  size_t count{};
+
+  {
+    std::lock_guard lock(m_inboxMutex);
+    std::swap(m_inbox, m_draining);
+    count = m_inboxSize;
+    m_inboxSize = 0;
+    m_drainScheduled = false;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    m_decoder.feedDatagram(m_draining[i], [this](const std::span<const uint8_t> frame) {
+      if (auto message = MessageRegistry::createFromData(frame)) {
+        m_received.push_back(std::move(message));
+      } else {
+        m_unknownMessages.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  const auto& decoderStats = m_decoder.getStats();
+  m_noiseBytes.store(decoderStats.droppedBytes, std::memory_order_relaxed);
+  m_badLength.store(decoderStats.badLength, std::memory_order_relaxed);
+  m_badChecksum.store(decoderStats.badChecksum, std::memory_order_relaxed);
+
+  dispatchReceived();
+}
+
+void ReaderSession::dispatchReceived() {
+  if (m_received.empty()) return;
+
+  m_framesReceived.fetch_add(m_received.size(), std::memory_order_relaxed);
+
+  // Settle awaiting requests first; the callbacks still see every response, matched or not
+  for (const auto& message : m_received) {
+    if (message->getType() != MessageType_Status && !m_requests.complete(message)) {
+      m_unsolicited.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  for (const auto& message : m_received) dispatchResponse(message);
+
+  // Drop our references so pooled messages can be recycled as soon as consumers release them
+  m_received.clear();
+}
+
+void ReaderSession::reportError(const std::string_view error, const uint8_t code) {
+  m_errorSubscribers.publish(error, code);
+}
+
+ReaderSessionStats ReaderSession::getStats() const {
+  return {
+      .framesSent = m_framesSent.load(std::memory_order_relaxed),
+      .framesReceived = m_framesReceived.load(std::memory_order_relaxed),
+      .datagramsReceived = m_datagramsReceived.load(std::memory_order_relaxed),
+      .bytesSent = m_bytesSent.load(std::memory_order_relaxed),
+      .bytesReceived = m_bytesReceived.load(std::memory_order_relaxed),
+      .unsolicited = m_unsolicited.load(std::memory_order_relaxed),
+      .droppedDatagrams = m_droppedDatagrams.load(std::memory_order_relaxed),
+      .sendErrors = m_sendErrors.load(std::memory_order_relaxed),
+      .noiseBytes = m_noiseBytes.load(std::memory_order_relaxed),
+      .badLength = m_badLength.load(std::memory_order_relaxed),
+      .badChecksum = m_badChecksum.load(std::memory_order_relaxed),
+      .unknownMessages = m_unknownMessages.load(std::memory_order_relaxed),
+      .queue = m_commandQueue.getStats(),
+  };
+}
+
+asio::awaitable<RequestResult<IMessage>> ReaderSession::execute(std::shared_ptr<IMessage> command,
+                                                                const RequestOptions options) {
+  RequestResult<IMessage> result;
+  const auto priority = options.priority.value_or(getDefaultPriority(command->getCmdCode()));
+
+  for (uint8_t attempt = 0; attempt <= options.retries; ++attempt) {
+    if (!m_isRunning) break;
+
+    const auto request = std::make_shared<PendingRequest>(m_strand, command, options.timeout, priority);
+    const bool isQueued =
+        options.waitForSpace ? co_await m_commandQueue.push(request) : m_commandQueue.tryPush(request);
+
+    if (!isQueued) {
+      if (m_isRunning) {
+        logger->warn("Dropped {} (0x{:02x}): the {} lane of the command queue is full", command->getMessageName(),
+                     command->getCmdCode(), getCommandPriorityName(priority));
+      }
+      m_latencies.record(request->cmdCode, RequestStatus::Cancelled, {}, attempt > 0);
+      break;
+    }
+
+    // The deadline is armed once the send loop admits the request to the window, which wakes this wait once
+    while (request->status == RequestStatus::Pending) {
+      if (const auto [ec] = co_await request->signal.async_wait(); !ec) break;
+    }
+
+    if (request->status == RequestStatus::Pending) m_requests.finish(request, RequestStatus::Timeout);
+
+    m_latencies.record(request->cmdCode, request->status, request->getLatency(), attempt > 0);
+
+    result.status = request->status;
+    result.response = request->response;
+    result.errorCode = request->errorCode;
+    result.attempts = static_cast<uint8_t>(attempt + 1);
+    result.latency = request->getLatency();
+
+    if (result.status != RequestStatus::Timeout) break;
+
+    logger->warn("{} (0x{:02x}) to {}:{} timed out after {} ms", command->getMessageName(), command->getCmdCode(),
+                 m_endpoint.address().to_string(), m_endpoint.port(), options.timeout.count());
+  }
+
+  co_return result;
+}
+
+asio::awaitable<void> ReaderSession::sendLoop() {
+  while (m_isRunning) {
+    // Sleeps until a command is queued; stop() closes the queue to end the loop
+    const auto request = co_await m_commandQueue.pop();
+
+    if (!request) break;
+
+    // A bulk request taken just before an urgent one arrived still goes first, but only that one
+    co_await m_requests.waitForSlot(request->priority == CommandPriority::Urgent ? k_urgentReserve : 0);
+
+    if (!m_isRunning) {
+      request->settle(RequestStatus::Cancelled);
+      break;
+    }
+
+    m_requests.track(request);
+
+    const auto buffer = m_sendBuffers.acquire();
+    const auto size = request->command->serializeInto(buffer.span());
+
+    if (size == 0) {
+      m_requests.finish(request, RequestStatus::Cancelled);
+      reportError("Command does not fit into a single frame");
+      continue;
+    }
+
+    // Sessions share the socket across threads, and synchronous send_to is the operation asio allows concurrently
+    asio::error_code ec;
+    m_socket.send_to(asio::buffer(buffer.data(), size), m_endpoint, 0, ec);
+
+    // The send buffer of the non-blocking socket can be full for a moment under load
+    for (int retry = 0; ec == asio::error::would_block && retry < k_sendRetryCount; ++retry) {
+      steady_timer backoff{m_strand, std::chrono::milliseconds(1)};
+      co_await backoff.async_wait();
+      m_socket.send_to(asio::buffer(buffer.data(), size), m_endpoint, 0, ec);
+    }
+
+    if (ec) {
+      m_requests.finish(request, RequestStatus::Cancelled);
+      m_sendErrors.fetch_add(1, std::memory_order_relaxed);
+      reportError("Failed to send command: " + ec.message());
+      continue;
+    }
+
+    if (const auto capture = m_capture.load()) {
+      capture->record(FrameDirection::Outbound, CaptureChannel::Session, m_endpoint, buffer.span().first(size));
+    }
+
+    request->sentAt = std::chrono::steady_clock::now();
+    m_framesSent.fetch_add(1, std::memory_order_relaxed);
+    m_bytesSent.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
+void ReaderSession::dispatchResponse(const std::shared_ptr<IMessage>& message) {
+  const auto start = std::chrono::steady_clock::now();
+
+  if (message->getType() == MessageType_Return) {
+    m_returnSubscribers.publish(message);
+    CallbackMetrics::record(CallbackKind::Return, std::chrono::steady_clock::now() - start);
+    return;
+  }
+
+  if (message->getType() == MessageType_Status) {
+    m_statusSubscribers.publish(message);
+    CallbackMetrics::record(CallbackKind::Status, std::chrono::steady_clock::now() - start);
+    return;
+  }
+
+  if (message->getType() == MessageType_Error) {
+    const auto code = static_cast<const Error&>(*message).errorCode;
+    m_errorSubscribers.publish(MessageRegistry::getErrorMessage(code), code);
+    m_returnSubscribers.publish(message);
+    CallbackMetrics::record(CallbackKind::Error, std::chrono::steady_clock::now() - start);
+    return;
+  }
+
+  logger->warn("Cannot handle packet with header 0x{:02x} and code 0x{:02x}", static_cast<uint8_t>(message->getType()),
+               message->getCmdCode());
+}
+
+}  // namespace vanch
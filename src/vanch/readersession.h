@@ -0,0 +1,178 @@
+#pragma once
+
+#include "asiotypes.h"
+#include "bufferpool.h"
+#include "capture/framecapture.h"
+#include "commandlatency.h"
+#include "commandqueue.h"
+#include "framedecoder.h"
+#include "krog/util/loggable.h"
+#include "message.h"
+#include "requesttracker.h"
+#include "subscriberlist.h"
+
+namespace vanch {
+
+struct ReaderSessionStats {
+  uint64_t framesSent{0};
+  uint64_t framesReceived{0};
+  uint64_t datagramsReceived{0};
+  uint64_t bytesSent{0};
+  uint64_t bytesReceived{0};
+  uint64_t unsolicited{0};       // Returns and errors that matched no outstanding request
+  uint64_t droppedDatagrams{0};  // Received while the inbox was full
+  uint64_t sendErrors{0};
+
+  // Decode failures by reason. Noise counts bytes skipped while resynchronising; unknown messages are well-formed
+  // frames that no registered message accepts.
+  uint64_t noiseBytes{0};
+  uint64_t badLength{0};
+  uint64_t badChecksum{0};
+  uint64_t unknownMessages{0};
+
+  CommandQueueStats queue;
+};
+
+// Per-reader state behind a socket owned by a UdpClient or a ReaderFleet: the command queue and send loop, request
+// tracking, frame decoding and callbacks. The owner reads the socket and hands over the datagrams that came from
+// this reader's endpoint. All work of a session runs on its own strand, so sessions proceed in parallel on a
+// multi-threaded context while each reader's responses keep their order.
+class ReaderSession final : public std::enable_shared_from_this<ReaderSession>, kr::Loggable {
+ public:
+  using MessageSubscribers = SubscriberList<const std::shared_ptr<IMessage>&>;
+  using ErrorSubscribers = SubscriberList<std::string_view, uint8_t>;
+
+  ReaderSession(udp_socket& socket, const asio::ip::udp::endpoint& endpoint);
+
+  ~ReaderSession() override;
+
+  [[nodiscard]] const asio::ip::udp::endpoint& getEndpoint() const { return m_endpoint; }
+
+  // Must only be called while the session is stopped.
+  void setEndpoint(const asio::ip::udp::endpoint& endpoint);
+
+  [[nodiscard]] bool isRunning() const { return m_isRunning; }
+
+  void start();
+
+  void stop();
+
+  // Queues a command whose response is only delivered through the callbacks. Waits for space in its lane of the
+  // command queue rather than dropping it.
+  void sendCommand(const std::shared_ptr<IMessage>& command, std::optional<CommandPriority> priority = {});
+
+  // Queues a command and resumes once its return, a device error, the timeout or a stop settles it. May be awaited
+  // from any coroutine; use asio::co_spawn with asio::use_future to wait from a plain thread.
+  template <typename Cmd>
+  asio::awaitable<RequestResult<ReturnOf_t<Cmd>>> request(std::shared_ptr<Cmd> command, RequestOptions options = {}) {
+    const auto self = shared_from_this();
+    const auto result =
+        co_await asio::co_spawn(m_strand, execute(std::move(command), options), asio::use_awaitable);
+
+    co_return RequestResult<ReturnOf_t<Cmd>>{
+        .status = result.status,
+        .response = std::dynamic_pointer_cast<ReturnOf_t<Cmd>>(result.response),
+        .errorCode = result.errorCode,
+        .attempts = result.attempts,
+        .latency = result.latency,
+    };
+  }
+
+  // Limits how many commands may await their response at once. Readers process commands in order, so a larger
+  // window hides the round trip without reordering anything. Urgent commands may use one slot beyond the window, so
+  // they never wait for a bulk response to come back.
+  void setRequestWindow(size_t window);
+
+  // Returns and device errors, whether or not they settled a request
+  MessageSubscribers& onReturn() { return m_returnSubscribers; }
+
+  MessageSubscribers& onStatus() { return m_statusSubscribers; }
+
+  // Device errors with their code, and transport errors with code 0xFF
+  ErrorSubscribers& onError() { return m_errorSubscribers; }
+
+  // Copies a datagram from this reader into the inbox, which is decoded and dispatched on the session strand. Safe
+  // to call from the owner's receive loop on any thread.
+  void receive(std::span<const uint8_t> datagram);
+
+  // Feeds a datagram through decoding and dispatch as if it had been received, without capturing it. Returns false
+  // while the inbox is full so a replay can wait instead of losing data.
+  bool inject(std::span<const uint8_t> datagram);
+
+  // Records every datagram sent to and received from the reader; pass nullptr to stop.
+  void setCapture(std::shared_ptr<FrameCapture> capture) { m_capture.store(std::move(capture)); }
+
+  void reportError(std::string_view error, uint8_t code = 0xFF);
+
+  [[nodiscard]] ReaderSessionStats getStats() const;
+
+  // Round-trip latencies of every attempt, per command code
+  [[nodiscard]] std::vector<CommandLatency> getLatencies() const { return m_latencies.snapshot(); }
+
+  void resetLatencies() { m_latencies.reset(); }
+
+ private:
+  asio::awaitable<RequestResult<IMessage>> execute(std::shared_ptr<IMessage> command, RequestOptions options);
+
+  asio::awaitable<void> sendLoop();
+
+  bool enqueue(std::span<const uint8_t> datagram);
+
+  void drainInbox();
+
+  // Settles awaiting requests and invokes the callbacks for everything decoded from the inbox.
+  void dispatchReceived();
+
+  void dispatchResponse(const std::shared_ptr<IMessage>& message);
+
+  static constexpr size_t k_sendBufferCount{4};
+  static constexpr size_t k_commandLaneCapacity{32};
+  static constexpr size_t k_maxRequestWindow{32};
+  static constexpr size_t k_defaultRequestWindow{8};
+  static constexpr size_t k_urgentReserve{1};
+  static constexpr size_t k_inboxCapacity{256};
+  static constexpr int k_sendRetryCount{10};
+
+  udp_socket& m_socket;
+  asio::ip::udp::endpoint m_endpoint;
+  asio::strand<asio::any_io_executor> m_strand;
+
+  CommandQueue m_commandQueue;
+  RequestTracker m_requests;
+  CommandLatencyRecorder m_latencies;
+  BufferPool m_sendBuffers{k_sendBufferCount};
+  FrameDecoder m_decoder;
+  std::vector<std::shared_ptr<IMessage>> m_received;
+
+  // Datagrams are copied because the owner reuses its receive buffers for the next batch. Both vectors keep their
+  // buffers across drains.
+  std::mutex m_inboxMutex;
+  std::vector<std::vector<uint8_t>> m_inbox;
+  std::vector<std::vector<uint8_t>> m_draining;
+  size_t m_inboxSize{0};
+  bool m_drainScheduled{false};
+
+  std::atomic_bool m_isRunning{false};
+  std::atomic<std::shared_ptr<FrameCapture>> m_capture;
+
+  std::atomic<uint64_t> m_framesSent{0};
+  std::atomic<uint64_t> m_framesReceived{0};
+  std::atomic<uint64_t> m_datagramsReceived{0};
+  std::atomic<uint64_t> m_bytesSent{0};
+  std::atomic<uint64_t> m_bytesReceived{0};
+  std::atomic<uint64_t> m_unsolicited{0};
+  std::atomic<uint64_t> m_droppedDatagrams{0};
+  std::atomic<uint64_t> m_sendErrors{0};
+
+  // Mirrors of the decoder stats, which only the strand may read
+  std::atomic<uint64_t> m_noiseBytes{0};
+  std::atomic<uint64_t> m_badLength{0};
+  std::atomic<uint64_t> m_badChecksum{0};
+  std::atomic<uint64_t> m_unknownMessages{0};
+
+  MessageSubscribers m_returnSubscribers;
+  MessageSubscribers m_statusSubscribers;
+  ErrorSubscribers m_errorSubscribers;
+};
+
+}  // namespace vanch
@@ -0,0 +1,80 @@
+#include "requesttracker.h"
+
+namespace vanch {
+
+PendingRequest::PendingRequest(const asio::any_io_executor& executor, std::shared_ptr<IMessage> command,
+                               const std::chrono::milliseconds timeout, const CommandPriority priority)
+    : command(std::move(command)),
+      cmdCode(this->command->getCmdCode()),
+      timeout(timeout),
+      priority(priority),
+      queuedAt(std::chrono::steady_clock::now()),
+      signal(executor, steady_timer::time_point::max()) {}
+
+void PendingRequest::settle(const RequestStatus result) {
+  status = result;
+  completedAt = std::chrono::steady_clock::now();
+  signal.cancel();
+}
+
+RequestTracker::RequestTracker(const asio::any_io_executor& executor, const size_t window)
+    : m_window(std::max<size_t>(window, 1)), m_slotSignal(executor, steady_timer::time_point::max()) {}
+
+void RequestTracker::setWindow(const size_t window) {
+  m_window = std::max<size_t>(window, 1);
+  m_slotSignal.cancel();
+}
+
+asio::awaitable<void> RequestTracker::waitForSlot(const size_t reserve) {
+  // Every settled request wakes one waiter, but whoever resumes first takes the slot, so check again
+  while (m_pending.size() >= m_window + reserve) {
+    co_await m_slotSignal.async_wait();
+  }
+}
+
+void RequestTracker::track(const std::shared_ptr<PendingRequest>& request) {
+  m_pending.push_back(request);
+
+  // Wakes the awaiting request once, which then waits again for the new deadline
+  request->signal.expires_after(request->timeout);
+}
+
+bool RequestTracker::complete(const std::shared_ptr<IMessage>& response) {
+  const auto cmdCode = response->getCmdCode();
+  const auto it =
+      std::ranges::find_if(m_pending, [cmdCode](const auto& request) { return request->cmdCode == cmdCode; });
+
+  if (it == m_pending.end()) return false;
+
+  const auto& request = *it;
+  request->response = response;
+
+  if (response->getType() == MessageType_Error) {
+    request->errorCode = static_cast<const Error&>(*response).errorCode;
+    settle(it, RequestStatus::DeviceError);
+  } else {
+    settle(it, RequestStatus::Ok);
+  }
+
+  return true;
+}
+
+void RequestTracker::finish(const std::shared_ptr<PendingRequest>& request, const RequestStatus status) {
+  if (const auto it = std::ranges::find(m_pending, request); it != m_pending.end()) settle(it, status);
+}
+
+void RequestTracker::cancelAll() {
+  while (!m_pending.empty()) settle(m_pending.begin(), RequestStatus::Cancelled);
+  m_slotSignal.cancel();
+}
+
+void RequestTracker::settle(const std::deque<std::shared_ptr<PendingRequest>>::iterator it,
+                            const RequestStatus status) {
+  const auto request = *it;
+  m_pending.erase(it);
+  request->settle(status);
+
+  m_slotSignal.cancel_one();
+}
+
+}  // namespace vanch
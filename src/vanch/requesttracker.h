@@ -0,0 +1,126 @@
+#pragma once
+
+#include "asiotypes.h"
+#include "commands/command.h"
+#include "message.h"
+
+namespace vanch {
+
+enum class RequestStatus : uint8_t {
+  Pending,
+  Ok,
+  DeviceError,
+  Timeout,
+  Cancelled,
+};
+
+constexpr const char* getRequestStatusName(const RequestStatus status) {
+  switch (status) {
+    case RequestStatus::Pending:
+      return "Pending";
+    case RequestStatus::Ok:
+      return "Ok";
+    case RequestStatus::DeviceError:
+      return "Device error";
+    case RequestStatus::Timeout:
+      return "Timeout";
+    case RequestStatus::Cancelled:
+      return "Cancelled";
+  }
+  return "Unknown";
+}
+
+// Lanes of the command queue, in the order they are served
+enum class CommandPriority : uint8_t {
+  Urgent,  // Interactive control such as relays and the buzzer
+  Normal,
+  Bulk,  // Tag block transfers and configuration sweeps
+};
+
+inline constexpr size_t k_commandPriorityCount{3};
+
+struct RequestOptions {
+  std::chrono::milliseconds timeout{1000};  // From admission to the request window, so queueing does not count
+  uint8_t retries{0};  // Additional attempts after a timeout; device errors are never retried
+  std::optional<CommandPriority> priority;  // Derived from the command code if not set
+  bool waitForSpace{true};                  // Otherwise a full lane cancels the request and counts as a drop
+};
+
+template <typename T>
+struct RequestResult {
+  RequestStatus status{RequestStatus::Cancelled};
+  std::shared_ptr<T> response;  // Set when status is Ok
+  uint8_t errorCode{0xFF};      // Set when status is DeviceError
+  uint8_t attempts{0};
+  std::chrono::steady_clock::duration latency{};  // Of the last attempt, from transmission to completion
+
+  [[nodiscard]] bool ok() const { return status == RequestStatus::Ok; }
+};
+
+// One transmission of a command, shared between the awaiting request, the command queue and the receive path.
+struct PendingRequest {
+  PendingRequest(const asio::any_io_executor& executor, std::shared_ptr<IMessage> command,
+                 std::chrono::milliseconds timeout, CommandPriority priority);
+
+  [[nodiscard]] std::chrono::steady_clock::duration getLatency() const {
+    return completedAt - sentAt.value_or(queuedAt);
+  }
+
+  // Records the outcome and wakes the awaiting request.
+  void settle(RequestStatus result);
+
+  std::shared_ptr<IMessage> command;
+  uint8_t cmdCode;
+  std::chrono::milliseconds timeout;
+  CommandPriority priority;
+
+  RequestStatus status{RequestStatus::Pending};
+  std::shared_ptr<IMessage> response;
+  uint8_t errorCode{0xFF};
+
+  std::chrono::steady_clock::time_point queuedAt;
+  std::optional<std::chrono::steady_clock::time_point> sentAt;
+  std::chrono::steady_clock::time_point completedAt;
+
+  // Never expires while queued. Admission to the window arms the deadline; settling cancels it.
+  steady_timer signal;
+};
+
+// Correlates returns and errors with outstanding commands. Readers answer in order and echo the command code, so
+// a response settles the oldest pending request with the same code. Limits the number of outstanding commands to
+// a window. Not thread-safe: must only be used from the client's I/O executor.
+class RequestTracker {
+ public:
+  RequestTracker(const asio::any_io_executor& executor, size_t window);
+
+  void setWindow(size_t window);
+
+  [[nodiscard]] size_t getWindow() const { return m_window; }
+
+  [[nodiscard]] size_t getInFlight() const { return m_pending.size(); }
+
+  // Resumes once fewer than window + reserve requests are outstanding.
+  asio::awaitable<void> waitForSlot(size_t reserve = 0);
+
+  // Admits a request to the window and starts its deadline.
+  void track(const std::shared_ptr<PendingRequest>& request);
+
+  // Settles the oldest request matching a return or error frame. Returns false for unsolicited responses.
+  bool complete(const std::shared_ptr<IMessage>& response);
+
+  // Removes a request that is still pending, e.g. after its deadline passed.
+  void finish(const std::shared_ptr<PendingRequest>& request, RequestStatus status);
+
+  void cancelAll();
+
+ private:
+  void settle(std::deque<std::shared_ptr<PendingRequest>>::iterator it, RequestStatus status);
+
+  std::deque<std::shared_ptr<PendingRequest>> m_pending;
+  size_t m_window;
+
+  // Never expires; cancelled to wake requests waiting for a free slot
+  steady_timer m_slotSignal;
+};
+
+}  // namespace vanch
@@ -0,0 +1,256 @@
+#include "readersimulator.h"
+
+namespace vanch {
+
+ReaderSimulator::Reader::Reader(asio::io_context& io, SimulatedReaderProfile profile)
+    : strand(asio::make_strand(io)),
+      socket(strand),
+      readTimer(strand),
+      heartbeatTimer(strand),
+      broadcastTimer(strand),
+      simulation(std::move(profile)) {}
+
+ReaderSimulator::ReaderSimulator(asio::io_context& io) : Loggable("ReaderSimulator"), m_io(io) {}
+
+ReaderSimulator::~ReaderSimulator() { stop(); }
+
+bool ReaderSimulator::start(const ReaderSimulatorOptions& options) {
+  if (m_isRunning) return true;
+
+  asio::error_code ec;
+  const auto address = asio::ip::make_address_v4(options.address, ec);
+
+  if (ec) {
+    logger->error("Invalid simulator address {}: {}", options.address, ec.message());
+    return false;
+  }
+
+  const auto broadcastAddress = asio::ip::make_address_v4(options.broadcastAddress, ec);
+
+  if (ec) {
+    logger->error("Invalid broadcast address {}: {}", options.broadcastAddress, ec.message());
+    return false;
+  }
+
+  if (options.basePort != 0 && options.basePort + options.readerCount - 1 > 65535) {
+    logger->error("{} readers do not fit above port {}", options.readerCount, options.basePort);
+    return false;
+  }
+
+  std::vector<std::shared_ptr<Reader>> readers;
+  readers.reserve(options.readerCount);
+
+  for (size_t i = 0; i < options.readerCount; ++i) {
+    const auto port = options.basePort == 0 ? uint16_t{0} : static_cast<uint16_t>(options.basePort + i);
+
+    auto reader = std::make_shared<Reader>(m_io, SimulatedReaderProfile{
+                                                     .index = static_cast<uint32_t>(i),
+                                                     .ipAddress = options.address,
+                                                     .port = port,
+                                                     .tagPopulation = options.tagPopulation,
+                                                     .heartbeatInterval = options.heartbeatInterval,
+                                                 });
+
+    reader->socket.open(asio::ip::udp::v4(), ec);
+    if (!ec) reader->socket.bind({address, port}, ec);
+
+    if (ec) {
+      logger->error("Failed to bind simulated reader {} to {}:{}: {}", i, options.address, port, ec.message());
+      return false;
+    }
+
+    reader->socket.set_option(asio::socket_base::broadcast(true), ec);
+    reader->socket.non_blocking(true, ec);
+    reader->endpoint = reader->socket.local_endpoint();
+    reader->statusEndpoint = options.statusEndpoint;
+
+    readers.push_back(std::move(reader));
+  }
+
+  m_readers = std::move(readers);
+  m_isRunning = true;
+
+  const asio::ip::udp::endpoint broadcastDestination{broadcastAddress, options.broadcastPort};
+
+  for (const auto& reader : m_readers) {
+    co_spawn(reader->strand, receiveLoop(reader), asio::detached);
+    if (options.readRate > 0.0) co_spawn(reader->strand, readLoop(reader, options.readRate), asio::detached);
+    co_spawn(reader->strand, heartbeatLoop(reader), asio::detached);
+
+    if (options.broadcastInterval.count() > 0) {
+      co_spawn(reader->strand, broadcastLoop(reader, broadcastDestination, options.broadcastInterval), asio::detached);
+    }
+  }
+
+  logger->info("Simulating {} readers on {}:{}", m_readers.size(), options.address,
+               m_readers.empty() ? 0 : m_readers.front()->endpoint.port());
+  return true;
+}
+
+void ReaderSimulator::stop() {
+  if (!m_isRunning) return;
+
+  logger->info("Stopping {} simulated readers", m_readers.size());
+
+  m_isRunning = false;
+
+  // Sockets and timers belong to the readers' strands, so they are closed there
+  for (const auto& reader : m_readers) {
+    asio::post(reader->strand, [reader] {
+      reader->isRunning = false;
+      reader->readTimer.cancel();
+      reader->heartbeatTimer.cancel();
+      reader->broadcastTimer.cancel();
+
+      asio::error_code ec;
+      reader->socket.close(ec);
+    });
+  }
+}
+
+std::vector<asio::ip::udp::endpoint> ReaderSimulator::getEndpoints() const {
+  std::vector<asio::ip::udp::endpoint> endpoints;
+  endpoints.reserve(m_readers.size());
+
+  for (const auto& reader : m_readers) endpoints.push_back(reader->endpoint);
+
+  return endpoints;
+}
+
+ReaderSimulatorStats ReaderSimulator::getStats() const {
+  ReaderSimulatorStats stats;
+
+  for (const auto& reader : m_readers) {
+    stats.commands += reader->commands.load(std::memory_order_relaxed);
+    stats.errors += reader->errors.load(std::memory_order_relaxed);
+    stats.reads += reader->reads.load(std::memory_order_relaxed);
+    stats.heartbeats += reader->heartbeats.load(std::memory_order_relaxed);
+    stats.broadcasts += reader->broadcasts.load(std::memory_order_relaxed);
+    stats.sendFailures += reader->sendFailures.load(std::memory_order_relaxed);
+  }
+
+  return stats;
+}
+
+asio::awaitable<void> ReaderSimulator::receiveLoop(const std::shared_ptr<Reader> reader) {
+  DatagramBatch batch{k_receiveBatchSize};
+  FrameDecoder decoder;
+
+  while (reader->isRunning) {
+    auto [waitEc] = co_await reader->socket.async_wait(asio::socket_base::wait_read);
+
+    if (waitEc) {
+      if (waitEc == asio::error::operation_aborted) break;
+      continue;
+    }
+
+    asio::error_code ec;
+    batch.receive(reader->socket, ec);
+
+    // Unreachable clients surface as receive errors on some platforms; they are not the reader's concern
+    if (ec) continue;
+
+    for (const auto& datagram : batch.datagrams()) {
+      reader->client = datagram.endpoint;
+
+      decoder.feedDatagram(datagram.data, [&](const std::span<const uint8_t> frame) {
+        const auto size = reader->simulation.handleCommand(frame, reader->sendBuffer);
+        if (size == 0) return;
+
+        reader->commands.fetch_add(1, std::memory_order_relaxed);
+        if (reader->sendBuffer[0] == MessageType_Error) reader->errors.fetch_add(1, std::memory_order_relaxed);
+
+        send(*reader, datagram.endpoint, size);
+      });
+    }
+  }
+}
+
+asio::awaitable<void> ReaderSimulator::readLoop(const std::shared_ptr<Reader> reader, const double rate) {
+  using clock = std::chrono::steady_clock;
+
+  // Readers start their ticks at different offsets so their reports do not arrive in lockstep
+  const auto phase = k_readTick * (reader->simulation.getProfile().index % 10) / 10;
+  reader->readTimer.expires_after(phase);
+  co_await reader->readTimer.async_wait();
+
+  auto last = clock::now();
+  double budget = 0.0;
+
+  while (reader->isRunning) {
+    reader->readTimer.expires_after(k_readTick);
+    if (auto [ec] = co_await reader->readTimer.async_wait(); ec) break;
+
+    const auto now = clock::now();
+
+    // A stalled tick does not turn into a burst larger than one second of reads
+    budget = std::min(budget + rate * std::chrono::duration<double>(now - last).count(), std::max(rate, 1.0));
+    last = now;
+
+    const auto destination = getStatusDestination(*reader);
+
+    for (; budget >= 1.0; budget -= 1.0) {
+      const auto size = reader->simulation.makeAutoRead(reader->sendBuffer);
+      if (size == 0 || !destination) continue;
+
+      if (send(*reader, *destination, size)) reader->reads.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+asio::awaitable<void> ReaderSimulator::heartbeatLoop(const std::shared_ptr<Reader> reader) {
+  while (reader->isRunning) {
+    // Commands may change the interval or disable heartbeats at any time
+    const auto interval = reader->simulation.getHeartbeatInterval();
+
+    if (interval.count() > 0) {
+      reader->heartbeatTimer.expires_after(interval);
+    } else {
+      reader->heartbeatTimer.expires_after(k_idleCheckInterval);
+    }
+
+    if (auto [ec] = co_await reader->heartbeatTimer.async_wait(); ec) break;
+
+    if (reader->simulation.getHeartbeatInterval().count() == 0) continue;
+
+    const auto destination = getStatusDestination(*reader);
+    if (!destination) continue;
+
+    const auto size = reader->simulation.makeHeartbeat(reader->sendBuffer);
+    if (size > 0 && send(*reader, *destination, size)) reader->heartbeats.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+asio::awaitable<void> ReaderSimulator::broadcastLoop(const std::shared_ptr<Reader> reader,
+                                                     const asio::ip::udp::endpoint destination,
+                                                     const std::chrono::milliseconds interval) {
+  while (reader->isRunning) {
+    const auto size = reader->simulation.makeBroadcast(reader->sendBuffer);
+    if (size > 0 && send(*reader, destination, size)) reader->broadcasts.fetch_add(1, std::memory_order_relaxed);
+
+    reader->broadcastTimer.expires_after(interval);
+    if (auto [ec] = co_await reader->broadcastTimer.async_wait(); ec) break;
+  }
+}
+
+std::optional<asio::ip::udp::endpoint> ReaderSimulator::getStatusDestination(const Reader& reader) {
+  if (const auto target = reader.simulation.getStatusTarget()) {
+    return asio::ip::udp::endpoint{asio::ip::address_v4(target->first), target->second};
+  }
+
+  return reader.client ? reader.client : reader.statusEndpoint;
+}
+
+bool ReaderSimulator::send(Reader& reader, const asio::ip::udp::endpoint& destination, const size_t size) {
+  asio::error_code ec;
+  reader.socket.send_to(asio::buffer(reader.sendBuffer.data(), size), destination, 0, ec);
+
+  if (ec) {
+    reader.sendFailures.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace vanch
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "krog/util/loggable.h"
+#include "simulatedreader.h"
+#include "vanch/asiotypes.h"
+#include "vanch/datagrambatch.h"
+#include "vanch/framedecoder.h"
+
+namespace vanch {
+
+struct ReaderSimulatorOptions {
+  std::string address{"127.0.0.1"};
+  uint16_t basePort{6000};  // Reader i listens on basePort + i; 0 lets the system pick every port
+  size_t readerCount{1};
+  uint32_t tagPopulation{100};
+  double readRate{10.0};         // Auto-reading statuses per second and reader, 0 disables them
+  uint8_t heartbeatInterval{1};  // Seconds, 0 disables heartbeats until a command enables them
+  std::chrono::milliseconds broadcastInterval{5000};  // 0 disables broadcasts
+  std::string broadcastAddress{"255.255.255.255"};
+  uint16_t broadcastPort{4444};
+  std::optional<asio::ip::udp::endpoint> statusEndpoint;  // Status destination until a client sends a command
+};
+
+struct ReaderSimulatorStats {
+  uint64_t commands{0};
+  uint64_t errors{0};  // Commands answered with an error frame
+  uint64_t reads{0};
+  uint64_t heartbeats{0};
+  uint64_t broadcasts{0};
+  uint64_t sendFailures{0};  // Datagrams the socket would not take, e.g. because its send buffer was full
+};
+
+// Runs simulated readers on an io_context, each with its own socket, so clients and fleets see the same addressing
+// as with real devices. A reader answers commands on its socket and sends its statuses to the remote UDP server of
+// its network parameters if one is enabled, otherwise to the last endpoint that sent it a command. All work of a
+// reader runs on its own strand, so a multi-threaded context spreads readers over its threads.
+class ReaderSimulator final : kr::Loggable {
+ public:
+  explicit ReaderSimulator(asio::io_context& io);
+
+  ~ReaderSimulator() override;
+
+  ReaderSimulator(const ReaderSimulator&) = delete;
+
+  ReaderSimulator& operator=(const ReaderSimulator&) = delete;
+
+  // Binds a socket per reader. Fails without starting any reader if one of the ports is taken.
+  bool start(const ReaderSimulatorOptions& options);
+
+  void stop();
+
+  [[nodiscard]] bool isRunning() const { return m_isRunning; }
+
+  // Command endpoints of the readers, in reader order. Stay available after stop, like the stats.
+  [[nodiscard]] std::vector<asio::ip::udp::endpoint> getEndpoints() const;
+
+  [[nodiscard]] ReaderSimulatorStats getStats() const;
+
+ private:
+  struct Reader {
+    Reader(asio::io_context& io, SimulatedReaderProfile profile);
+
+    asio::strand<asio::io_context::executor_type> strand;
+    udp_socket socket;
+    steady_timer readTimer;
+    steady_timer heartbeatTimer;
+    steady_timer broadcastTimer;
+    SimulatedReader simulation;
+    asio::ip::udp::endpoint endpoint;
+    std::optional<asio::ip::udp::endpoint> client;          // Last endpoint that sent a command
+    std::optional<asio::ip::udp::endpoint> statusEndpoint;  // From the options
+    std::array<uint8_t, k_maxFrameSize> sendBuffer{};
+    bool isRunning{true};
+
+    std::atomic<uint64_t> commands{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> heartbeats{0};
+    std::atomic<uint64_t> broadcasts{0};
+    std::atomic<uint64_t> sendFailures{0};
+  };
+
+  static constexpr size_t k_receiveBatchSize{16};
+  static constexpr auto k_readTick = std::chrono::milliseconds(10);
+  static constexpr auto k_idleCheckInterval = std::chrono::milliseconds(250);
+
+  asio::awaitable<void> receiveLoop(std::shared_ptr<Reader> reader);
+
+  asio::awaitable<void> readLoop(std::shared_ptr<Reader> reader, double rate);
+
+  asio::awaitable<void> heartbeatLoop(std::shared_ptr<Reader> reader);
+
+  asio::awaitable<void> broadcastLoop(std::shared_ptr<Reader> reader, asio::ip::udp::endpoint destination,
+                                      std::chrono::milliseconds interval);
+
+  // Where the reader's statuses go, if anywhere yet
+  static std::optional<asio::ip::udp::endpoint> getStatusDestination(const Reader& reader);
+
+  static bool send(Reader& reader, const asio::ip::udp::endpoint& destination, size_t size);
+
+  asio::io_context& m_io;
+  std::vector<std::shared_ptr<Reader>> m_readers;
+  std::atomic_bool m_isRunning{false};
+};
+
+}  // namespace vanch
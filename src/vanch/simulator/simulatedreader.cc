@@ -0,0 +1,501 @@
+#include "simulatedreader.h"
+
+#include <asio.hpp>
+#include <fmt/format.h>
+
+#include "vanch/framedecoder.h"
+#include "vanch/messagelist.h"
+
+namespace vanch {
+
+namespace {
+
+template <typename... Ts>
+consteval std::array<bool, 256> makeCommandTable(MessageList<Ts...>) {
+  std::array<bool, 256> table{};
+  ((table[Ts::Traits::s_cmdCode] = table[Ts::Traits::s_cmdCode] || Ts::Traits::s_header == MessageType_Command), ...);
+  return table;
+}
+
+// Codes the reader answers; anything else is an unsupported function, as on a reader with older firmware
+constexpr auto k_isRegistered = makeCommandTable(RegisteredMessages{});
+
+constexpr size_t k_highFrequencyMemorySize = 8192;
+constexpr size_t k_highFrequencyBlockSize = 4;
+constexpr size_t k_maxReadSize = 1024;
+
+constexpr std::string_view k_versionInfo = "VH-SIM V1.0.0";
+constexpr std::string_view k_deviceType = "VH-SIM";
+
+std::span<const uint8_t> asBytes(const std::string_view text) {
+  return {reinterpret_cast<const uint8_t*>(text.data()), text.size()};
+}
+
+}  // namespace
+
+SimulatedReader::SimulatedReader(SimulatedReaderProfile profile)
+    : m_profile(std::move(profile)), m_random(m_profile.index) {
+  m_reading.ipAddress = InternedString::intern(m_profile.ipAddress);
+  reset();
+}
+
+void SimulatedReader::reset() {
+  m_settings.clear();
+  m_clockOffset = {};
+  m_highFrequencyMemory.assign(k_highFrequencyMemorySize, 0);
+
+  asio::error_code ec;
+  const auto ip = asio::ip::make_address_v4(m_profile.ipAddress, ec).to_bytes();
+  const auto port = std::array<uint8_t, 2>{static_cast<uint8_t>(m_profile.port >> 8),
+                                           static_cast<uint8_t>(m_profile.port & 0xFF)};
+
+  setSetting(0x02, std::array<uint8_t, 1>{4}, 0);  // 115200 baud on both serial interfaces
+  setSetting(0x02, std::array<uint8_t, 1>{4}, 1);
+  setSetting(0x04, std::array<uint8_t, 1>{1});
+  setSetting(0x0C, std::array<uint8_t, 1>{1});
+  setSetting(0x0E, std::array<uint8_t, 1>{1});  // Continuous automatic reading
+
+  for (uint8_t antenna = 1; antenna <= k_antennaCount; ++antenna) {
+    setSetting(0x10, std::array<uint8_t, 1>{30}, antenna);
+  }
+
+  setSetting(0x16, std::array<uint8_t, k_antennaCount>{1, 2, 3, 4});
+  setSetting(0x20, std::array<uint8_t, 3>{});
+  setSetting(0x22, std::array<uint8_t, 1>{0x02});  // ISO18000-6C
+
+  std::vector<uint8_t> local;
+  local.insert(local.end(), ip.begin(), ip.end());
+  local.insert(local.end(), {255, 255, 255, 0, ip[0], ip[1], ip[2], 1});
+  local.insert(local.end(), port.begin(), port.end());
+  setSetting(0x24, local);
+
+  setSetting(0x26, std::array<uint8_t, 6>{0x02, 0x56, 0x43, static_cast<uint8_t>(m_profile.index >> 16),
+                                          static_cast<uint8_t>(m_profile.index >> 8),
+                                          static_cast<uint8_t>(m_profile.index)});
+  setSetting(0x28, std::array<uint8_t, 14>{});
+  setSetting(0x2C, std::array<uint8_t, 8>{0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00});
+  setSetting(0x2E, std::array<uint8_t, 2>{10, 100});
+  setSetting(0x32, std::array<uint8_t, 3>{});
+  setSetting(0x34, asBytes(fmt::format("SIM{:05}", m_profile.index)));
+  setSetting(0x36, asBytes(fmt::format("Simulated reader {}", m_profile.index)));
+  setSetting(0x38, std::array<uint8_t, 2>{0, 1});
+
+  std::vector<uint8_t> heartbeat{static_cast<uint8_t>(m_profile.heartbeatInterval > 0), m_profile.heartbeatInterval};
+  heartbeat.insert(heartbeat.end(), {'S', 'I', 'M'});
+  setSetting(0x43, heartbeat);
+
+  setSetting(0x4E, std::array<uint8_t, 21>{});
+  setSetting(0x50, std::array<uint8_t, 19>{});
+
+  std::vector<uint8_t> cellular{0x00, 0x00, 0x00};
+  const auto address = asBytes("127.0.0.1");
+  cellular.push_back(static_cast<uint8_t>(address.size()));
+  cellular.insert(cellular.end(), address.begin(), address.end());
+  setSetting(0x52, cellular);
+}
+
+size_t SimulatedReader::handleCommand(const std::span<const uint8_t> frame, const std::span<uint8_t> out) {
+  if (FrameDecoder::validate(frame) != FrameError::None || frame[0] != MessageType_Command) return 0;
+
+  const auto cmdCode = frame[k_frameHeaderSize - 1];
+  const auto params = frame.subspan(k_frameHeaderSize, frame.size() - k_minFrameSize);
+
+  if (!k_isRegistered[cmdCode]) return writeError(out, cmdCode, ErrorCode_UnsupportedFunction);
+
+  m_response.clear();
+  uint8_t errorCode = 0;
+
+  if (!handleSpecial(cmdCode, params, m_response, errorCode) &&
+      !handleHighFrequency(cmdCode, params, m_response, errorCode)) {
+    const auto* setting = findSetting(cmdCode);
+
+    if (!setting) {
+      errorCode = ErrorCode_UnsupportedFunction;
+    } else if (setting->isKeyed && params.empty()) {
+      errorCode = ErrorCode_ParameterLength;
+    } else if (cmdCode == setting->setCode) {
+      const uint8_t index = setting->isKeyed ? params[0] : 0;
+      const auto value = setting->isKeyed ? params.subspan(1) : params;
+
+      if (value.size() < setting->minSize || value.size() > setting->maxSize) {
+        errorCode = ErrorCode_ParameterLength;
+      } else if (errorCode = validate(cmdCode, index, value); errorCode == 0) {
+        setSetting(setting->getCode, value, index);
+      }
+    } else {
+      const uint8_t index = setting->isKeyed ? params[0] : 0;
+
+      if (cmdCode == 0x10 && (index < 1 || index > k_antennaCount)) {
+        errorCode = ErrorCode_UnsupportedAntenna;
+      } else {
+        const auto value = getSetting(cmdCode, index);
+        m_response.assign(value.begin(), value.end());
+        if (m_response.empty()) m_response.resize(setting->minSize);
+      }
+    }
+  }
+
+  if (errorCode != 0) return writeError(out, cmdCode, errorCode);
+  return writeFrame(out, MessageType_Return, cmdCode, m_response);
+}
+
+size_t SimulatedReader::makeAutoRead(const std::span<uint8_t> out) {
+  if (!isAutoReading() || m_profile.tagPopulation == 0) return 0;
+
+  std::array<uint8_t, k_epcSize> epc{};
+  makeEpc(std::uniform_int_distribution<uint32_t>{0, m_profile.tagPopulation - 1}(m_random), epc);
+
+  if (!passesFilter(epc)) return 0;
+
+  // Antennas are polled in turn, like the reader cycles its antenna ports
+  const auto antennas = getSetting(0x16);
+  const uint8_t antenna = antennas.empty() ? 1 : antennas[m_nextAntenna++ % antennas.size()];
+  const auto power = getSetting(0x10, antenna);
+
+  const int noise = std::uniform_int_distribution<int>{-6, 6}(m_random);
+  const int rssi = -75 + (power.empty() ? 0 : power[0]) + noise;
+
+  m_reading.antennaNumber = antenna;
+  m_reading.epc.assign(epc);
+  m_reading.rssi = static_cast<int8_t>(std::clamp(rssi, -90, -20));
+  m_reading.timestamp = static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(getReaderTime().time_since_epoch()).count());
+  m_reading.tagType = 0x02;
+
+  return m_reading.serializeInto(out);
+}
+
+size_t SimulatedReader::makeHeartbeat(const std::span<uint8_t> out) const {
+  const auto settings = getSetting(0x43);
+
+  StatusHeartbeat heartbeat;
+  if (settings.size() > 2) heartbeat.heartbeatData.assign(settings.begin() + 2, settings.end());
+
+  return heartbeat.serializeInto(out);
+}
+
+size_t SimulatedReader::makeBroadcast(const std::span<uint8_t> out) const {
+  const auto readerId = getSetting(0x34);
+  const auto rs485 = getSetting(0x04);
+
+  const auto getBaudRate = [this](const uint8_t interfaceType) {
+    const auto code = getSetting(0x02, interfaceType);
+    return code.empty() ? 0 : CmdSetBaudRate::getBaudRate(code[0]);
+  };
+
+  StatusUdpBroadcast broadcast;
+  broadcast.ipAddress = m_profile.ipAddress;
+  broadcast.port = m_profile.port;
+  broadcast.deviceType = k_deviceType;
+  broadcast.deviceId.assign(readerId.begin(), readerId.end());
+  broadcast.rs485Address = rs485.empty() ? 0 : rs485[0];
+  broadcast.rs232BaudRate = getBaudRate(0);
+  broadcast.rs485BaudRate = getBaudRate(1);
+
+  return broadcast.serializeInto(out);
+}
+
+bool SimulatedReader::isAutoReading() const {
+  const auto mode = getSetting(0x0E);
+  return !mode.empty() && mode[0] != 0;
+}
+
+std::chrono::seconds SimulatedReader::getHeartbeatInterval() const {
+  const auto settings = getSetting(0x43);
+  if (settings.size() < 2 || settings[0] == 0) return {};
+  return std::chrono::seconds(settings[1]);
+}
+
+std::optional<std::pair<std::array<uint8_t, 4>, uint16_t>> SimulatedReader::getStatusTarget() const {
+  const auto settings = getSetting(0x28);
+  if (settings.size() < 7 || settings[6] == 0) return std::nullopt;
+
+  std::array<uint8_t, 4> ip{};
+  std::copy_n(settings.begin(), 4, ip.begin());
+  if (ip == std::array<uint8_t, 4>{}) return std::nullopt;
+
+  return std::pair{ip, static_cast<uint16_t>(settings[4] << 8 | settings[5])};
+}
+
+const SimulatedReader::Setting* SimulatedReader::findSetting(const uint8_t cmdCode) {
+  static constexpr std::array<Setting, 26> k_settings = {{
+      {0x01, 0x02, true, 1, 1},     // Baud rate
+      {0x03, 0x04, false, 1, 1},    // RS485 address
+      {0x06, 0x08, true, 1, 1},     // Relay status
+      {0x09, 0x0A, true, 2, 2},     // Relay automatic control
+      {0x0B, 0x0C, false, 1, 1},    // Buzzer
+      {0x0D, 0x0E, false, 1, 1},    // Card reading mode
+      {0x0F, 0x10, true, 1, 1},     // Output power
+      {0x15, 0x16, false, 1, k_antennaCount},  // Polling antennas
+      {0x1A, 0x44, true, 24, 24},   // Reporting content
+      {0x1F, 0x20, false, 3, 67},   // Tag filter
+      {0x21, 0x22, false, 1, 1},    // Auto-read tag type
+      {0x23, 0x24, false, 14, 14},  // RJ45 local parameters
+      {0x25, 0x26, false, 6, 6},    // MAC address
+      {0x27, 0x28, false, 14, 14},  // RJ45 remote parameters
+      {0x29, 0x2A, true, 1, 1},     // Reported hardware interface
+      {0x2B, 0x2C, false, 8, 8},    // Reporting fields
+      {0x2D, 0x2E, false, 2, 2},    // Wiegand
+      {0x2F, 0x30, true, 2, 2},     // Trigger conditions
+      {0x31, 0x32, false, 3, 67},   // Tag alarm
+      {0x33, 0x34, false, 1, 64},   // Reader ID
+      {0x35, 0x36, false, 1, 64},   // Reader name
+      {0x37, 0x38, false, 2, 2},    // Reporting conditions
+      {0x39, 0x43, false, 2, 66},   // Heartbeat
+      {0x4D, 0x4E, false, 21, 255},  // WIFI
+      {0x4F, 0x50, false, 19, 19},  // Super network port
+      {0x51, 0x52, false, 4, 255},  // 4G
+  }};
+
+  const auto it = std::ranges::find_if(
+      k_settings, [cmdCode](const Setting& setting) { return setting.setCode == cmdCode || setting.getCode == cmdCode; });
+  return it != k_settings.end() ? &*it : nullptr;
+}
+
+uint8_t SimulatedReader::validate(const uint8_t setCode, const uint8_t index, const std::span<const uint8_t> value) const {
+  switch (setCode) {
+    case 0x01:
+      if (index > 1) return ErrorCode_BaudInterface;
+      return value[0] < 5 ? 0 : ErrorCode_BaudRange;
+    case 0x0D:
+      return value[0] <= 3 ? 0 : ErrorCode_DataRange;
+    case 0x0F:
+      if (index < 1 || index > k_antennaCount) return ErrorCode_UnsupportedAntenna;
+      return value[0] <= k_maxPower ? 0 : ErrorCode_PowerRange;
+    case 0x15:
+      for (const auto antenna : value) {
+        if (antenna < 1 || antenna > k_antennaCount) return ErrorCode_UnsupportedAntenna;
+      }
+      return 0;
+    case 0x1F:
+    case 0x31:
+      // The mask must fit into the EPC and the frame must carry exactly maskLength bytes of it
+      if (value[1] + value[2] > k_epcSize) return ErrorCode_FilterLength;
+      return value.size() == 3u + value[2] ? 0 : ErrorCode_ParameterLength;
+    default:
+      return 0;
+  }
+}
+
+std::span<const uint8_t> SimulatedReader::getSetting(const uint8_t getCode, const uint8_t index) const {
+  if (const auto it = m_settings.find(makeKey(getCode, index)); it != m_settings.end()) return it->second;
+  return {};
+}
+
+void SimulatedReader::setSetting(const uint8_t getCode, const std::span<const uint8_t> value, const uint8_t index) {
+  m_settings[makeKey(getCode, index)].assign(value.begin(), value.end());
+
+  if (getCode == 0x34) {
+    m_reading.deviceId = InternedString::intern({reinterpret_cast<const char*>(value.data()), value.size()});
+  }
+}
+
+bool SimulatedReader::handleSpecial(const uint8_t cmdCode, const std::span<const uint8_t> params,
+                                    std::vector<uint8_t>& response, uint8_t& errorCode) {
+  using namespace std::chrono;
+
+  switch (cmdCode) {
+    case 0x05: {
+      const auto version = asBytes(k_versionInfo);
+      response.assign(version.begin(), version.end());
+      return true;
+    }
+    case 0x17:
+      reset();
+      return true;
+    case 0x18:
+      return true;
+    case 0x19:
+      setSetting(0x4E, std::array<uint8_t, 21>{});
+      return true;
+    case 0x1B: {
+      if (params.size() != 6) {
+        errorCode = ErrorCode_ParameterLength;
+        return true;
+      }
+
+      const year_month_day date{year{2000 + params[0]}, month{params[1]}, day{params[2]}};
+      if (!date.ok() || params[3] > 23 || params[4] > 59 || params[5] > 59) {
+        errorCode = ErrorCode_ParameterError;
+        return true;
+      }
+
+      const auto time = sys_days{date} + hours{params[3]} + minutes{params[4]} + seconds{params[5]};
+      m_clockOffset = duration_cast<seconds>(time - system_clock::now());
+      return true;
+    }
+    case 0x1C: {
+      const auto now = floor<seconds>(getReaderTime());
+      const auto days = floor<std::chrono::days>(now);
+      const year_month_day date{days};
+      const hh_mm_ss time{now - days};
+
+      response = {static_cast<uint8_t>(static_cast<int>(date.year()) % 100),
+                  static_cast<uint8_t>(static_cast<unsigned>(date.month())),
+                  static_cast<uint8_t>(static_cast<unsigned>(date.day())),
+                  static_cast<uint8_t>(time.hours().count()),
+                  static_cast<uint8_t>(time.minutes().count()),
+                  static_cast<uint8_t>(time.seconds().count())};
+      return true;
+    }
+    case 0x60:
+      // Inputs are never driven
+      if (params.empty()) {
+        errorCode = ErrorCode_ParameterLength;
+      } else {
+        response = {0};
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SimulatedReader::handleHighFrequency(const uint8_t cmdCode, const std::span<const uint8_t> params,
+                                          std::vector<uint8_t>& response, uint8_t& errorCode) {
+  // One tag is in the field, so the UID is only skipped. Every layout starts with the UID length and the UID.
+  const auto skipUid = [&]() -> std::optional<std::span<const uint8_t>> {
+    if (params.empty() || params.size() < 1u + params[0]) return std::nullopt;
+    return params.subspan(1u + params[0]);
+  };
+
+  const auto access = [&](const size_t start, const size_t count, const size_t blockSize) -> std::span<uint8_t> {
+    if (blockSize == 0) {
+      errorCode = ErrorCode_ParameterError;
+      return {};
+    }
+    if ((start + count) * blockSize > m_highFrequencyMemory.size()) {
+      errorCode = ErrorCode_AccessRange;
+      return {};
+    }
+    return std::span{m_highFrequencyMemory}.subspan(start * blockSize, count * blockSize);
+  };
+
+  const auto read = [&](const size_t start, const size_t count, const size_t blockSize) {
+    if (count * blockSize > k_maxReadSize) {
+      errorCode = ErrorCode_ReadLength;
+      return;
+    }
+    const auto memory = access(start, count, blockSize);
+    response.assign(memory.begin(), memory.end());
+  };
+
+  const auto write = [&](const size_t start, const size_t count, const size_t blockSize,
+                         const std::span<const uint8_t> data) {
+    if (data.size() != count * blockSize) {
+      errorCode = ErrorCode_ParameterLength;
+      return;
+    }
+    const auto memory = access(start, count, blockSize);
+    if (errorCode == 0) std::ranges::copy(data, memory.begin());
+  };
+
+  // Minimum size of the parameters that follow the UID
+  size_t minSize;
+  switch (cmdCode) {
+    case 0x71:
+    case 0x73:
+    case 0x76:
+    case 0x77:
+      minSize = 2;
+      break;
+    case 0x72:
+    case 0x74:
+      minSize = 1 + k_highFrequencyBlockSize;
+      break;
+    case 0x75:
+      minSize = 1;
+      break;
+    case 0x78:
+    case 0x79:
+      minSize = 3;
+      break;
+    default:
+      return false;
+  }
+
+  const auto rest = skipUid();
+  if (!rest || rest->size() < minSize) {
+    errorCode = ErrorCode_ParameterLength;
+    return true;
+  }
+
+  const auto& p = *rest;
+
+  switch (cmdCode) {
+    case 0x71:
+    case 0x73:
+      read(p[0], p[1], k_highFrequencyBlockSize);
+      break;
+    case 0x78:
+      read(p[0], p[1], p[2]);
+      break;
+    case 0x72:
+    case 0x74:
+      write(p[0], 1, k_highFrequencyBlockSize, p.subspan(1));
+      break;
+    case 0x76:
+    case 0x77:
+      write(p[0], p[1], k_highFrequencyBlockSize, p.subspan(2));
+      break;
+    case 0x79:
+      write(p[0], p[1], p[2], p.subspan(3));
+      break;
+    default:
+      break;
+  }
+
+  return true;
+}
+
+std::chrono::system_clock::time_point SimulatedReader::getReaderTime() const {
+  return std::chrono::system_clock::now() + m_clockOffset;
+}
+
+void SimulatedReader::makeEpc(const uint32_t tag, std::array<uint8_t, k_epcSize>& epc) const {
+  // E280 prefix, then the reader and the tag number, so populations of different readers do not overlap
+  epc = {0xE2,
+         0x80,
+         static_cast<uint8_t>(m_profile.index >> 24),
+         static_cast<uint8_t>(m_profile.index >> 16),
+         static_cast<uint8_t>(m_profile.index >> 8),
+         static_cast<uint8_t>(m_profile.index),
+         0x00,
+         0x00,
+         static_cast<uint8_t>(tag >> 24),
+         static_cast<uint8_t>(tag >> 16),
+         static_cast<uint8_t>(tag >> 8),
+         static_cast<uint8_t>(tag)};
+}
+
+bool SimulatedReader::passesFilter(const std::span<const uint8_t> epc) const {
+  // Mask address and length are taken as byte offsets into the EPC
+  const auto filter = getSetting(0x20);
+  if (filter.size() < 3 || filter[0] == 0) return true;
+
+  const size_t address = filter[1];
+  const size_t length = std::min<size_t>(filter[2], filter.size() - 3);
+  if (address + length > epc.size()) return false;
+
+  return std::ranges::equal(epc.subspan(address, length), filter.subspan(3, length));
+}
+
+size_t SimulatedReader::writeFrame(const std::span<uint8_t> out, const MessageType type, const uint8_t cmdCode,
+                                   const std::span<const uint8_t> params) {
+  BufferWriter writer{out};
+
+  writer.put(type).putU16(0).put(0x00).put(cmdCode).put(params);
+  writer.patchU16(1, static_cast<uint16_t>(writer.size() - 3 + 1));
+  writer.put(static_cast<uint8_t>(~writer.sum() + 1));
+
+  return writer.overflowed() ? 0 : writer.size();
+}
+
+size_t SimulatedReader::writeError(const std::span<uint8_t> out, const uint8_t cmdCode, const uint8_t errorCode) {
+  Error error;
+  error.failedCmdCode = cmdCode;
+  error.errorCode = errorCode;
+  return error.serializeInto(out);
+}
+
+}  // namespace vanch
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <random>
+
+#include "vanch/statuses/status.h"
+
+namespace vanch {
+
+struct SimulatedReaderProfile {
+  uint32_t index{0};             // Distinguishes the EPCs, device ID and MAC address of readers in one simulation
+  std::string ipAddress{"127.0.0.1"};
+  uint16_t port{0};              // Reported in broadcasts
+  uint32_t tagPopulation{100};   // Tags in the field of every antenna
+  uint8_t heartbeatInterval{1};  // Seconds, 0 disables heartbeats until a command enables them
+};
+
+// Protocol behaviour and configuration of one reader, without any I/O. Commands are answered from a settings store
+// that Set commands write and Get commands read back, so a value that was set is returned as it was sent. Output
+// power, polling antennas, the reader clock, the tag filter, the card reading mode and the heartbeat settings also
+// shape the statuses the reader produces. Every command of the registry gets a return or an error frame; codes the
+// registry does not know are rejected as unsupported.
+class SimulatedReader {
+ public:
+  static constexpr uint8_t k_antennaCount = 4;
+  static constexpr uint8_t k_maxPower = 33;
+  static constexpr size_t k_epcSize = 12;
+
+  explicit SimulatedReader(SimulatedReaderProfile profile);
+
+  // Restores the factory settings.
+  void reset();
+
+  // Answers one command frame. Returns the size of the response frame written to out, or 0 for frames that are not
+  // commands.
+  size_t handleCommand(std::span<const uint8_t> frame, std::span<uint8_t> out);
+
+  // Writes one auto-reading status for a random tag of the population. Returns 0 when the reader is in command mode
+  // or the tag does not pass the filter.
+  size_t makeAutoRead(std::span<uint8_t> out);
+
+  size_t makeHeartbeat(std::span<uint8_t> out) const;
+
+  size_t makeBroadcast(std::span<uint8_t> out) const;
+
+  [[nodiscard]] bool isAutoReading() const;
+
+  // Zero when heartbeats are disabled
+  [[nodiscard]] std::chrono::seconds getHeartbeatInterval() const;
+
+  // Where statuses go when the remote UDP server is enabled in the network parameters
+  [[nodiscard]] std::optional<std::pair<std::array<uint8_t, 4>, uint16_t>> getStatusTarget() const;
+
+  [[nodiscard]] const SimulatedReaderProfile& getProfile() const { return m_profile; }
+
+ private:
+  enum ErrorCode : uint8_t {
+    ErrorCode_UnsupportedFunction = 0x01,
+    ErrorCode_DataRange = 0x03,
+    ErrorCode_ParameterError = 0x16,
+    ErrorCode_UnsupportedAntenna = 0x1B,
+    ErrorCode_FilterLength = 0x1C,
+    ErrorCode_AccessRange = 0x1D,
+    ErrorCode_ReadLength = 0x1F,
+    ErrorCode_PowerRange = 0x23,
+    ErrorCode_BaudInterface = 0x24,
+    ErrorCode_BaudRange = 0x25,
+    ErrorCode_ParameterLength = 0x32,
+  };
+
+  // A Set/Get pair that stores its parameters verbatim. Keyed settings carry an index such as an antenna or relay
+  // number in their first parameter byte, which Get commands repeat.
+  struct Setting {
+    uint8_t setCode;
+    uint8_t getCode;
+    bool isKeyed;
+    uint8_t minSize;
+    uint8_t maxSize;
+  };
+
+  static const Setting* findSetting(uint8_t cmdCode);
+
+  static uint16_t makeKey(const uint8_t getCode, const uint8_t index) {
+    return static_cast<uint16_t>(getCode << 8 | index);
+  }
+
+  // Checks the values of settings that drive the simulation. Returns 0 if they are acceptable.
+  uint8_t validate(uint8_t setCode, uint8_t index, std::span<const uint8_t> value) const;
+
+  [[nodiscard]] std::span<const uint8_t> getSetting(uint8_t getCode, uint8_t index = 0) const;
+
+  void setSetting(uint8_t getCode, std::span<const uint8_t> value, uint8_t index = 0);
+
+  // Commands with behaviour beyond the settings store. Return false if the code is not one of them.
+  bool handleSpecial(uint8_t cmdCode, std::span<const uint8_t> params, std::vector<uint8_t>& response,
+                     uint8_t& errorCode);
+
+  bool handleHighFrequency(uint8_t cmdCode, std::span<const uint8_t> params, std::vector<uint8_t>& response,
+                           uint8_t& errorCode);
+
+  [[nodiscard]] std::chrono::system_clock::time_point getReaderTime() const;
+
+  void makeEpc(uint32_t tag, std::array<uint8_t, k_epcSize>& epc) const;
+
+  [[nodiscard]] bool passesFilter(std::span<const uint8_t> epc) const;
+
+  static size_t writeFrame(std::span<uint8_t> out, MessageType type, uint8_t cmdCode, std::span<const uint8_t> params);
+
+  static size_t writeError(std::span<uint8_t> out, uint8_t cmdCode, uint8_t errorCode);
+
+  SimulatedReaderProfile m_profile;
+  std::unordered_map<uint16_t, std::vector<uint8_t>> m_settings;
+  std::chrono::seconds m_clockOffset{0};
+  std::vector<uint8_t> m_highFrequencyMemory;
+
+  std::mt19937 m_random;
+  uint8_t m_nextAntenna{0};
+  std::vector<uint8_t> m_response;
+
+  // Reused between reads; the device strings are interned once
+  StatusAutoCardReading m_reading;
+};
+
+}  // namespace vanch
@@ -1,7 +1,72 @@
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include "jsonreader.h"
 #include "status.h"
 
 namespace vanch {
 
+namespace {
+
+enum class Field : uint8_t {
+  Ant,
+  FIN,
+  Door,
+  IP,
+  EPC,
+  TID,
+  USER,
+  ID,
+  RSSI,
+  TS,
+  TagType,
+  Custom1,
+  Custom2,
+  Custom3,
+  Custom4,
+  Custom5,
+  Temp,
+};
+
+constexpr frozen::unordered_map<frozen::string, Field, 17> k_fields = {
+    {"Ant", Field::Ant},
+    {"FIN", Field::FIN},
+    {"Door", Field::Door},
+    {"IP", Field::IP},
+    {"EPC", Field::EPC},
+    {"TID", Field::TID},
+    {"USER", Field::USER},
+    {"ID", Field::ID},
+    {"RSSI", Field::RSSI},
+    {"TS", Field::TS},
+    {"TagType", Field::TagType},
+    {"Custom1", Field::Custom1},
+    {"Custom2", Field::Custom2},
+    {"Custom3", Field::Custom3},
+    {"Custom4", Field::Custom4},
+    {"Custom5", Field::Custom5},
+    {"Temp", Field::Temp}};
+
+}  // namespace
+
+std::string_view StatusAutoCardReading::getCustomField(const size_t index) const {
+  if (index >= k_customFieldCount) return {};
+
+  const auto& span = m_customFields[index];
+  return std::string_view(m_customData).substr(span.offset, span.size);
+}
+
+void StatusAutoCardReading::setCustomField(const size_t index, const std::string_view value) {
+  if (index >= k_customFieldCount) return;
+
+  // A replaced value stays in the buffer until the next deserialize; fields are set once per packet
+  const auto size = std::min<size_t>(value.size(), std::numeric_limits<uint16_t>::max());
+  if (m_customData.size() + size > std::numeric_limits<uint16_t>::max()) return;
+
+  m_customFields[index] = {static_cast<uint16_t>(m_customData.size()), static_cast<uint16_t>(size)};
+  m_customData.append(value.substr(0, size));
+}
+
 void StatusAutoCardReading::render() {
   ImGui::Text("Antenna Number: %u", antennaNumber);
   ImGui::Text("Triggered Channels: ");
@@ -10,57 +75,122 @@ void StatusAutoCardReading::render() {
   }
   ImGui::Text("Direction: %s", direction.c_str());
   ImGui::Text("IP Address: %s", ipAddress.c_str());
-  ImGui::Text("EPC: %s", epc.c_str());
-  ImGui::Text("TID: %s", tid.c_str());
-  ImGui::Text("User Area: %s", userArea.c_str());
+  ImGui::Text("EPC: %s", epc.toHex().c_str());
+  ImGui::Text("TID: %s", tid.toHex().c_str());
+  ImGui::Text("User Area: %s", userArea.toHex().c_str());
   ImGui::Text("Device ID: %s", deviceId.c_str());
   ImGui::Text("RSSI: %d", rssi);
   ImGui::Text("Timestamp: %u", timestamp);
   ImGui::Text("Tag Type: 0x%02X", tagType);
   ImGui::Text("Custom Fields: ");
-  for (const auto& field : customFields) {
-    ImGui::Text("%s", field.c_str());
+  for (size_t i = 0; i < k_customFieldCount; ++i) {
+    const auto field = getCustomField(i);
+    ImGui::Text("%.*s", static_cast<int>(field.size()), field.data());
   }
   ImGui::Text("Temperature: %.2f", temperature);
 }
 
-std::vector<uint8_t> StatusAutoCardReading::serializeParameters() const {
+void StatusAutoCardReading::serializeParameters(BufferWriter& writer) const {
   const json jsonData = {{"Ant", antennaNumber},
                          {"FIN", triggeredChannels},
-                         {"Door", direction},
-                         {"IP", ipAddress},
-                         {"EPC", epc},
-                         {"TID", tid},
-                         {"USER", userArea},
-                         {"ID", deviceId},
+                         {"Door", direction.str()},
+                         {"IP", ipAddress.str()},
+                         {"EPC", epc.toHex()},
+                         {"TID", tid.toHex()},
+                         {"USER", userArea.toHex()},
+                         {"ID", deviceId.str()},
                          {"RSSI", rssi},
                          {"TS", timestamp},
                          {"TagType", tagType},
-                         {"Custom1", customFields.size() > 0 ? customFields[0] : ""},
-                         {"Custom2", customFields.size() > 1 ? customFields[1] : ""},
-                         {"Custom3", customFields.size() > 2 ? customFields[2] : ""},
-                         {"Custom4", customFields.size() > 3 ? customFields[3] : ""},
-                         {"Custom5", customFields.size() > 4 ? customFields[4] : ""},
+                         {"Custom1", std::string(getCustomField(0))},
+                         {"Custom2", std::string(getCustomField(1))},
+                         {"Custom3", std::string(getCustomField(2))},
+                         {"Custom4", std::string(getCustomField(3))},
+                         {"Custom5", std::string(getCustomField(4))},
                          {"Temp", temperature}};
-  return serializeJson(jsonData);
+  serializeJson(jsonData, writer);
 }
 
 void StatusAutoCardReading::deserializeParameters(const std::span<const uint8_t> data) {
-  const json jsonData = deserializeJson(data);
-  antennaNumber = jsonData.value("Ant", 0);
-  triggeredChannels = jsonData.value("FIN", std::vector<uint8_t>());
-  direction = jsonData.value("Door", "");
-  ipAddress = jsonData.value("IP", "");
-  epc = jsonData.value("EPC", "");
-  tid = jsonData.value("TID", "");
-  userArea = jsonData.value("USER", "");
-  deviceId = jsonData.value("ID", "");
-  rssi = jsonData.value("RSSI", 0);
-  timestamp = jsonData.value("TS", 0);
-  tagType = jsonData.value("TagType", 0);
-  customFields = {jsonData.value("Custom1", ""), jsonData.value("Custom2", ""), jsonData.value("Custom3", ""),
-                  jsonData.value("Custom4", ""), jsonData.value("Custom5", "")};
-  temperature = jsonData.value("Temp", 0.0f);
+  // Pooled instances are reused, so every field is reset before the members present in this packet are applied
+  antennaNumber = 0;
+  triggeredChannels.clear();
+  direction = {};
+  ipAddress = {};
+  epc.clear();
+  tid.clear();
+  userArea.clear();
+  deviceId = {};
+  rssi = 0;
+  timestamp = 0;
+  tagType = 0;
+  m_customData.clear();
+  m_customFields = {};
+  temperature = 0.0f;
+
+  JsonReader reader{data};
+  if (!reader.beginObject()) return;
+
+  // Values are decoded or interned straight from the receive buffer; scratch only holds strings with escapes
+  std::string scratch;
+  std::string_view value;
+  std::string_view key;
+  while (reader.nextKey(key)) {
+    const auto it = k_fields.find(frozen::string{key.data(), key.size()});
+
+    if (it == k_fields.end()) {
+      reader.skipValue();
+      continue;
+    }
+
+    switch (const auto field = it->second) {
+      case Field::Ant:
+        reader.read(antennaNumber);
+        break;
+      case Field::FIN:
+        reader.readArray(triggeredChannels);
+        break;
+      case Field::Door:
+        if (reader.readStringView(value, scratch)) direction = InternedString::intern(value);
+        break;
+      case Field::IP:
+        if (reader.readStringView(value, scratch)) ipAddress = InternedString::intern(value);
+        break;
+      case Field::EPC:
+        if (reader.readStringView(value, scratch)) epc.assignHex(value);
+        break;
+      case Field::TID:
+        if (reader.readStringView(value, scratch)) tid.assignHex(value);
+        break;
+      case Field::USER:
+        if (reader.readStringView(value, scratch)) userArea.assignHex(value);
+        break;
+      case Field::ID:
+        if (reader.readStringView(value, scratch)) deviceId = InternedString::intern(value);
+        break;
+      case Field::RSSI:
+        reader.read(rssi);
+        break;
+      case Field::TS:
+        reader.read(timestamp);
+        break;
+      case Field::TagType:
+        reader.read(tagType);
+        break;
+      case Field::Custom1:
+      case Field::Custom2:
+      case Field::Custom3:
+      case Field::Custom4:
+      case Field::Custom5:
+        if (reader.readStringView(value, scratch)) {
+          setCustomField(static_cast<size_t>(field) - static_cast<size_t>(Field::Custom1), value);
+        }
+        break;
+      case Field::Temp:
+        reader.read(temperature);
+        break;
+    }
+  }
 }
 
-}  // namespace vanch
\ No newline at end of file
+}  // namespace vanch
@@ -1,17 +1,29 @@
+#include "jsonreader.h"
 #include "status.h"
 
 namespace vanch {
 
 void StatusHeartbeat::render() { ImGui::Text("Heartbeat Data: %s", heartbeatData.c_str()); }
 
-std::vector<uint8_t> StatusHeartbeat::serializeParameters() const {
+void StatusHeartbeat::serializeParameters(BufferWriter& writer) const {
   const json jsonData = {{"heartbeat", heartbeatData}};
-  return serializeJson(jsonData);
+  serializeJson(jsonData, writer);
 }
 
 void StatusHeartbeat::deserializeParameters(const std::span<const uint8_t> data) {
-  const json jsonData = deserializeJson(data);
-  heartbeatData = jsonData.value("heartbeat", "");
+  heartbeatData.clear();
+
+  JsonReader reader{data};
+  if (!reader.beginObject()) return;
+
+  std::string_view key;
+  while (reader.nextKey(key)) {
+    if (key == "heartbeat") {
+      reader.readString(heartbeatData);
+    } else {
+      reader.skipValue();
+    }
+  }
 }
 
 }  // namespace vanch
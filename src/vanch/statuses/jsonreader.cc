@@ -0,0 +1,247 @@
+#include "jsonreader.h"
+
+namespace vanch {
+
+static void appendUtf8(std::string& out, const uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    out.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+static bool parseHex4(const std::string_view text, uint32_t& out) {
+  if (text.size() < 4) return false;
+  const auto [ptr, ec] = std::from_chars(text.data(), text.data() + 4, out, 16);
+  return ec == std::errc{} && ptr == text.data() + 4;
+}
+
+// Decodes the escape sequences of a raw JSON string body into out.
+static bool unescape(const std::string_view raw, std::string& out) {
+  out.clear();
+
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != '\\') {
+      out.push_back(raw[i]);
+      continue;
+    }
+
+    if (++i >= raw.size()) return false;
+
+    switch (raw[i]) {
+      case '"':
+      case '\\':
+      case '/':
+        out.push_back(raw[i]);
+        break;
+      case 'b':
+        out.push_back('\b');
+        break;
+      case 'f':
+        out.push_back('\f');
+        break;
+      case 'n':
+        out.push_back('\n');
+        break;
+      case 'r':
+        out.push_back('\r');
+        break;
+      case 't':
+        out.push_back('\t');
+        break;
+      case 'u': {
+        uint32_t codePoint{};
+        if (!parseHex4(raw.substr(i + 1), codePoint)) return false;
+        i += 4;
+
+        // Surrogate pair
+        if (codePoint >= 0xD800 && codePoint < 0xDC00 && raw.substr(i + 1, 2) == "\\u") {
+          uint32_t low{};
+          if (!parseHex4(raw.substr(i + 3), low) || low < 0xDC00 || low > 0xDFFF) return false;
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+          i += 6;
+        }
+
+        appendUtf8(out, codePoint);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool JsonReader::beginObject() {
+  m_firstMember = true;
+  return expect('{');
+}
+
+bool JsonReader::nextKey(std::string_view& key) {
+  if (m_failed) return false;
+
+  if (consume('}')) return false;
+
+  if (!m_firstMember && !expect(',')) return false;
+  m_firstMember = false;
+
+  bool hasEscapes = false;
+  if (!readRawString(key, hasEscapes)) return false;
+
+  return expect(':');
+}
+
+bool JsonReader::readString(std::string& out) {
+  std::string_view raw;
+  bool hasEscapes = false;
+
+  if (!readRawString(raw, hasEscapes)) return false;
+
+  if (!hasEscapes) {
+    out.assign(raw);
+    return true;
+  }
+
+  return unescape(raw, out) || fail();
+}
+
+bool JsonReader::readStringView(std::string_view& out, std::string& scratch) {
+  bool hasEscapes = false;
+
+  if (!readRawString(out, hasEscapes)) return false;
+  if (!hasEscapes) return true;
+
+  if (!unescape(out, scratch)) return fail();
+
+  out = scratch;
+  return true;
+}
+
+bool JsonReader::readNumber(double& out) {
+  skipWhitespace();
+  if (m_failed) return false;
+
+  // from_chars rejects the leading plus sign that JSON also forbids, so the two grammars agree
+  const auto [ptr, ec] = std::from_chars(m_pos, m_end, out);
+  if (ec != std::errc{}) return fail();
+
+  m_pos = ptr;
+  return true;
+}
+
+bool JsonReader::readInteger(int64_t& out) {
+  skipWhitespace();
+  if (m_failed) return false;
+
+  const auto [ptr, ec] = std::from_chars(m_pos, m_end, out);
+  if (ec != std::errc{}) return fail();
+
+  // Fractional or exponent form, e.g. 1.0 or 1e2, is accepted and truncated
+  if (ptr != m_end && (*ptr == '.' || *ptr == 'e' || *ptr == 'E')) {
+    double value{};
+    if (!readNumber(value)) return false;
+    out = static_cast<int64_t>(value);
+    return true;
+  }
+
+  m_pos = ptr;
+  return true;
+}
+
+bool JsonReader::readRawString(std::string_view& out, bool& hasEscapes) {
+  if (!expect('"')) return false;
+
+  const auto* begin = m_pos;
+  hasEscapes = false;
+
+  while (m_pos < m_end && *m_pos != '"') {
+    if (*m_pos == '\\') {
+      hasEscapes = true;
+      ++m_pos;
+    }
+    ++m_pos;
+  }
+
+  if (m_pos >= m_end) return fail();
+
+  out = {begin, static_cast<size_t>(m_pos - begin)};
+  ++m_pos;
+  return true;
+}
+
+bool JsonReader::skipValue() {
+  skipWhitespace();
+  if (m_failed || m_pos >= m_end) return fail();
+
+  switch (*m_pos) {
+    case '"': {
+      std::string_view raw;
+      bool hasEscapes = false;
+      return readRawString(raw, hasEscapes);
+    }
+    case '{':
+      return skipContainer('{', '}');
+    case '[':
+      return skipContainer('[', ']');
+    case 't':
+    case 'f':
+    case 'n':
+      while (m_pos < m_end && *m_pos >= 'a' && *m_pos <= 'z') ++m_pos;
+      return true;
+    default: {
+      double value{};
+      return readNumber(value);
+    }
+  }
+}
+
+bool JsonReader::skipContainer(const char open, const char close) {
+  int depth = 0;
+
+  while (m_pos < m_end) {
+    const auto c = *m_pos;
+
+    if (c == '"') {
+      std::string_view raw;
+      bool hasEscapes = false;
+      if (!readRawString(raw, hasEscapes)) return false;
+      continue;
+    }
+
+    ++m_pos;
+
+    if (c == open) {
+      ++depth;
+    } else if (c == close && --depth == 0) {
+      return true;
+    }
+  }
+
+  return fail();
+}
+
+void JsonReader::skipWhitespace() {
+  while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r')) ++m_pos;
+}
+
+bool JsonReader::consume(const char c) {
+  skipWhitespace();
+  if (m_failed || m_pos >= m_end || *m_pos != c) return false;
+  ++m_pos;
+  return true;
+}
+
+bool JsonReader::expect(const char c) { return consume(c) || fail(); }
+
+}  // namespace vanch
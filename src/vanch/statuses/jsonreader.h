@@ -0,0 +1,87 @@
+#pragma once
+
+#include <charconv>
+
+namespace vanch {
+
+// Forward-only reader for the flat JSON objects sent in status packets. Reads straight from the receive buffer
+// without building a DOM; strings are unescaped into caller-owned storage so pooled messages keep their capacity.
+// Any malformed input puts the reader into a failed state, after which every call returns false.
+class JsonReader {
+ public:
+  explicit JsonReader(const std::span<const uint8_t> data)
+      : m_pos(reinterpret_cast<const char*>(data.data())), m_end(m_pos + data.size()) {}
+
+  bool beginObject();
+
+  // Advances to the next member of the current object. Returns false at the closing brace or on error.
+  bool nextKey(std::string_view& key);
+
+  bool readString(std::string& out);
+
+  // Points out at the string in the receive buffer, or at scratch when it had to be unescaped. Lets callers decode
+  // or intern a value without first copying it into a string of their own.
+  bool readStringView(std::string_view& out, std::string& scratch);
+
+  bool readNumber(double& out);
+
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  bool read(T& out) {
+    if constexpr (std::is_integral_v<T>) {
+      int64_t value{};
+      if (!readInteger(value)) return false;
+      out = static_cast<T>(value);
+    } else {
+      double value{};
+      if (!readNumber(value)) return false;
+      out = static_cast<T>(value);
+    }
+    return true;
+  }
+
+  // Replaces the contents of out with the elements of a JSON array of numbers.
+  template <typename T>
+  bool readArray(std::vector<T>& out) {
+    out.clear();
+    if (!expect('[')) return false;
+    if (consume(']')) return true;
+
+    do {
+      T value{};
+      if (!read(value)) return false;
+      out.push_back(value);
+    } while (consume(','));
+
+    return expect(']');
+  }
+
+  bool skipValue();
+
+  [[nodiscard]] bool failed() const { return m_failed; }
+
+ private:
+  bool readInteger(int64_t& out);
+
+  bool readRawString(std::string_view& out, bool& hasEscapes);
+
+  bool skipContainer(char open, char close);
+
+  void skipWhitespace();
+
+  bool consume(char c);
+
+  bool expect(char c);
+
+  bool fail() {
+    m_failed = true;
+    return false;
+  }
+
+  const char* m_pos;
+  const char* m_end;
+  bool m_failed{false};
+  bool m_firstMember{true};
+};
+
+}  // namespace vanch
@@ -2,21 +2,14 @@
 
 #include <nlohmann/json.hpp>
 
+#include "vanch/internedstring.h"
 #include "vanch/message.h"
+#include "vanch/tagid.h"
 
 using json = nlohmann::json;
 
 // Helper function to serialize JSON into bytes
-static std::vector<uint8_t> serializeJson(const json& jsonData) {
-  std::string jsonString = jsonData.dump();
-  return {jsonString.begin(), jsonString.end()};
-}
-
-// Helper function to deserialize JSON from bytes
-static json deserializeJson(const std::span<const uint8_t>& data) {
-  std::string jsonString(data.begin(), data.end());
-  return json::parse(jsonString);
-}
+static void serializeJson(const json& jsonData, vanch::BufferWriter& writer) { writer.put(jsonData.dump()); }
 
 namespace vanch {
 
@@ -24,25 +17,42 @@ VANCH_DEFINE_TRAITS(StatusAutoCardReading, 0x01, MessageType_Status, "Automatic
 
 class StatusAutoCardReading final : public Message<StatusAutoCardReading_Traits> {
  public:
+  static constexpr size_t k_customFieldCount = 5;
+
+  // Tag memory is kept decoded and the reader-describing strings interned, so a read owns no heap strings in the
+  // common case and hashes and compares cheaply in aggregations
   uint8_t antennaNumber{};
   std::vector<uint8_t> triggeredChannels;
-  std::string direction;
-  std::string ipAddress;
-  std::string epc;
-  std::string tid;
-  std::string userArea;
-  std::string deviceId;
+  InternedString direction;
+  InternedString ipAddress;
+  TagId epc;
+  TagId tid;
+  TagId userArea;
+  InternedString deviceId;
   int8_t rssi{};
   uint32_t timestamp{};
   uint8_t tagType{};
-  std::vector<std::string> customFields;
   float temperature{};
 
+  [[nodiscard]] std::string_view getCustomField(size_t index) const;
+
+  void setCustomField(size_t index, std::string_view value);
+
   void render() override;
 
-  [[nodiscard]] std::vector<uint8_t> serializeParameters() const override;
+  void serializeParameters(BufferWriter& writer) const override;
 
   void deserializeParameters(std::span<const uint8_t> data) override;
+
+ private:
+  struct FieldSpan {
+    uint16_t offset{};
+    uint16_t size{};
+  };
+
+  // All custom fields share one buffer
+  std::string m_customData;
+  std::array<FieldSpan, k_customFieldCount> m_customFields{};
 };
 
 VANCH_DEFINE_TRAITS(StatusUdpBroadcast, 0x02, MessageType_Status, "UDP Broadcast Package");
@@ -60,7 +70,7 @@ public:
 
     void render() override;
 
-    [[nodiscard]] std::vector<uint8_t> serializeParameters() const override;
+    void serializeParameters(BufferWriter& writer) const override;
 
     void deserializeParameters(std::span<const uint8_t> data) override;
 };
@@ -73,7 +83,7 @@ class StatusHeartbeat final : public Message<StatusHeartbeat_Traits> {
 
   void render() override;
 
-  [[nodiscard]] std::vector<uint8_t> serializeParameters() const override;
+  void serializeParameters(BufferWriter& writer) const override;
 
   void deserializeParameters(std::span<const uint8_t> data) override;
 };
@@ -1,7 +1,36 @@
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include "jsonreader.h"
 #include "status.h"
 
 namespace vanch {
 
+namespace {
+
+enum class Field : uint8_t {
+  IP,
+  Port,
+  DeviceType,
+  ID,
+  RS485,
+  RS232Baud,
+  RS485Baud,
+  ti,
+};
+
+constexpr frozen::unordered_map<frozen::string, Field, 8> k_fields = {
+    {"IP", Field::IP},
+    {"Port", Field::Port},
+    {"DeviceType", Field::DeviceType},
+    {"ID", Field::ID},
+    {"RS485", Field::RS485},
+    {"RS232Baud", Field::RS232Baud},
+    {"RS485Baud", Field::RS485Baud},
+    {"ti", Field::ti}};
+
+}  // namespace
+
 void StatusUdpBroadcast::render() {
   ImGui::Text("IP Address: %s", ipAddress.c_str());
   ImGui::Text("Port: %u", port);
@@ -13,7 +42,7 @@ void StatusUdpBroadcast::render() {
   ImGui::Text("Internal Model: %u", internalModel);
 }
 
-std::vector<uint8_t> StatusUdpBroadcast::serializeParameters() const {
+void StatusUdpBroadcast::serializeParameters(BufferWriter& writer) const {
   const json jsonData = {{"IP", ipAddress},
                          {"Port", port},
                          {"DeviceType", deviceType},
@@ -22,19 +51,58 @@ std::vector<uint8_t> StatusUdpBroadcast::serializeParameters() const {
                          {"RS232Baud", rs232BaudRate},
                          {"RS485Baud", rs485BaudRate},
                          {"ti", internalModel}};
-  return serializeJson(jsonData);
+  serializeJson(jsonData, writer);
 }
 
 void StatusUdpBroadcast::deserializeParameters(const std::span<const uint8_t> data) {
-  const json jsonData = deserializeJson(data);
-  ipAddress = jsonData.value("IP", "");
-  port = jsonData.value("Port", 0);
-  deviceType = jsonData.value("DeviceType", "");
-  deviceId = jsonData.value("ID", "");
-  rs485Address = jsonData.value("RS485", 0);
-  rs232BaudRate = jsonData.value("RS232Baud", 0);
-  rs485BaudRate = jsonData.value("RS485Baud", 0);
-  internalModel = jsonData.value("ti", 0);
+  ipAddress.clear();
+  port = 0;
+  deviceType.clear();
+  deviceId.clear();
+  rs485Address = 0;
+  rs232BaudRate = 0;
+  rs485BaudRate = 0;
+  internalModel = 0;
+
+  JsonReader reader{data};
+  if (!reader.beginObject()) return;
+
+  std::string_view key;
+  while (reader.nextKey(key)) {
+    const auto it = k_fields.find(frozen::string{key.data(), key.size()});
+
+    if (it == k_fields.end()) {
+      reader.skipValue();
+      continue;
+    }
+
+    switch (it->second) {
+      case Field::IP:
+        reader.readString(ipAddress);
+        break;
+      case Field::Port:
+        reader.read(port);
+        break;
+      case Field::DeviceType:
+        reader.readString(deviceType);
+        break;
+      case Field::ID:
+        reader.readString(deviceId);
+        break;
+      case Field::RS485:
+        reader.read(rs485Address);
+        break;
+      case Field::RS232Baud:
+        reader.read(rs232BaudRate);
+        break;
+      case Field::RS485Baud:
+        reader.read(rs485BaudRate);
+        break;
+      case Field::ti:
+        reader.read(internalModel);
+        break;
+    }
+  }
 }
 
 }  // namespace vanch
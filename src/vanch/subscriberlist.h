@@ -0,0 +1,79 @@
+#pragma once
+
+#include <asio.hpp>
+
+namespace vanch {
+
+// Subscribers to one kind of event. Publishing reads an immutable snapshot of the list without taking a lock, and
+// subscribing or unsubscribing publishes a new snapshot (copy-on-write), so a slow subscriber never blocks changes
+// to the list and registration never blocks dispatch.
+template <typename... Args>
+class SubscriberList {
+ public:
+  using Callback = std::function<void(Args...)>;
+  using SubscriptionId = uint64_t;
+
+  SubscriberList() : m_snapshot(std::make_shared<const Snapshot>()) {}
+
+  // Without an executor the callback runs inline on the publishing thread. With one, it is posted there together
+  // with copies of the arguments, which keeps slow consumers off the I/O threads; pass a strand to keep order.
+  SubscriptionId subscribe(Callback callback, std::optional<asio::any_io_executor> executor = std::nullopt) {
+    std::lock_guard lock(m_writeMutex);
+
+    const auto id = m_nextId++;
+    auto snapshot = std::make_shared<Snapshot>(*m_snapshot.load());
+    snapshot->push_back({id, std::move(callback), std::move(executor)});
+    m_snapshot.store(std::move(snapshot));
+
+    return id;
+  }
+
+  void unsubscribe(const SubscriptionId id) {
+    std::lock_guard lock(m_writeMutex);
+
+    auto snapshot = std::make_shared<Snapshot>(*m_snapshot.load());
+    std::erase_if(*snapshot, [id](const Subscriber& subscriber) { return subscriber.id == id; });
+    m_snapshot.store(std::move(snapshot));
+  }
+
+  void clear() {
+    std::lock_guard lock(m_writeMutex);
+    m_snapshot.store(std::make_shared<const Snapshot>());
+  }
+
+  [[nodiscard]] bool empty() const { return m_snapshot.load()->empty(); }
+
+  void publish(Args... args) const {
+    const auto snapshot = m_snapshot.load();
+
+    for (const auto& subscriber : *snapshot) {
+      if (!subscriber.executor) {
+        subscriber.callback(args...);
+        continue;
+      }
+
+      asio::post(*subscriber.executor, [callback = subscriber.callback, stored = std::tuple<Stored<Args>...>(args...)] {
+        std::apply(callback, stored);
+      });
+    }
+  }
+
+ private:
+  struct Subscriber {
+    SubscriptionId id;
+    Callback callback;
+    std::optional<asio::any_io_executor> executor;
+  };
+
+  using Snapshot = std::vector<Subscriber>;
+
+  // Views into the publisher's buffers do not survive a post, so deferred calls keep owning copies
+  template <typename T>
+  using Stored = std::conditional_t<std::is_same_v<std::decay_t<T>, std::string_view>, std::string, std::decay_t<T>>;
+
+  std::atomic<std::shared_ptr<const Snapshot>> m_snapshot;
+  std::mutex m_writeMutex;
+  SubscriptionId m_nextId{1};
+};
+
+}  // namespace vanch
@@ -0,0 +1,79 @@
+#include "tagid.h"
+
+namespace vanch {
+
+namespace {
+
+constexpr std::array<int8_t, 256> k_hexValues = [] {
+  std::array<int8_t, 256> values{};
+  values.fill(-1);
+  for (int i = 0; i < 10; ++i) values['0' + i] = static_cast<int8_t>(i);
+  for (int i = 0; i < 6; ++i) {
+    values['a' + i] = static_cast<int8_t>(10 + i);
+    values['A' + i] = static_cast<int8_t>(10 + i);
+  }
+  return values;
+}();
+
+constexpr std::string_view k_hexDigits = "0123456789ABCDEF";
+
+}  // namespace
+
+bool TagId::assignHex(const std::string_view hex) {
+  const auto size = (hex.size() + 1) / 2;
+
+  uint8_t* out;
+  if (size <= k_inlineCapacity) {
+    m_heap.clear();
+    out = m_inline.data();
+  } else {
+    m_heap.resize(size);
+    out = m_heap.data();
+  }
+
+  size_t digit = 0;
+
+  // A lone leading digit forms the low nibble of the first byte
+  if (hex.size() % 2 != 0) {
+    const auto value = k_hexValues[static_cast<uint8_t>(hex[0])];
+    if (value < 0) {
+      clear();
+      return false;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    digit = 1;
+  }
+
+  for (; digit < hex.size(); digit += 2) {
+    const auto high = k_hexValues[static_cast<uint8_t>(hex[digit])];
+    const auto low = k_hexValues[static_cast<uint8_t>(hex[digit + 1])];
+
+    if ((high | low) < 0) {
+      clear();
+      return false;
+    }
+
+    *out++ = static_cast<uint8_t>((high << 4) | low);
+  }
+
+  m_size = static_cast<uint32_t>(size);
+  return true;
+}
+
+std::string TagId::toHex() const {
+  std::string hex;
+  appendHex(hex);
+  return hex;
+}
+
+void TagId::appendHex(std::string& out) const {
+  const auto data = bytes();
+  out.reserve(out.size() + data.size() * 2);
+
+  for (const auto byte : data) {
+    out.push_back(k_hexDigits[byte >> 4]);
+    out.push_back(k_hexDigits[byte & 0x0F]);
+  }
+}
+
+}  // namespace vanch
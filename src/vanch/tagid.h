@@ -0,0 +1,73 @@
+#pragma once
+
+namespace vanch {
+
+// Tag memory contents (EPC, TID, user area) as decoded bytes. Up to k_inlineCapacity bytes are stored inline, which
+// covers 96 and 128-bit EPCs as well as the usual TIDs without touching the heap; longer values spill into a vector.
+class TagId {
+ public:
+  static constexpr size_t k_inlineCapacity = 32;
+
+  TagId() = default;
+
+  explicit TagId(const std::span<const uint8_t> bytes) { assign(bytes); }
+
+  void assign(const std::span<const uint8_t> bytes) {
+    m_size = static_cast<uint32_t>(bytes.size());
+
+    if (bytes.size() <= k_inlineCapacity) {
+      m_heap.clear();
+      std::ranges::copy(bytes, m_inline.begin());
+    } else {
+      m_heap.assign(bytes.begin(), bytes.end());
+    }
+  }
+
+  // Decodes a hex string such as the readers send. An odd digit count is treated as having a leading zero. On
+  // invalid input the id is left empty and false is returned.
+  bool assignHex(std::string_view hex);
+
+  void clear() {
+    m_size = 0;
+    m_heap.clear();
+  }
+
+  [[nodiscard]] std::span<const uint8_t> bytes() const {
+    return m_size <= k_inlineCapacity ? std::span<const uint8_t>(m_inline.data(), m_size)
+                                      : std::span<const uint8_t>(m_heap);
+  }
+
+  [[nodiscard]] size_t size() const { return m_size; }
+
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+  // Upper-case hex, as the readers format it
+  [[nodiscard]] std::string toHex() const;
+
+  void appendHex(std::string& out) const;
+
+  [[nodiscard]] uint64_t hash() const {
+    const auto data = bytes();
+    return std::hash<std::string_view>{}({reinterpret_cast<const char*>(data.data()), data.size()});
+  }
+
+  friend bool operator==(const TagId& lhs, const TagId& rhs) { return std::ranges::equal(lhs.bytes(), rhs.bytes()); }
+
+  friend std::strong_ordering operator<=>(const TagId& lhs, const TagId& rhs) {
+    const auto a = lhs.bytes();
+    const auto b = rhs.bytes();
+    return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+  }
+
+ private:
+  uint32_t m_size{0};
+  std::array<uint8_t, k_inlineCapacity> m_inline{};
+  std::vector<uint8_t> m_heap;
+};
+
+}  // namespace vanch
+
+template <>
+struct std::hash<vanch::TagId> {
+  size_t operator()(const vanch::TagId& id) const noexcept { return id.hash(); }
+};
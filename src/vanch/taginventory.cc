@@ -0,0 +1,181 @@
+#include "taginventory.h"
+
+namespace vanch {
+
+TagInventory::TagInventory(const TagInventoryOptions& options)
+    : m_options(options), m_slots(k_initialCapacity), m_mask(k_initialCapacity - 1) {}
+
+void TagInventory::setOptions(const TagInventoryOptions& options) {
+  std::lock_guard lock(m_mutex);
+  m_options = options;
+}
+
+TagInventoryOptions TagInventory::getOptions() const {
+  std::lock_guard lock(m_mutex);
+  return m_options;
+}
+
+bool TagInventory::record(const StatusAutoCardReading& reading, const std::chrono::steady_clock::time_point now) {
+  std::lock_guard lock(m_mutex);
+
+  expireLocked(now, k_expireStepsPerRead);
+
+  const auto hash = reading.epc.hash();
+  auto slot = findSlot(reading.epc, hash);
+
+  if (m_slots[slot].record == k_emptySlot) {
+    // Keep the load factor at or below one half so probe sequences stay short
+    if ((m_records.size() + 1) * 2 > m_slots.size()) {
+      grow();
+      slot = findSlot(reading.epc, hash);
+    }
+
+    m_slots[slot] = {hash, static_cast<uint32_t>(m_records.size())};
+    m_hashes.push_back(hash);
+
+    auto& tag = m_records.emplace_back();
+    tag.epc = reading.epc;
+    tag.firstSeen = now;
+    tag.lastCounted = now - m_options.dedupWindow;
+  }
+
+  auto& tag = m_records[m_slots[slot].record];
+  tag.lastSeen = now;
+
+  if (now - tag.lastCounted < m_options.dedupWindow) {
+    ++tag.duplicateCount;
+    ++m_duplicates;
+    return false;
+  }
+
+  tag.lastCounted = now;
+  ++tag.readCount;
+  ++m_reads;
+
+  tag.lastAntenna = reading.antennaNumber;
+  if (reading.antennaNumber < TagRecord::k_maxAntennas) ++tag.antennaReads[reading.antennaNumber];
+
+  tag.rssiMin = std::min(tag.rssiMin, reading.rssi);
+  tag.rssiMax = std::max(tag.rssiMax, reading.rssi);
+  tag.rssiSum += reading.rssi;
+
+  tag.deviceId = reading.deviceId;
+
+  return true;
+}
+
+size_t TagInventory::expire(const std::chrono::steady_clock::time_point now, const size_t maxSteps) {
+  std::lock_guard lock(m_mutex);
+  return expireLocked(now, maxSteps);
+}
+
+void TagInventory::clear() {
+  std::lock_guard lock(m_mutex);
+
+  m_records.clear();
+  m_hashes.clear();
+  std::ranges::fill(m_slots, Slot{});
+  m_expireCursor = 0;
+}
+
+size_t TagInventory::size() const {
+  std::lock_guard lock(m_mutex);
+  return m_records.size();
+}
+
+void TagInventory::snapshot(std::vector<TagRecord>& out) const {
+  std::lock_guard lock(m_mutex);
+  out.assign(m_records.begin(), m_records.end());
+}
+
+TagInventoryStats TagInventory::getStats() const {
+  std::lock_guard lock(m_mutex);
+
+  return {
+      .reads = m_reads,
+      .duplicates = m_duplicates,
+      .expired = m_expired,
+      .tags = m_records.size(),
+  };
+}
+
+size_t TagInventory::findSlot(const TagId& epc, const uint64_t hash) const {
+  auto index = hash & m_mask;
+
+  while (true) {
+    const auto& slot = m_slots[index];
+    if (slot.record == k_emptySlot) return index;
+    if (slot.hash == hash && m_records[slot.record].epc == epc) return index;
+    index = (index + 1) & m_mask;
+  }
+}
+
+void TagInventory::grow() {
+  std::vector<Slot> slots(m_slots.size() * 2);
+  const auto mask = slots.size() - 1;
+
+  for (uint32_t i = 0; i < m_records.size(); ++i) {
+    auto index = m_hashes[i] & mask;
+    while (slots[index].record != k_emptySlot) index = (index + 1) & mask;
+    slots[index] = {m_hashes[i], i};
+  }
+
+  m_slots = std::move(slots);
+  m_mask = mask;
+}
+
+void TagInventory::removeRecord(const uint32_t index) {
+  auto hole = findSlot(m_records[index].epc, m_hashes[index]);
+
+  // Backward-shift deletion: pull later entries of the probe run into the hole so no tombstones are needed
+  auto next = (hole + 1) & m_mask;
+
+  while (m_slots[next].record != k_emptySlot) {
+    const auto home = m_slots[next].hash & m_mask;
+
+    // The entry may move only if the hole lies between its home slot and its current position
+    if (((next - home) & m_mask) >= ((next - hole) & m_mask)) {
+      m_slots[hole] = m_slots[next];
+      hole = next;
+    }
+
+    next = (next + 1) & m_mask;
+  }
+
+  m_slots[hole] = Slot{};
+
+  // Fill the gap in the dense storage with the last record and repoint its slot
+  const auto last = static_cast<uint32_t>(m_records.size() - 1);
+
+  if (index != last) {
+    m_slots[findSlot(m_records[last].epc, m_hashes[last])].record = index;
+    m_records[index] = std::move(m_records[last]);
+    m_hashes[index] = m_hashes[last];
+  }
+
+  m_records.pop_back();
+  m_hashes.pop_back();
+}
+
+size_t TagInventory::expireLocked(const std::chrono::steady_clock::time_point now, const size_t maxSteps) {
+  size_t removed{};
+
+  for (size_t step = 0; step < maxSteps && !m_records.empty(); ++step) {
+    if (m_expireCursor >= m_records.size()) m_expireCursor = 0;
+
+    const auto index = static_cast<uint32_t>(m_expireCursor);
+
+    if (now - m_records[index].lastSeen > m_options.timeToLive) {
+      // The last record takes this position, so the cursor stays to check it next
+      removeRecord(index);
+      ++removed;
+    } else {
+      ++m_expireCursor;
+    }
+  }
+
+  m_expired += removed;
+  return removed;
+}
+
+}  // namespace vanch
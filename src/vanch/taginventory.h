@@ -0,0 +1,104 @@
+#pragma once
+
+#include "statuses/status.h"
+
+namespace vanch {
+
+struct TagRecord {
+  static constexpr size_t k_maxAntennas = 32;
+
+  TagId epc;
+  InternedString deviceId;  // Reader of the most recent read
+  std::chrono::steady_clock::time_point firstSeen;
+  std::chrono::steady_clock::time_point lastSeen;
+  std::chrono::steady_clock::time_point lastCounted;
+  uint64_t readCount{0};
+  uint64_t duplicateCount{0};
+  std::array<uint32_t, k_maxAntennas> antennaReads{};  // Indexed by the antenna number the reader reports
+  uint8_t lastAntenna{0};
+  int8_t rssiMin{std::numeric_limits<int8_t>::max()};
+  int8_t rssiMax{std::numeric_limits<int8_t>::min()};
+  int64_t rssiSum{0};
+
+  [[nodiscard]] double getRssiMean() const {
+    return readCount > 0 ? static_cast<double>(rssiSum) / static_cast<double>(readCount) : 0.0;
+  }
+};
+
+struct TagInventoryOptions {
+  std::chrono::milliseconds dedupWindow{100};
+  std::chrono::milliseconds timeToLive{30000};
+};
+
+struct TagInventoryStats {
+  uint64_t reads{0};
+  uint64_t duplicates{0};
+  uint64_t expired{0};
+  size_t tags{0};
+};
+
+// Live set of tags built from auto-reading reports. Reads of a tag within the dedup window only refresh its last
+// seen time; the rest update its counters and RSSI statistics. Tags not seen for the time-to-live are removed a few
+// at a time on every read and on expire(), so no single call walks the whole set.
+//
+// Records live in a dense vector for cheap iteration and removal by swap; an open-addressing index with linear
+// probing and backward-shift deletion maps the EPC to the record.
+class TagInventory {
+ public:
+  explicit TagInventory(const TagInventoryOptions& options = {});
+
+  void setOptions(const TagInventoryOptions& options);
+
+  [[nodiscard]] TagInventoryOptions getOptions() const;
+
+  // Returns false if the read fell into the dedup window of the tag.
+  bool record(const StatusAutoCardReading& reading,
+              std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  // Checks at most maxSteps records for expiry. Returns the number of removed tags.
+  size_t expire(std::chrono::steady_clock::time_point now, size_t maxSteps);
+
+  void clear();
+
+  [[nodiscard]] size_t size() const;
+
+  // Copies all records into out, reusing its storage.
+  void snapshot(std::vector<TagRecord>& out) const;
+
+  [[nodiscard]] TagInventoryStats getStats() const;
+
+ private:
+  static constexpr uint32_t k_emptySlot = std::numeric_limits<uint32_t>::max();
+  static constexpr size_t k_initialCapacity = 64;
+  static constexpr size_t k_expireStepsPerRead = 2;
+
+  struct Slot {
+    uint64_t hash{0};
+    uint32_t record{k_emptySlot};
+  };
+
+  // Index of the slot holding the EPC, or of the empty slot where it belongs
+  [[nodiscard]] size_t findSlot(const TagId& epc, uint64_t hash) const;
+
+  void grow();
+
+  void removeRecord(uint32_t index);
+
+  size_t expireLocked(std::chrono::steady_clock::time_point now, size_t maxSteps);
+
+  mutable std::mutex m_mutex;
+  TagInventoryOptions m_options;
+
+  std::vector<TagRecord> m_records;
+  std::vector<uint64_t> m_hashes;  // Parallel to m_records
+  std::vector<Slot> m_slots;
+  size_t m_mask;
+
+  size_t m_expireCursor{0};
+
+  uint64_t m_reads{0};
+  uint64_t m_duplicates{0};
+  uint64_t m_expired{0};
+};
+
+}  // namespace vanch
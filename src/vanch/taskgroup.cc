@@ -0,0 +1,29 @@
+#include "taskgroup.h"
+
+namespace vanch {
+
+TaskGroup::TaskGroup(const asio::any_io_executor& executor, const size_t limit)
+    : m_strand(asio::make_strand(executor)),
+      m_limit(std::max<size_t>(limit, 1)),
+      m_finishedSignal(m_strand, steady_timer::time_point::max()) {}
+
+asio::awaitable<void> TaskGroup::launch(std::function<asio::awaitable<void>()> task) {
+  while (m_running >= m_limit) co_await m_finishedSignal.async_wait();
+
+  ++m_running;
+
+  co_spawn(
+      m_strand,
+      [this, task = std::move(task)]() -> asio::awaitable<void> {
+        co_await task();
+        --m_running;
+        m_finishedSignal.cancel();
+      },
+      asio::detached);
+}
+
+asio::awaitable<void> TaskGroup::wait() {
+  while (m_running > 0) co_await m_finishedSignal.async_wait();
+}
+
+}  // namespace vanch
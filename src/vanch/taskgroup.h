@@ -0,0 +1,31 @@
+#pragma once
+
+#include "asiotypes.h"
+
+namespace vanch {
+
+// Runs coroutines in the background with at most a limited number unfinished at once. Tasks start in the order they
+// are launched, all on the group's strand, so requests they issue reach a reader's command queue in that order. Must
+// only be used from coroutines running on the strand.
+class TaskGroup {
+ public:
+  TaskGroup(const asio::any_io_executor& executor, size_t limit);
+
+  [[nodiscard]] const asio::strand<asio::any_io_executor>& getStrand() const { return m_strand; }
+
+  // Resumes once fewer than limit tasks are unfinished and the task has been started.
+  asio::awaitable<void> launch(std::function<asio::awaitable<void>()> task);
+
+  // Resumes once every launched task has finished.
+  asio::awaitable<void> wait();
+
+ private:
+  asio::strand<asio::any_io_executor> m_strand;
+  size_t m_limit;
+  size_t m_running{0};
+
+  // Never expires; cancelled whenever a task finishes
+  steady_timer m_finishedSignal;
+};
+
+}  // namespace vanch
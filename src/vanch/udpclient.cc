@@ -9,7 +9,8 @@ UdpClient::UdpClient(asio::io_context& io, const std::string& serverIp, const ui
       m_io(io),
       m_socket(io),
       m_broadcastSocket(io),
-      m_serverEndpoint(asio::ip::make_address(serverIp), serverPort),
+      m_session(std::make_shared<ReaderSession>(
+          m_socket, asio::ip::udp::endpoint(asio::ip::make_address(serverIp), serverPort))),
       m_isRunning(false) {}
 
 UdpClient::~UdpClient() {
@@ -32,14 +33,14 @@ void UdpClient::setServerEndpoint(const std::string& serverIp, uint16_t serverPo
     return;
   }
 
-  m_serverEndpoint.address(ip);
-  m_serverEndpoint.port(serverPort);
+  const bool wasRunning = m_isRunning;
 
-  if (m_isRunning) {
-    stop();
-    start();
-  }
+  stop();
+  m_session->setEndpoint({ip, serverPort});
+
+  if (wasRunning) start();
 }
+
 bool UdpClient::isRunning() { return m_isRunning; }
 
 void UdpClient::start() {
@@ -65,10 +66,13 @@ void UdpClient::start() {
 
   logger->info("UDP Client port: {}", m_socket.local_endpoint().port());
 
+  // Readiness is awaited asynchronously and the batch reader must never block the I/O thread
+  m_socket.non_blocking(true, ec);
+
   m_isRunning = true;
 
+  m_session->start();
   co_spawn(m_io, listenLoop(), asio::detached);
-  co_spawn(m_io, sendLoop(), asio::detached);
 }
 
 void UdpClient::stop() {
@@ -77,6 +81,7 @@ void UdpClient::stop() {
   logger->info("Stopping UDP Client");
 
   m_isRunning = false;
+  m_session->stop();
   m_socket.close();
 }
 
@@ -111,6 +116,7 @@ void UdpClient::startBroadcastListening() {
   }
 
   if (broadcastOk) {
+    m_broadcastSocket.non_blocking(true, ec);
     logger->info("UDP Broadcast Server port: {}", m_broadcastSocket.local_endpoint().port());
   } else {
     logger->warn("UDP Broadcast Server socket is not available until the next restart");
@@ -124,167 +130,110 @@ void UdpClient::stopBroadcastListening() {
   m_broadcastSocket.close();
 }
 
-void UdpClient::sendCommand(const std::shared_ptr<IMessage>& command) {
+void UdpClient::sendCommand(const std::shared_ptr<IMessage>& command, const std::optional<CommandPriority> priority) {
   if (!m_isRunning) {
     logger->warn("Could not enqueue command. Client is closed!");
     return;
   }
 
-  if (!m_commandQueue.try_enqueue(command)) {
-    logger->warn("Failed to enqueue command. Command queue is full");
-  }
+  m_session->sendCommand(command, priority);
 }
 
-void UdpClient::setCommandCallback(const CommandCallback& callback) {
-  std::lock_guard lock(m_callbackMutex);
-  m_commandCallback = callback;
-}
+void UdpClient::setRequestWindow(const size_t window) { m_session->setRequestWindow(window); }
 
-void UdpClient::setStatusCallback(const StatusCallback& callback) {
-  std::lock_guard lock(m_callbackMutex);
-  m_statusCallback = callback;
-}
-
-void UdpClient::setBroadcastCallback(const BroadcastCallback& callback) {
-  std::lock_guard lock(m_callbackMutex);
-  m_broadcastCallback = callback;
-}
+ReaderSessionStats UdpClient::getStats() const { return m_session->getStats(); }
 
-void UdpClient::setErrorCallback(const ErrorCallback& callback) {
-  std::lock_guard lock(m_callbackMutex);
-  m_errorCallback = callback;
+void UdpClient::setCapture(const std::shared_ptr<FrameCapture>& capture) {
+  m_capture.store(capture);
+  m_session->setCapture(capture);
 }
 
-asio::awaitable<bool> UdpClient::tryDequeueCoWait(std::shared_ptr<IMessage>& message) {
-  if (m_commandQueue.try_dequeue(message)) co_return true;
-
-  auto timer = steady_timer{co_await asio::this_coro::executor, std::chrono::milliseconds(100)};
-
-  if (auto [ec] = co_await timer.async_wait(); ec && ec != asio::error::operation_aborted) {
-    logger->error("Failed to dequeue message from command queue");
-  }
+void UdpClient::injectBroadcast(const std::span<const uint8_t> datagram) {
+  // The listen loop owns the broadcast decoder, so replays decode on their own
+  FrameDecoder decoder;
 
-  co_return false;
+  decoder.feedDatagram(datagram, [this](const std::span<const uint8_t> frame) {
+    if (auto message = MessageRegistry::createFromData(frame); message && message->getType() == MessageType_Status) {
+      m_broadcastSubscribers.publish(message);
+    }
+  });
 }
 
 asio::awaitable<void> UdpClient::listenLoop() {
-  std::array<uint8_t, 1500> buffer{};
-  asio::ip::udp::endpoint remoteEndpoint;
+  DatagramBatch batch{k_receiveBatchSize};
 
   while (m_isRunning) {
-    auto [ec, bytesReceived] = co_await m_socket.async_receive_from(asio::buffer(buffer), remoteEndpoint);
+    auto [waitEc] = co_await m_socket.async_wait(asio::socket_base::wait_read);
+
+    if (waitEc) {
+      if (waitEc == asio::error::operation_aborted && !m_isRunning) break;
+      m_session->reportError("Error receiving response: " + waitEc.message());
+      continue;
+    }
+
+    asio::error_code ec;
+    batch.receive(m_socket, ec);
 
     if (ec) {
-      if (ec == asio::error::operation_aborted && !m_isRunning) break;
       if (ec == asio::error::connection_refused || ec == asio::error::connection_reset) {
-        logger->warn("Destination peer is unreachable ({}:{})", remoteEndpoint.address().to_string(),
-                     remoteEndpoint.port());
+        const auto& endpoint = m_session->getEndpoint();
+        logger->warn("Destination peer is unreachable ({}:{})", endpoint.address().to_string(), endpoint.port());
         continue;
       }
-      invokeErrorCallback("Error receiving response: " + ec.message());
+      m_session->reportError("Error receiving response: " + ec.message());
       continue;
     }
 
-    if (remoteEndpoint != m_serverEndpoint) continue;
-
-    handleResponse({buffer.begin(), buffer.begin() + bytesReceived}, ec);
+    for (const auto& datagram : batch.datagrams()) {
+      if (datagram.endpoint == m_session->getEndpoint()) m_session->receive(datagram.data);
+    }
   }
 }
 
 asio::awaitable<void> UdpClient::broadcastListenLoop() {
-  std::array<uint8_t, 1500> buffer{};
-  asio::ip::udp::endpoint remoteEndpoint;
+  DatagramBatch batch{k_receiveBatchSize};
 
   while (true) {
-    auto [ec, bytesReceived] = co_await m_broadcastSocket.async_receive_from(asio::buffer(buffer), remoteEndpoint);
+    auto [waitEc] = co_await m_broadcastSocket.async_wait(asio::socket_base::wait_read);
 
-    if (ec) {
-      if (ec == asio::error::operation_aborted) break;
-      invokeErrorCallback("Error receiving broadcast: " + ec.message());
+    if (waitEc) {
+      if (waitEc == asio::error::operation_aborted) break;
+      m_session->reportError("Error receiving broadcast: " + waitEc.message());
       continue;
     }
 
-    handleBroadcast({buffer.begin(), buffer.begin() + bytesReceived}, ec);
-  }
-}
-
-asio::awaitable<void> UdpClient::sendLoop() {
-  while (m_isRunning) {
-    std::shared_ptr<IMessage> command;
+    asio::error_code ec;
+    batch.receive(m_broadcastSocket, ec);
 
-    if (!co_await tryDequeueCoWait(command)) continue;
-
-    auto data = command->serialize();
-    auto buffer = asio::buffer(data.data(), data.size());
-
-    if (auto [ec, _] = co_await m_socket.async_send_to(buffer, m_serverEndpoint); ec) {
-      invokeErrorCallback("Failed to send command: " + ec.message());
-    }
-  }
-}
-
-void UdpClient::handleResponse(const std::vector<uint8_t>&& data, const asio::error_code& ec) {
-  if (ec && data.empty()) return;
-
-  if (const auto message = MessageRegistry::createFromData(data)) {
-    if (message->getType() == MessageType_Return) {
-      invokeCommandCallback(message);
-      return;
-    }
-
-    if (message->getType() == MessageType_Status) {
-      invokeStatusCallback(message);
-      return;
-    }
-
-    if (message->getType() == MessageType_Error) {
-      const auto code = message->getCmdCode();
-      invokeErrorCallback(MessageRegistry::getErrorMessage(code), code);
-      invokeCommandCallback(message);
-      return;
+    if (ec) {
+      m_session->reportError("Error receiving broadcast: " + ec.message());
+      continue;
     }
 
-    logger->warn("Cannot handle packet with header 0x{:02x} and code 0x{:02x}",
-                 static_cast<uint8_t>(message->getType()), message->getCmdCode());
+    handleBroadcasts(batch);
   }
 }
 
-void UdpClient::handleBroadcast(const std::vector<uint8_t>&& data, const asio::error_code& ec) {
-  if (ec && data.empty()) return;
+void UdpClient::handleBroadcasts(const DatagramBatch& batch) {
+  m_decodedBroadcasts.clear();
 
-  if (const auto message = MessageRegistry::createFromData(data)) {
-    if (message->getType() == MessageType_Status) {
-      invokeBroadcastCallback(message);
-    }
-  }
-}
+  const auto capture = m_capture.load();
 
-void UdpClient::invokeCommandCallback(const std::shared_ptr<IMessage>& response) {
-  std::lock_guard lock(m_callbackMutex);
-  if (m_commandCallback) {
-    m_commandCallback(response);
-  }
-}
+  for (const auto& datagram : batch.datagrams()) {
+    if (capture) capture->record(FrameDirection::Inbound, CaptureChannel::Broadcast, datagram.endpoint, datagram.data);
 
-void UdpClient::invokeStatusCallback(const std::shared_ptr<IMessage>& status) {
-  std::lock_guard lock(m_callbackMutex);
-  if (m_statusCallback) {
-    m_statusCallback(status);
+    m_broadcastDecoder.feedDatagram(datagram.data, [this](const std::span<const uint8_t> frame) {
+      if (auto message = MessageRegistry::createFromData(frame); message && message->getType() == MessageType_Status) {
+        m_decodedBroadcasts.push_back(std::move(message));
+      }
+    });
   }
-}
 
-void UdpClient::invokeBroadcastCallback(const std::shared_ptr<IMessage>& broadcast) {
-  std::lock_guard lock(m_callbackMutex);
-  if (m_broadcastCallback) {
-    m_broadcastCallback(broadcast);
-  }
-}
+  if (m_decodedBroadcasts.empty()) return;
 
-void UdpClient::invokeErrorCallback(const std::string_view error, const uint8_t code) {
-  std::lock_guard lock(m_callbackMutex);
-  if (m_errorCallback) {
-    m_errorCallback(error, code);
-  }
+  for (const auto& message : m_decodedBroadcasts) m_broadcastSubscribers.publish(message);
+
+  m_decodedBroadcasts.clear();
 }
 
 }  // namespace vanch
@@ -1,26 +1,20 @@
 #pragma once
 
-#include <readerwritercircularbuffer.h>
-
-#include <asio.hpp>
-#include <asio/awaitable.hpp>
 #include <nlohmann/json.hpp>
 
+#include "asiotypes.h"
+#include "datagrambatch.h"
+#include "framedecoder.h"
 #include "krog/util/loggable.h"
 #include "message.h"
-
-using default_token = asio::as_tuple_t<asio::use_awaitable_t<>>;
-using udp_socket = default_token::as_default_on_t<asio::ip::udp::socket>;
-using steady_timer = default_token::as_default_on_t<asio::steady_timer>;
+#include "readersession.h"
 
 namespace vanch {
 
 class UdpClient final : kr::Loggable {
  public:
-  using CommandCallback = std::function<void(const std::shared_ptr<IMessage>&)>;
-  using StatusCallback = std::function<void(const std::shared_ptr<IMessage>&)>;
-  using BroadcastCallback = std::function<void(const std::shared_ptr<IMessage>&)>;
-  using ErrorCallback = std::function<void(std::string_view, uint8_t code)>;
+  using MessageSubscribers = ReaderSession::MessageSubscribers;
+  using ErrorSubscribers = ReaderSession::ErrorSubscribers;
 
   UdpClient(asio::io_context& io, const std::string& serverIp, uint16_t serverPort);
 
@@ -40,54 +34,66 @@ class UdpClient final : kr::Loggable {
 
   void stopBroadcastListening();
 
-  void sendCommand(const std::shared_ptr<IMessage>& command);
+  // See ReaderSession::sendCommand.
+  void sendCommand(const std::shared_ptr<IMessage>& command, std::optional<CommandPriority> priority = {});
 
-  void setCommandCallback(const CommandCallback& callback);
+  // See ReaderSession::request.
+  template <typename Cmd>
+  asio::awaitable<RequestResult<ReturnOf_t<Cmd>>> request(std::shared_ptr<Cmd> command, RequestOptions options = {}) {
+    return m_session->request(std::move(command), options);
+  }
 
-  void setStatusCallback(const StatusCallback& callback);
+  void setRequestWindow(size_t window);
 
-  void setBroadcastCallback(const BroadcastCallback& callback);
+  // For engines that drive the reader through its session, such as the TagProgrammer
+  [[nodiscard]] const std::shared_ptr<ReaderSession>& getSession() const { return m_session; }
 
-  void setErrorCallback(const ErrorCallback& callback);
+  MessageSubscribers& onReturn() { return m_session->onReturn(); }
 
- private:
-  asio::awaitable<bool> tryDequeueCoWait(std::shared_ptr<IMessage>& message);
+  MessageSubscribers& onStatus() { return m_session->onStatus(); }
 
-  asio::awaitable<void> listenLoop();
+  // Status messages received on the broadcast port from any device
+  MessageSubscribers& onBroadcast() { return m_broadcastSubscribers; }
 
-  asio::awaitable<void> broadcastListenLoop();
+  ErrorSubscribers& onError() { return m_session->onError(); }
 
-  asio::awaitable<void> sendLoop();
+  [[nodiscard]] ReaderSessionStats getStats() const;
 
-  void handleResponse(const std::vector<uint8_t>&& data, const asio::error_code& ec);
+  [[nodiscard]] std::vector<CommandLatency> getLatencies() const { return m_session->getLatencies(); }
 
-  void handleBroadcast(const std::vector<uint8_t>&& data, const asio::error_code& ec);
+  void resetLatencies() { m_session->resetLatencies(); }
 
-  void invokeCommandCallback(const std::shared_ptr<IMessage>& response);
+  // Records the reader's traffic and the broadcasts; pass nullptr to stop.
+  void setCapture(const std::shared_ptr<FrameCapture>& capture);
 
-  void invokeStatusCallback(const std::shared_ptr<IMessage>& status);
+  // Replays a captured datagram into the reader session. See ReaderSession::inject.
+  bool injectDatagram(std::span<const uint8_t> datagram) { return m_session->inject(datagram); }
 
-  void invokeBroadcastCallback(const std::shared_ptr<IMessage>& broadcast);
+  // Replays a captured broadcast datagram to the broadcast subscribers on the calling thread.
+  void injectBroadcast(std::span<const uint8_t> datagram);
 
-  void invokeErrorCallback(std::string_view error, uint8_t code = 0xFF);
+ private:
+  asio::awaitable<void> listenLoop();
+
+  asio::awaitable<void> broadcastListenLoop();
+
+  void handleBroadcasts(const DatagramBatch& batch);
 
   static constexpr uint16_t k_defaultBroadcastPort{4444};
+  static constexpr size_t k_receiveBatchSize{32};
 
   asio::io_context& m_io;
   udp_socket m_socket;
   udp_socket m_broadcastSocket;
-  asio::ip::udp::endpoint m_serverEndpoint;
 
-  moodycamel::BlockingReaderWriterCircularBuffer<std::shared_ptr<IMessage>> m_commandQueue{10};
+  std::shared_ptr<ReaderSession> m_session;
+  FrameDecoder m_broadcastDecoder;
+  std::vector<std::shared_ptr<IMessage>> m_decodedBroadcasts;
 
   std::atomic_bool m_isRunning;
 
-  mutable std::mutex m_callbackMutex;
-
-  CommandCallback m_commandCallback;
-  StatusCallback m_statusCallback;
-  BroadcastCallback m_broadcastCallback;
-  ErrorCallback m_errorCallback;
+  MessageSubscribers m_broadcastSubscribers;
+  std::atomic<std::shared_ptr<FrameCapture>> m_capture;
 };
 
 }  // namespace vanch
@@ -0,0 +1,30 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocationmeter.h"
+
+// Replacements of the global allocation functions. They live apart from any code that allocates, since inlining
+// them into their callers makes GCC report the malloc/free pairs as mismatched.
+
+namespace {
+
+thread_local uint64_t s_allocationCount{0};
+thread_local uint64_t s_allocatedBytes{0};
+
+}  // namespace
+
+void* operator new(const std::size_t size) {
+  ++s_allocationCount;
+  s_allocatedBytes += size;
+
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+uint64_t AllocationMeter::getAllocationCount() { return s_allocationCount; }
+
+uint64_t AllocationMeter::getAllocatedBytes() { return s_allocatedBytes; }
@@ -0,0 +1,15 @@
+#include "allocationmeter.h"
+
+AllocationMeter::AllocationMeter() : m_count(getAllocationCount()), m_bytes(getAllocatedBytes()) {}
+
+void AllocationMeter::report(benchmark::State& state, const size_t frameSize) const {
+  const auto count = static_cast<double>(getAllocationCount() - m_count);
+  const auto bytes = static_cast<double>(getAllocatedBytes() - m_bytes);
+
+  state.counters["allocs/op"] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+  state.counters["bytes/op"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+  state.counters["frame"] = static_cast<double>(frameSize);
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frameSize));
+}
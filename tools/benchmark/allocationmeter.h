@@ -0,0 +1,23 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+// Counts heap allocations through the replaced global allocation functions, which see what the codecs allocate
+// through std::vector, std::string and nlohmann::json alike. Measures the thread it was created on.
+class AllocationMeter {
+ public:
+  AllocationMeter();
+
+  // Reports allocs/op and bytes/op since construction, averaged over the iterations, and the frame size the
+  // benchmark worked on.
+  void report(benchmark::State& state, size_t frameSize) const;
+
+ private:
+  // Totals of the calling thread, kept by the allocation functions in allocationhooks.cc
+  static uint64_t getAllocationCount();
+
+  static uint64_t getAllocatedBytes();
+
+  uint64_t m_count;
+  uint64_t m_bytes;
+};
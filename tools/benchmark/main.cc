@@ -0,0 +1,239 @@
+#include <fmt/format.h>
+
+#include "allocationmeter.h"
+#include "vanch/messagelist.h"
+#include "vanch/messageregistry.h"
+#include "vanch/simulator/simulatedreader.h"
+
+// Codec benchmarks for every registered message. Commands and returns are benchmarked in both directions even though
+// commands only encode parameters and returns only decode them, so the framing cost shows up for every type.
+//
+// Every benchmark reports ns/op, the heap allocations and bytes it made per operation (allocs/op, bytes/op) and the
+// frame size it worked on (frame). Run with --benchmark_format=json or --benchmark_out=<file> to track the results
+// across versions.
+
+namespace {
+
+using namespace vanch;
+
+using Frame = std::vector<uint8_t>;
+
+void benchmarkSerialize(benchmark::State& state, const std::shared_ptr<IMessage>& message) {
+  std::array<uint8_t, k_maxFrameSize> buffer{};
+  size_t size = 0;
+
+  const AllocationMeter meter;
+
+  for (auto _ : state) {
+    size = message->serializeInto(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+
+  meter.report(state, size);
+}
+
+// Decodes into the same instance every iteration, as pooled status messages are
+void benchmarkDeserialize(benchmark::State& state, const std::shared_ptr<IMessage>& message, const Frame& frame) {
+  const AllocationMeter meter;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(message->deserialize(std::span{frame}));
+    benchmark::ClobberMemory();
+  }
+
+  meter.report(state, frame.size());
+}
+
+void benchmarkDispatch(benchmark::State& state, const Frame& frame) {
+  const AllocationMeter meter;
+
+  for (auto _ : state) {
+    auto message = MessageRegistry::createFromData(frame);
+    benchmark::DoNotOptimize(message.get());
+  }
+
+  meter.report(state, frame.size());
+}
+
+// Decodes a recorded mix of frames in turn, so branch predictors and caches see traffic rather than one frame
+void benchmarkDispatchMix(benchmark::State& state, const std::vector<Frame>& frames) {
+  size_t bytes = 0;
+  for (const auto& frame : frames) bytes += frame.size();
+
+  const AllocationMeter meter;
+  size_t next = 0;
+
+  for (auto _ : state) {
+    auto message = MessageRegistry::createFromData(frames[next]);
+    benchmark::DoNotOptimize(message.get());
+    if (++next == frames.size()) next = 0;
+  }
+
+  meter.report(state, frames.empty() ? 0 : bytes / frames.size());
+}
+
+std::string_view getKindName(const MessageType type) {
+  switch (type) {
+    case MessageType_Command:
+      return "Command";
+    case MessageType_Return:
+      return "Return";
+    case MessageType_Status:
+      return "Status";
+    default:
+      return "Other";
+  }
+}
+
+std::string makeName(const std::string_view operation, const IMessage& message, const std::string_view variant = {}) {
+  auto name = fmt::format("{}/{}/0x{:02X} {}", operation, getKindName(message.getType()), message.getCmdCode(),
+                          message.getMessageName());
+  if (!variant.empty()) fmt::format_to(std::back_inserter(name), " ({})", variant);
+  return name;
+}
+
+Frame toFrame(const std::span<const uint8_t> data) { return {data.begin(), data.end()}; }
+
+// Frames for the decoding benchmarks. Returns and statuses come from a simulated reader, so they carry the parameters
+// a device sends rather than the empty ones their own encoders write.
+struct Corpus {
+  std::array<Frame, 256> commands;
+  std::array<Frame, 256> returns;
+  std::vector<Frame> autoReads;
+  Frame heartbeat;
+  Frame broadcast;
+  Frame fullAutoRead;
+};
+
+template <typename... Ts>
+void fillCommandFrames(Corpus& corpus, SimulatedReader& reader, MessageList<Ts...>) {
+  std::array<uint8_t, k_maxFrameSize> buffer{};
+
+  const auto add = [&]<typename T>() {
+    if constexpr (T::Traits::s_header == MessageType_Command) {
+      const auto command = T{}.serialize();
+      corpus.commands[T::Traits::s_cmdCode] = command;
+
+      // Default parameters a device rejects yield an error frame; those returns fall back to their own encoding
+      const auto size = reader.handleCommand(command, buffer);
+      if (size > 0 && buffer[0] == MessageType_Return) {
+        corpus.returns[T::Traits::s_cmdCode] = toFrame(std::span{buffer}.first(size));
+      }
+    }
+  };
+
+  (add.template operator()<Ts>(), ...);
+}
+
+Corpus makeCorpus() {
+  Corpus corpus;
+  SimulatedReader reader{SimulatedReaderProfile{.tagPopulation = 1000}};
+  std::array<uint8_t, k_maxFrameSize> buffer{};
+
+  fillCommandFrames(corpus, reader, RegisteredMessages{});
+
+  // The commands above may have left the reader in command mode or without heartbeats
+  reader.reset();
+
+  while (corpus.autoReads.size() < 64) {
+    if (const auto size = reader.makeAutoRead(buffer); size > 0) {
+      corpus.autoReads.push_back(toFrame(std::span{buffer}.first(size)));
+    }
+  }
+
+  corpus.heartbeat = toFrame(std::span{buffer}.first(reader.makeHeartbeat(buffer)));
+  corpus.broadcast = toFrame(std::span{buffer}.first(reader.makeBroadcast(buffer)));
+
+  // A report with every optional field enabled, the largest a reader sends per tag
+  StatusAutoCardReading reading;
+  const std::array<uint8_t, 12> tid{0xE2, 0x80, 0x11, 0x05, 0x20, 0x00, 0x74, 0x3C, 0x8A, 0x1B, 0x09, 0x3F};
+  std::array<uint8_t, 32> userArea{};
+  for (size_t i = 0; i < userArea.size(); ++i) userArea[i] = static_cast<uint8_t>(i * 7);
+
+  reading.deserialize(corpus.autoReads.front());
+  reading.triggeredChannels = {1, 2};
+  reading.direction = InternedString::intern("in");
+  reading.tid.assign(tid);
+  reading.userArea.assign(userArea);
+  reading.temperature = 36.5F;
+  for (size_t i = 0; i < StatusAutoCardReading::k_customFieldCount; ++i) {
+    reading.setCustomField(i, fmt::format("custom field {}", i));
+  }
+
+  corpus.fullAutoRead = reading.serialize();
+
+  return corpus;
+}
+
+template <typename... Ts>
+void registerMessageBenchmarks(const Corpus& corpus, MessageList<Ts...>) {
+  const auto add = [&]<typename T>() {
+    Frame frame;
+    if constexpr (T::Traits::s_header == MessageType_Command) {
+      frame = corpus.commands[T::Traits::s_cmdCode];
+    } else if constexpr (T::Traits::s_header == MessageType_Return) {
+      frame = corpus.returns[T::Traits::s_cmdCode];
+    } else if constexpr (std::is_same_v<T, StatusAutoCardReading>) {
+      frame = corpus.autoReads.front();
+    } else if constexpr (std::is_same_v<T, StatusHeartbeat>) {
+      frame = corpus.heartbeat;
+    } else if constexpr (std::is_same_v<T, StatusUdpBroadcast>) {
+      frame = corpus.broadcast;
+    }
+
+    // Statuses are encoded with the content they were decoded from; the other messages use their defaults
+    auto message = std::make_shared<T>();
+    if (frame.empty()) {
+      frame = message->serialize();
+    } else if constexpr (T::Traits::s_header == MessageType_Status) {
+      message->deserialize(frame);
+    }
+
+    benchmark::RegisterBenchmark(makeName("Serialize", *message).c_str(), benchmarkSerialize, message);
+    benchmark::RegisterBenchmark(makeName("Deserialize", *message).c_str(), benchmarkDeserialize,
+                                 std::make_shared<T>(), frame);
+    benchmark::RegisterBenchmark(makeName("Dispatch", *message).c_str(), benchmarkDispatch, frame);
+  };
+
+  (add.template operator()<Ts>(), ...);
+}
+
+void registerBenchmarks(const Corpus& corpus) {
+  registerMessageBenchmarks(corpus, RegisteredMessages{});
+
+  auto fullReading = std::make_shared<StatusAutoCardReading>();
+  fullReading->deserialize(corpus.fullAutoRead);
+
+  benchmark::RegisterBenchmark(makeName("Serialize", *fullReading, "all fields").c_str(), benchmarkSerialize,
+                               fullReading);
+  benchmark::RegisterBenchmark(makeName("Deserialize", *fullReading, "all fields").c_str(), benchmarkDeserialize,
+                               std::make_shared<StatusAutoCardReading>(), corpus.fullAutoRead);
+  benchmark::RegisterBenchmark(makeName("Dispatch", *fullReading, "all fields").c_str(), benchmarkDispatch,
+                               corpus.fullAutoRead);
+
+  // What a reader in auto mode sends: reads from different tags with the odd heartbeat in between
+  std::vector<Frame> statusMix = corpus.autoReads;
+  statusMix.push_back(corpus.heartbeat);
+  benchmark::RegisterBenchmark("Dispatch/Mix/Auto-reading statuses", benchmarkDispatchMix, statusMix);
+
+  std::vector<Frame> returnMix;
+  for (const auto& frame : corpus.returns) {
+    if (!frame.empty()) returnMix.push_back(frame);
+  }
+  benchmark::RegisterBenchmark("Dispatch/Mix/Returns", benchmarkDispatchMix, returnMix);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto corpus = makeCorpus();
+  registerBenchmarks(corpus);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
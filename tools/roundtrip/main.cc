@@ -0,0 +1,403 @@
+#include <fmt/format.h>
+
+#include <charconv>
+#include <future>
+#include <thread>
+
+#include "backgroundiocontext.h"
+#include "vanch/simulator/readersimulator.h"
+#include "vanch/udpclient.h"
+
+// Drives UdpClient on a BackgroundIoContext against simulated readers on loopback, so the queueing, request
+// tracking and dispatch of the client show up in the numbers, not just the codecs. The simulator runs on its own
+// io_context and threads.
+//
+// Phases:
+//   latency     one request in flight per reader; round-trip distribution for one and for N readers
+//   throughput  a full request window per reader; sustained commands per second for one and for N readers
+//   ingest      auto-reading statuses at doubling rates until the client starts losing them
+
+namespace {
+
+using namespace vanch;
+using Clock = std::chrono::steady_clock;
+
+struct Arguments {
+  size_t readers{8};
+  size_t clientThreads{1};
+  size_t simulatorThreads{1};
+  size_t window{8};  // Requests in flight per reader in the throughput phase
+  std::chrono::seconds duration{3};
+  double maxStatusRate{1'000'000.0};  // Statuses per second across all readers where the ingest phase gives up
+  std::string phases{"latency,throughput,ingest"};
+};
+
+void printUsage() {
+  fmt::print(
+      "Usage: revanche-roundtrip [options]\n"
+      "  --readers N            Readers of the multi-reader runs (8)\n"
+      "  --client-threads N     I/O threads of the client (1)\n"
+      "  --simulator-threads N  I/O threads of the simulator (1)\n"
+      "  --window N             Requests in flight per reader in the throughput phase (8)\n"
+      "  --duration S           Seconds per run (3)\n"
+      "  --max-status-rate R    Statuses per second where the ingest phase stops (1000000)\n"
+      "  --phases LIST          Comma-separated subset of latency,throughput,ingest (all)\n");
+}
+
+template <typename T>
+bool parseNumber(const std::string_view text, T& value) {
+  const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool parseArguments(const int argc, char** argv, Arguments& args) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view name = argv[i];
+
+    if (name == "--help" || name == "-h") return false;
+    if (i + 1 >= argc) {
+      fmt::print(stderr, "Missing value for {}\n", name);
+      return false;
+    }
+
+    const std::string_view value = argv[++i];
+    bool isValid = true;
+
+    if (name == "--readers") {
+      isValid = parseNumber(value, args.readers) && args.readers > 0;
+    } else if (name == "--client-threads") {
+      isValid = parseNumber(value, args.clientThreads) && args.clientThreads > 0;
+    } else if (name == "--simulator-threads") {
+      isValid = parseNumber(value, args.simulatorThreads) && args.simulatorThreads > 0;
+    } else if (name == "--window") {
+      isValid = parseNumber(value, args.window) && args.window > 0;
+    } else if (name == "--duration") {
+      uint32_t seconds{};
+      isValid = parseNumber(value, seconds) && seconds > 0;
+      args.duration = std::chrono::seconds(seconds);
+    } else if (name == "--max-status-rate") {
+      isValid = parseNumber(value, args.maxStatusRate) && args.maxStatusRate > 0.0;
+    } else if (name == "--phases") {
+      args.phases = value;
+    } else {
+      fmt::print(stderr, "Unknown option {}\n", name);
+      return false;
+    }
+
+    if (!isValid) {
+      fmt::print(stderr, "Invalid value for {}: {}\n", name, value);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Latencies of one requesting coroutine, in nanoseconds. Every coroutine fills its own, so recording takes no lock.
+struct Samples {
+  std::vector<int64_t> roundTrips;  // From calling request() to resuming with its result
+  std::vector<int64_t> onWire;      // RequestResult::latency: from transmission to completion
+  uint64_t failures{0};
+
+  void append(const Samples& other) {
+    roundTrips.insert(roundTrips.end(), other.roundTrips.begin(), other.roundTrips.end());
+    onWire.insert(onWire.end(), other.onWire.begin(), other.onWire.end());
+    failures += other.failures;
+  }
+};
+
+struct Percentiles {
+  double p50{0.0};
+  double p99{0.0};
+  double p999{0.0};
+  double max{0.0};
+};
+
+// In microseconds. Sorts the samples.
+Percentiles computePercentiles(std::vector<int64_t>& samples) {
+  if (samples.empty()) return {};
+
+  std::ranges::sort(samples);
+
+  const auto at = [&](const double quantile) {
+    const auto index = std::min(samples.size() - 1, static_cast<size_t>(quantile * static_cast<double>(samples.size())));
+    return static_cast<double>(samples[index]) / 1000.0;
+  };
+
+  return {.p50 = at(0.50), .p99 = at(0.99), .p999 = at(0.999), .max = static_cast<double>(samples.back()) / 1000.0};
+}
+
+// A simulator and one started client per reader. Clients are only stopped when a run ends; they are destroyed with
+// the harness, once the client I/O threads are gone.
+class Harness {
+ public:
+  explicit Harness(const Arguments& args) : m_simulatorWork(asio::make_work_guard(m_simulatorIo)) {
+    m_clientIo.start({.threadCount = args.clientThreads});
+
+    for (size_t i = 0; i < args.simulatorThreads; ++i) {
+      m_simulatorThreads.emplace_back([this] { m_simulatorIo.run(); });
+    }
+  }
+
+  ~Harness() {
+    for (const auto& client : m_clients) client->stop();
+    m_clientIo.stop();
+
+    m_simulatorWork.reset();
+    m_simulatorIo.stop();
+    for (auto& thread : m_simulatorThreads) thread.join();
+  }
+
+  Harness(const Harness&) = delete;
+
+  Harness& operator=(const Harness&) = delete;
+
+  // Starts readerCount simulated readers and a client for each. Returns the clients of the run.
+  std::vector<UdpClient*> startRun(ReaderSimulator& simulator, const size_t readerCount, const double readRate) {
+    simulator.start({
+        .basePort = 0,
+        .readerCount = readerCount,
+        .tagPopulation = 1000,
+        .readRate = readRate,
+        .heartbeatInterval = 0,
+        .broadcastInterval = std::chrono::milliseconds(0),
+    });
+
+    std::vector<UdpClient*> clients;
+
+    for (const auto& endpoint : simulator.getEndpoints()) {
+      auto& client = m_clients.emplace_back(
+          std::make_unique<UdpClient>(m_clientIo.getIoContext(), endpoint.address().to_string(), endpoint.port()));
+      client->start();
+      clients.push_back(client.get());
+    }
+
+    return clients;
+  }
+
+  static void stopRun(ReaderSimulator& simulator, const std::vector<UdpClient*>& clients) {
+    simulator.stop();
+    for (auto* client : clients) client->stop();
+  }
+
+  asio::io_context& getClientIo() { return m_clientIo.getIoContext(); }
+
+  asio::io_context& getSimulatorIo() { return m_simulatorIo; }
+
+ private:
+  BackgroundIoContext m_clientIo;
+  asio::io_context m_simulatorIo;
+  asio::executor_work_guard<asio::io_context::executor_type> m_simulatorWork;
+  std::vector<std::thread> m_simulatorThreads;
+  std::vector<std::unique_ptr<UdpClient>> m_clients;
+};
+
+// Requests the version number back to back until the deadline. The command is small and every reader answers it.
+asio::awaitable<Samples> requestLoop(UdpClient& client, const Clock::time_point deadline) {
+  Samples samples;
+  const auto command = std::make_shared<CmdGetVersionNumber>();
+
+  while (Clock::now() < deadline) {
+    const auto start = Clock::now();
+    const auto result = co_await client.request(command);
+    const auto end = Clock::now();
+
+    if (!result.ok()) {
+      ++samples.failures;
+      continue;
+    }
+
+    samples.roundTrips.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    samples.onWire.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(result.latency).count());
+  }
+
+  co_return samples;
+}
+
+struct RequestRun {
+  Samples samples;
+  std::chrono::duration<double> elapsed{};
+};
+
+RequestRun runRequests(Harness& harness, const std::vector<UdpClient*>& clients, const size_t window,
+                       const std::chrono::seconds duration) {
+  std::vector<std::future<Samples>> futures;
+  const auto started = Clock::now();
+  const auto deadline = started + duration;
+
+  for (auto* client : clients) {
+    client->setRequestWindow(window);
+    for (size_t i = 0; i < window; ++i) {
+      futures.push_back(asio::co_spawn(harness.getClientIo(), requestLoop(*client, deadline), asio::use_future));
+    }
+  }
+
+  RequestRun run;
+  for (auto& future : futures) run.samples.append(future.get());
+  run.elapsed = Clock::now() - started;
+
+  return run;
+}
+
+void printRequestHeader() {
+  fmt::print("{:<12} {:>7} {:>6} {:>12} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>8}\n", "phase", "readers",
+             "window", "commands/s", "per reader", "p50 us", "p99 us", "p999 us", "max us", "wire p99", "failed");
+}
+
+void printRequestRun(const std::string_view phase, const size_t readers, const size_t window, RequestRun& run) {
+  const auto rate = static_cast<double>(run.samples.roundTrips.size()) / run.elapsed.count();
+  const auto roundTrip = computePercentiles(run.samples.roundTrips);
+  const auto onWire = computePercentiles(run.samples.onWire);
+
+  fmt::print("{:<12} {:>7} {:>6} {:>12.0f} {:>10.0f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>8}\n",
+             phase, readers, window, rate, rate / static_cast<double>(readers), roundTrip.p50, roundTrip.p99,
+             roundTrip.p999, roundTrip.max, onWire.p99, run.samples.failures);
+}
+
+void runRequestPhase(Harness& harness, const std::string_view phase, const size_t readers, const size_t window,
+                     const std::chrono::seconds duration) {
+  ReaderSimulator simulator{harness.getSimulatorIo()};
+  const auto clients = harness.startRun(simulator, readers, 0.0);
+
+  // A short warm-up fills the pools and caches before anything is recorded
+  runRequests(harness, clients, window, std::chrono::seconds(1));
+  auto run = runRequests(harness, clients, window, duration);
+
+  Harness::stopRun(simulator, clients);
+  printRequestRun(phase, readers, window, run);
+}
+
+struct IngestStep {
+  double sentRate{0.0};
+  double receivedRate{0.0};
+  double loss{0.0};          // Share of the sent statuses that never reached a subscriber
+  uint64_t inboxDrops{0};    // Dropped by the sessions because their inbox was full
+};
+
+IngestStep runIngestStep(Harness& harness, const size_t readers, const double totalRate,
+                         const std::chrono::seconds duration) {
+  ReaderSimulator simulator{harness.getSimulatorIo()};
+  const auto clients = harness.startRun(simulator, readers, totalRate / static_cast<double>(readers));
+
+  // Shared with the callbacks, which may still be running on the client threads when the step returns
+  const auto received = std::make_shared<std::atomic<uint64_t>>(0);
+  for (auto* client : clients) {
+    client->onStatus().subscribe([received](const std::shared_ptr<IMessage>&) {
+      received->fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+
+  // The simulated readers send their statuses to the endpoint that last sent them a command
+  for (auto* client : clients) {
+    asio::co_spawn(harness.getClientIo(), client->request(std::make_shared<CmdGetVersionNumber>()), asio::use_future)
+        .get();
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  const auto collectDrops = [&clients] {
+    uint64_t drops = 0;
+    for (const auto* client : clients) drops += client->getStats().droppedDatagrams;
+    return drops;
+  };
+
+  const auto sentBefore = simulator.getStats().reads;
+  const auto receivedBefore = received->load();
+  const auto dropsBefore = collectDrops();
+  const auto started = Clock::now();
+
+  std::this_thread::sleep_for(duration);
+
+  const auto sentAfter = simulator.getStats().reads;
+  const auto elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+
+  // Statuses still in flight at the end of the window are given time to arrive
+  simulator.stop();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  const auto receivedAfter = received->load();
+  const auto dropsAfter = collectDrops();
+
+  Harness::stopRun(simulator, clients);
+  for (auto* client : clients) client->onStatus().clear();
+
+  IngestStep step;
+  const auto sent = static_cast<double>(sentAfter - sentBefore);
+  const auto delivered = static_cast<double>(std::min(receivedAfter - receivedBefore, sentAfter - sentBefore));
+
+  step.sentRate = sent / elapsed;
+  step.receivedRate = delivered / elapsed;
+  step.loss = sent > 0.0 ? 1.0 - delivered / sent : 0.0;
+  step.inboxDrops = dropsAfter - dropsBefore;
+
+  return step;
+}
+
+void runIngestPhase(Harness& harness, const size_t readers, const double maxRate, const std::chrono::seconds duration) {
+  // Losses below this share are taken as noise of the loopback rather than the client falling behind
+  constexpr double k_lossThreshold = 0.001;
+
+  fmt::print("\n{:<12} {:>7} {:>12} {:>12} {:>12} {:>8} {:>12}\n", "phase", "readers", "target/s", "sent/s",
+             "received/s", "loss %", "inbox drops");
+
+  double best = 0.0;
+
+  for (double rate = 1000.0; rate <= maxRate; rate *= 2.0) {
+    const auto step = runIngestStep(harness, readers, rate, duration);
+
+    fmt::print("{:<12} {:>7} {:>12.0f} {:>12.0f} {:>12.0f} {:>8.3f} {:>12}\n", "ingest", readers, rate, step.sentRate,
+               step.receivedRate, step.loss * 100.0, step.inboxDrops);
+
+    if (step.loss > k_lossThreshold || step.inboxDrops > 0) {
+      fmt::print("Statuses are lost above {:.0f}/s; the last rate without losses was {:.0f}/s\n", step.sentRate,
+                 best);
+      return;
+    }
+
+    // The readers cannot produce more; the client is not what limits the rate
+    if (step.sentRate < rate * 0.9) {
+      fmt::print("The simulator tops out at {:.0f}/s without losses; run it with more threads to go further\n",
+                 step.sentRate);
+      return;
+    }
+
+    best = step.receivedRate;
+  }
+
+  fmt::print("No losses up to {:.0f}/s\n", best);
+}
+
+}  // namespace
+
+int main(const int argc, char** argv) {
+  Arguments args;
+  if (!parseArguments(argc, argv, args)) {
+    printUsage();
+    return 1;
+  }
+
+  Harness harness{args};
+
+  const auto hasPhase = [&args](const std::string_view phase) {
+    return std::string_view(args.phases).find(phase) != std::string_view::npos;
+  };
+
+  if (hasPhase("latency") || hasPhase("throughput")) printRequestHeader();
+
+  if (hasPhase("latency")) {
+    runRequestPhase(harness, "latency", 1, 1, args.duration);
+    if (args.readers > 1) runRequestPhase(harness, "latency", args.readers, 1, args.duration);
+  }
+
+  if (hasPhase("throughput")) {
+    runRequestPhase(harness, "throughput", 1, args.window, args.duration);
+    if (args.readers > 1) runRequestPhase(harness, "throughput", args.readers, args.window, args.duration);
+  }
+
+  if (hasPhase("ingest")) {
+    runIngestPhase(harness, 1, args.maxStatusRate, args.duration);
+    if (args.readers > 1) runIngestPhase(harness, args.readers, args.maxStatusRate, args.duration);
+  }
+
+  return 0;
+}
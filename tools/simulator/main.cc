@@ -0,0 +1,168 @@
+#include <fmt/format.h>
+
+#include <charconv>
+#include <csignal>
+#include <thread>
+
+#include "vanch/simulator/readersimulator.h"
+
+namespace {
+
+struct Arguments {
+  vanch::ReaderSimulatorOptions options;
+  size_t threads{1};
+  std::chrono::seconds duration{0};  // 0 runs until interrupted
+};
+
+void printUsage() {
+  fmt::print(
+      "Usage: revanche-sim [options]\n"
+      "  --readers N             Simulated readers (1)\n"
+      "  --address IP            Address the readers bind to (127.0.0.1)\n"
+      "  --port P                Port of the first reader, the others follow; 0 picks free ports (6000)\n"
+      "  --tags N                Tag population of every reader (100)\n"
+      "  --rate R                Auto-reading statuses per second and reader, 0 disables them (10)\n"
+      "  --heartbeat S           Heartbeat interval in seconds, 0 disables it (1)\n"
+      "  --broadcast-ms MS       Broadcast interval in milliseconds, 0 disables it (5000)\n"
+      "  --broadcast-address IP  Broadcast destination (255.255.255.255)\n"
+      "  --broadcast-port P      Broadcast port (4444)\n"
+      "  --status IP:PORT        Status destination until a client sends a command\n"
+      "  --threads N             I/O threads (1)\n"
+      "  --duration S            Stop after S seconds instead of on Ctrl+C\n");
+}
+
+template <typename T>
+bool parseNumber(const std::string_view text, T& value) {
+  const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool parseEndpoint(const std::string_view text, asio::ip::udp::endpoint& endpoint) {
+  const auto colon = text.rfind(':');
+  if (colon == std::string_view::npos) return false;
+
+  uint16_t port{};
+  if (!parseNumber(text.substr(colon + 1), port)) return false;
+
+  asio::error_code ec;
+  const auto address = asio::ip::make_address(std::string(text.substr(0, colon)), ec);
+  if (ec) return false;
+
+  endpoint = {address, port};
+  return true;
+}
+
+bool parseArguments(const int argc, char** argv, Arguments& args) {
+  auto& options = args.options;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view name = argv[i];
+
+    if (name == "--help" || name == "-h") return false;
+    if (i + 1 >= argc) {
+      fmt::print(stderr, "Missing value for {}\n", name);
+      return false;
+    }
+
+    const std::string_view value = argv[++i];
+    bool isValid = true;
+
+    if (name == "--readers") {
+      isValid = parseNumber(value, options.readerCount);
+    } else if (name == "--address") {
+      options.address = value;
+    } else if (name == "--port") {
+      isValid = parseNumber(value, options.basePort);
+    } else if (name == "--tags") {
+      isValid = parseNumber(value, options.tagPopulation);
+    } else if (name == "--rate") {
+      isValid = parseNumber(value, options.readRate);
+    } else if (name == "--heartbeat") {
+      isValid = parseNumber(value, options.heartbeatInterval);
+    } else if (name == "--broadcast-ms") {
+      uint32_t interval{};
+      isValid = parseNumber(value, interval);
+      options.broadcastInterval = std::chrono::milliseconds(interval);
+    } else if (name == "--broadcast-address") {
+      options.broadcastAddress = value;
+    } else if (name == "--broadcast-port") {
+      isValid = parseNumber(value, options.broadcastPort);
+    } else if (name == "--status") {
+      asio::ip::udp::endpoint endpoint;
+      isValid = parseEndpoint(value, endpoint);
+      options.statusEndpoint = endpoint;
+    } else if (name == "--threads") {
+      isValid = parseNumber(value, args.threads) && args.threads > 0;
+    } else if (name == "--duration") {
+      uint32_t seconds{};
+      isValid = parseNumber(value, seconds);
+      args.duration = std::chrono::seconds(seconds);
+    } else {
+      fmt::print(stderr, "Unknown option {}\n", name);
+      return false;
+    }
+
+    if (!isValid) {
+      fmt::print(stderr, "Invalid value for {}: {}\n", name, value);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+int main(const int argc, char** argv) {
+  Arguments args;
+  if (!parseArguments(argc, argv, args)) {
+    printUsage();
+    return 1;
+  }
+
+  asio::io_context io;
+  auto work = asio::make_work_guard(io);
+
+  vanch::ReaderSimulator simulator{io};
+  if (!simulator.start(args.options)) return 1;
+
+  std::atomic_bool stopRequested{false};
+  asio::signal_set signals{io, SIGINT, SIGTERM};
+  signals.async_wait([&](const asio::error_code& ec, int) {
+    if (!ec) stopRequested = true;
+  });
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < args.threads; ++i) threads.emplace_back([&io] { io.run(); });
+
+  const auto started = std::chrono::steady_clock::now();
+  auto previous = simulator.getStats();
+
+  fmt::print("{:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "time", "commands/s", "errors/s", "reads/s", "beats/s",
+             "send fails");
+
+  while (!stopRequested) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    const auto stats = simulator.getStats();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - started);
+
+    fmt::print("{:>7}s {:>10} {:>10} {:>10} {:>10} {:>10}\n", elapsed.count(), stats.commands - previous.commands,
+               stats.errors - previous.errors, stats.reads - previous.reads, stats.heartbeats - previous.heartbeats,
+               stats.sendFailures);
+    previous = stats;
+
+    if (args.duration.count() > 0 && elapsed >= args.duration) break;
+  }
+
+  simulator.stop();
+  signals.cancel();
+  work.reset();
+
+  for (auto& thread : threads) thread.join();
+
+  const auto stats = simulator.getStats();
+  fmt::print("Answered {} commands ({} errors), sent {} reads, {} heartbeats and {} broadcasts\n", stats.commands,
+             stats.errors, stats.reads, stats.heartbeats, stats.broadcasts);
+  return 0;
+}